@@ -0,0 +1,40 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "performance/include/results_sink.hpp"
+
+namespace ppc::performance {
+
+/// @brief Identifies a perf configuration whose results are kept as a baseline.
+struct BaselineKey {
+  /// @brief Test identifier, e.g. "nesterov_a_test_task_processes_mpi_enabled".
+  std::string task_id;
+  /// @brief Measurement mode, "pipeline" or "task_run".
+  std::string mode;
+  int num_proc = 1;
+  int num_threads = 1;
+};
+
+/// @brief Version of the baseline file layout; files with another version are ignored.
+constexpr int kBaselineFormatVersion = 1;
+
+/// @brief Returns the configuration a perf record belongs to.
+BaselineKey GetBaselineKey(const PerfRecord &record);
+
+/// @brief Returns the path of the baseline file of a configuration inside a baseline directory.
+std::string GetBaselinePath(const std::string &directory, const BaselineKey &key);
+
+/// @brief Stores a perf record as the baseline of its configuration, replacing any previous one.
+/// @details The file holds the JSON form of the record (see ToJsonLine()) plus a "format_version" field.
+/// The directory is created if needed.
+/// @throws std::runtime_error If the file cannot be written.
+void SaveBaseline(const std::string &directory, const PerfRecord &record);
+
+/// @brief Loads the baseline samples of a configuration.
+/// @return Per-iteration durations, or std::nullopt if there is no usable baseline.
+std::optional<std::vector<double>> LoadBaseline(const std::string &directory, const BaselineKey &key);
+
+}  // namespace ppc::performance
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Traffic of one MPI operation or call site.
+struct CommStats {
+  /// @brief MPI operation name without the "MPI_" prefix, e.g. "Bcast".
+  std::string operation;
+  /// @brief Calling code location; empty for per-operation totals.
+  std::string call_site;
+  /// @brief Number of calls.
+  uint64_t calls = 0;
+  /// @brief Payload bytes passed to the calls (send plus receive buffers of the calling process).
+  uint64_t bytes = 0;
+  /// @brief Time in seconds spent inside the calls.
+  double time = 0.0;
+};
+
+/// @brief MPI traffic recorded during timed perf iterations.
+struct CommProfile {
+  /// @brief Per-operation totals summed over all processes, sorted by time (descending).
+  std::vector<CommStats> operations;
+  /// @brief Busiest call sites of rank 0, sorted by time (descending).
+  std::vector<CommStats> call_sites;
+
+  [[nodiscard]] bool Empty() const {
+    return operations.empty() && call_sites.empty();
+  }
+};
+
+}  // namespace ppc::performance
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Hardware events sampled around performance runs.
+enum class HardwareCounter : uint8_t {
+  kCycles,
+  kInstructions,
+  kCacheReferences,
+  kCacheMisses,
+  kBranchInstructions,
+  kBranchMisses,
+  kStalledCyclesFrontend,
+  kStalledCyclesBackend,
+  kCount
+};
+
+constexpr std::size_t kNumHardwareCounters = static_cast<std::size_t>(HardwareCounter::kCount);
+
+/// @brief Returns the name used for a counter in perf reports.
+std::string GetCounterName(HardwareCounter counter);
+
+/// @brief Counter totals with a per-counter validity mask.
+/// @details Fixed layout so totals can be summed across processes with a single reduction.
+struct CounterTotals {
+  /// @brief Accumulated event counts, scaled for multiplexing.
+  std::array<uint64_t, kNumHardwareCounters> values{};
+  /// @brief Non-zero for counters that were measured successfully.
+  std::array<uint8_t, kNumHardwareCounters> valid{};
+
+  [[nodiscard]] bool IsValid(HardwareCounter counter) const {
+    return valid[static_cast<std::size_t>(counter)] != 0;
+  }
+  [[nodiscard]] uint64_t Get(HardwareCounter counter) const {
+    return values[static_cast<std::size_t>(counter)];
+  }
+  /// @brief Returns true if at least one counter was measured.
+  [[nodiscard]] bool Any() const {
+    return std::ranges::any_of(valid, [](uint8_t flag) { return flag != 0; });
+  }
+};
+
+/// @brief Hardware performance counters of the calling process based on Linux perf_event_open.
+/// @details Events are opened independently, so unsupported events are skipped instead of failing the
+/// whole set. Every thread that exists at construction or at Start(), such as the workers of the OpenMP, TBB and
+/// framework pools, gets its own events, and Read() sums them. Threads started by the calling thread later are
+/// counted once they exit (perf "inherit" semantics); a thread that starts after construction and exits after
+/// Start() is therefore counted twice, so callers construct the object right before Start(). The events are opened
+/// disabled and only count between Start() and Stop(). When counters are unavailable (non-Linux, containers,
+/// restrictive perf_event_paranoid) the object stays usable and Read() reports no valid counters.
+class HardwareCounters {
+ public:
+  HardwareCounters();
+  ~HardwareCounters();
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+  HardwareCounters(HardwareCounters &&) = delete;
+  HardwareCounters &operator=(HardwareCounters &&) = delete;
+
+  /// @brief Returns true if at least one event could be opened.
+  [[nodiscard]] bool IsAvailable() const;
+  /// @brief Opens the events of threads started since construction, then resets and enables all events.
+  void Start();
+  /// @brief Disables all opened events.
+  void Stop();
+  /// @brief Reads current totals of all opened events.
+  [[nodiscard]] CounterTotals Read() const;
+
+ private:
+  /// Events of one thread, -1 where an event could not be opened.
+  struct ThreadEvents {
+    long tid = 0;
+    std::array<int, kNumHardwareCounters> fds{};
+  };
+
+  /// Opens the events of every thread of the process that has none yet.
+  void AttachThreads();
+
+  std::vector<ThreadEvents> threads_;
+};
+
+}  // namespace ppc::performance
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "task/include/task.hpp"
+
+namespace ppc::performance {
+
+/// @brief Memory use of one process during the timed iterations.
+struct RankMemory {
+  /// @brief Peak resident set size of the process since start in bytes, so it includes the input data.
+  std::uint64_t peak_rss = 0;
+  /// @brief Largest number of heap bytes in use during the timed iterations.
+  std::uint64_t peak_heap = 0;
+  /// @brief Heap bytes allocated per timed iteration, averaged.
+  std::uint64_t allocated_per_run = 0;
+};
+
+/// @brief Memory use of every cooperating process and the per-stage heap footprint of the calling one.
+struct MemoryFootprint {
+  /// @brief One entry per process, indexed by rank.
+  std::vector<RankMemory> ranks;
+  /// @brief Stage footprint over the timed iterations (pipeline runs only): mean allocated bytes and largest peak.
+  ppc::task::StageMemory stages;
+
+  [[nodiscard]] bool Empty() const {
+    return ranks.empty();
+  }
+  [[nodiscard]] std::uint64_t MaxPeakRss() const {
+    return ranks.empty() ? 0 : std::ranges::max(ranks, {}, &RankMemory::peak_rss).peak_rss;
+  }
+  [[nodiscard]] std::uint64_t MaxPeakHeap() const {
+    return ranks.empty() ? 0 : std::ranges::max(ranks, {}, &RankMemory::peak_heap).peak_heap;
+  }
+};
+
+/// @brief Combines the stage footprints of several executions: allocated bytes are averaged, peaks take the maximum.
+inline ppc::task::StageMemory CombineStageMemory(const std::vector<ppc::task::StageMemory> &samples) {
+  ppc::task::StageMemory combined;
+  if (samples.empty()) {
+    return combined;
+  }
+  auto add = [](ppc::task::StageFootprint &total, const ppc::task::StageFootprint &sample) {
+    total.allocated_bytes += sample.allocated_bytes;
+    total.peak_bytes = std::max(total.peak_bytes, sample.peak_bytes);
+  };
+  for (const auto &sample : samples) {
+    add(combined.validation, sample.validation);
+    add(combined.preprocessing, sample.preprocessing);
+    add(combined.run, sample.run);
+    add(combined.postprocessing, sample.postprocessing);
+  }
+  const auto count = static_cast<std::uint64_t>(samples.size());
+  combined.validation.allocated_bytes /= count;
+  combined.preprocessing.allocated_bytes /= count;
+  combined.run.allocated_bytes /= count;
+  combined.postprocessing.allocated_bytes /= count;
+  return combined;
+}
+
+}  // namespace ppc::performance
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
@@ -8,8 +10,15 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "performance/include/comm_profile.hpp"
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_footprint.hpp"
+#include "performance/include/rank_timings.hpp"
+#include "performance/include/statistics.hpp"
 #include "task/include/task.hpp"
+#include "util/include/memory_tracker.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::performance {
@@ -18,18 +27,102 @@ inline double DefaultTimer() {
   return -1.0;
 }
 
+inline bool DefaultDecision(bool keep_running) {
+  return keep_running;
+}
+
+inline void DefaultCounterReduction(CounterTotals & /*counters*/) {}
+
+inline double DefaultBlockedTime() {
+  return 0.0;
+}
+
+inline void DefaultCommRecording(bool /*enabled*/) {}
+
+inline CommProfile DefaultCommCollection() {
+  return {};
+}
+
+inline RankTimings DefaultRankGather(const std::vector<double> &samples, double mpi_time) {
+  auto timings = MakeRankTimings({samples}, {mpi_time});
+  timings.mpi_measured = false;
+  return timings;
+}
+
+inline std::vector<RankMemory> DefaultMemoryGather(const RankMemory &memory) {
+  return {memory};
+}
+
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
   uint64_t num_running = 5;
+  /// @brief Number of untimed runs executed before measurement starts.
+  uint64_t num_warmup = 0;
+  /// @brief Keep running past num_running until the relative standard error reaches target_rse.
+  bool adaptive = false;
+  /// @brief Target relative standard error of the mean in adaptive mode.
+  double target_rse = 0.01;
+  /// @brief Upper bound on the number of timed runs in adaptive mode.
+  uint64_t max_running = 1000;
+  /// @brief Time budget in seconds for all timed runs in adaptive mode; non-positive means GetPerfMaxTime().
+  double time_budget = 0.0;
+  /// @brief Capture hardware performance counters around the timed runs.
+  bool hw_counters = false;
+  /// @brief Profile MPI traffic (calls, bytes, time per operation and call site) of the timed runs.
+  bool comm_profile = false;
   /// @brief Timer function returning current time in seconds.
   /// @cond
   std::function<double()> current_timer = DefaultTimer;
   /// @endcond
+  /// @brief Agrees on the adaptive-mode "keep running" decision across cooperating processes.
+  /// @cond
+  std::function<bool(bool)> sync_decision = DefaultDecision;
+  /// @endcond
+  /// @brief Combines hardware counter totals of cooperating processes.
+  /// @cond
+  std::function<void(CounterTotals &)> reduce_counters = DefaultCounterReduction;
+  /// @endcond
+  /// @brief Cumulative time in seconds the calling process has spent blocked in MPI calls.
+  /// @cond
+  std::function<double()> blocked_time = DefaultBlockedTime;
+  /// @endcond
+  /// @brief Collects per-iteration samples and blocked time of all cooperating processes.
+  /// @cond
+  std::function<RankTimings(const std::vector<double> &, double)> gather_ranks = DefaultRankGather;
+  /// @endcond
+  /// @brief Starts or pauses recording of MPI traffic of the calling process.
+  /// @cond
+  std::function<void(bool)> record_comm = DefaultCommRecording;
+  /// @endcond
+  /// @brief Returns and clears the MPI traffic recorded so far.
+  /// @cond
+  std::function<CommProfile()> collect_comm = DefaultCommCollection;
+  /// @endcond
+  /// @brief Collects the memory use of all cooperating processes, indexed by rank.
+  /// @cond
+  std::function<std::vector<RankMemory>(const RankMemory &)> gather_memory = DefaultMemoryGather;
+  /// @endcond
 };
 
 struct PerfResults {
-  /// @brief Measured execution time in seconds.
+  /// @brief Measured execution time in seconds (mean over all timed iterations).
   double time_sec = 0.0;
+  /// @brief Duration of every timed iteration in seconds, in execution order.
+  std::vector<double> time_samples;
+  /// @brief Statistics computed over time_samples.
+  SampleStatistics statistics;
+  /// @brief Hardware counter totals over all timed iterations (if requested and available).
+  CounterTotals counters;
+  /// @brief Per-stage durations of every timed iteration (pipeline runs only).
+  std::vector<ppc::task::StageTimings> stage_samples;
+  /// @brief Mean per-stage durations over stage_samples.
+  ppc::task::StageTimings stage_mean;
+  /// @brief Timed iterations of every cooperating process (a single entry outside of MPI runs).
+  RankTimings ranks;
+  /// @brief MPI traffic of the timed iterations (if requested).
+  CommProfile comm;
+  /// @brief Peak resident set size and heap use of every cooperating process.
+  MemoryFootprint memory;
   enum class TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone };
   TypeOfRunning type_of_running = TypeOfRunning::kNone;
   constexpr static double kMaxTime = 10.0;
@@ -46,17 +139,29 @@ class Perf {
   // Validation() -> Run() -> PostProcessing()
   void PipelineRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kPipeline;
+    perf_results_.stage_samples.clear();
 
+    std::vector<ppc::task::StageMemory> stage_memory;
+    stage_memory.reserve(perf_attr.num_running);
+    auto record_stages = [&] {
+      perf_results_.stage_samples.push_back(task_->GetStageTimings());
+      stage_memory.push_back(task_->GetStageMemory());
+    };
     CommonRun(perf_attr, [&] {
       task_->Validation();
       task_->PreProcessing();
       task_->Run();
       task_->PostProcessing();
-    }, perf_results_);
+    }, perf_results_, record_stages);
+    perf_results_.stage_mean = MeanStageTimings(perf_results_.stage_samples);
+    perf_results_.memory.stages = CombineStageMemory(stage_memory);
   }
   // Check performance of task's Run() function
   void TaskRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kTaskRun;
+    perf_results_.stage_samples.clear();
+    perf_results_.stage_mean = {};
+    perf_results_.memory.stages = {};
 
     task_->Validation();
     task_->PreProcessing();
@@ -87,6 +192,7 @@ class Perf {
     if (time_secs < max_time) {
       perf_res_str << std::fixed << std::setprecision(10) << time_secs;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintSampleStatistics(test_id, type_test_name);
     } else {
       std::stringstream err_msg;
       err_msg << '\n' << "Task execute time need to be: ";
@@ -94,6 +200,7 @@ class Perf {
       err_msg << "Original time in secs: " << time_secs << '\n';
       perf_res_str << std::fixed << std::setprecision(10) << -1.0;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintSampleStatistics(test_id, type_test_name);
       throw std::runtime_error(err_msg.str().c_str());
     }
   }
@@ -106,13 +213,189 @@ class Perf {
  private:
   PerfResults perf_results_;
   std::shared_ptr<ppc::task::Task<InType, OutType>> task_;
-  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
-    auto begin = perf_attr.current_timer();
-    for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+  // Print per-iteration statistics on a separate line so the summary line format stays stable
+  void PrintSampleStatistics(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &stats = perf_results_.statistics;
+    std::stringstream stats_str;
+    stats_str << std::fixed << std::setprecision(10) << "count=" << stats.count << ",min=" << stats.min
+              << ",median=" << stats.median << ",p90=" << stats.p90 << ",p99=" << stats.p99
+              << ",stddev=" << stats.stddev << ",ci95_low=" << stats.ci_low << ",ci95_high=" << stats.ci_high;
+    std::cout << test_id << ":" << type_test_name << ":stats:" << stats_str.str() << '\n';
+    PrintStages(test_id, type_test_name);
+    PrintCounters(test_id, type_test_name);
+    PrintRanks(test_id, type_test_name);
+    PrintComm(test_id, type_test_name);
+    PrintMemory(test_id, type_test_name);
+  }
+  void PrintStages(const std::string &test_id, const std::string &type_test_name) const {
+    if (perf_results_.stage_samples.empty()) {
+      return;
+    }
+    const auto &mean = perf_results_.stage_mean;
+    std::stringstream stages_str;
+    stages_str << std::fixed << std::setprecision(10) << "validation=" << mean.validation
+               << ",preprocessing=" << mean.preprocessing << ",run=" << mean.run
+               << ",postprocessing=" << mean.postprocessing;
+    std::cout << test_id << ":" << type_test_name << ":stages:" << stages_str.str() << '\n';
+  }
+  void PrintCounters(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &counters = perf_results_.counters;
+    if (!counters.Any()) {
+      return;
+    }
+    std::stringstream counters_str;
+    const char *separator = "";
+    for (std::size_t i = 0; i < kNumHardwareCounters; i++) {
+      const auto counter = static_cast<HardwareCounter>(i);
+      if (counters.IsValid(counter)) {
+        counters_str << separator << GetCounterName(counter) << "=" << counters.Get(counter);
+        separator = ",";
+      }
+    }
+    if (counters.IsValid(HardwareCounter::kCycles) && counters.IsValid(HardwareCounter::kInstructions) &&
+        counters.Get(HardwareCounter::kCycles) > 0) {
+      counters_str << ",ipc=" << std::fixed << std::setprecision(3)
+                   << static_cast<double>(counters.Get(HardwareCounter::kInstructions)) /
+                          static_cast<double>(counters.Get(HardwareCounter::kCycles));
+    }
+    std::cout << test_id << ":" << type_test_name << ":counters:" << counters_str.str() << '\n';
+  }
+  void PrintRanks(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &ranks = perf_results_.ranks;
+    if (ranks.NumRanks() < 2) {
+      return;
+    }
+    std::stringstream ranks_str;
+    ranks_str << std::fixed << std::setprecision(10) << "count=" << ranks.NumRanks() << ",min=" << ranks.min
+              << ",max=" << ranks.max << ",mean=" << ranks.mean << ",imbalance=" << ranks.imbalance;
+    std::cout << test_id << ":" << type_test_name << ":ranks:" << ranks_str.str() << '\n';
+    for (std::size_t rank = 0; rank < ranks.NumRanks(); rank++) {
+      std::stringstream rank_str;
+      rank_str << std::fixed << std::setprecision(10) << "total=" << ranks.total[rank];
+      if (ranks.mpi_measured) {
+        rank_str << ",compute=" << ranks.ComputeTime(rank) << ",mpi=" << ranks.mpi_time[rank];
+      }
+      std::cout << test_id << ":" << type_test_name << ":rank" << rank << ":" << rank_str.str() << '\n';
+    }
+  }
+  void PrintComm(const std::string &test_id, const std::string &type_test_name) const {
+    auto print = [&](const std::string &kind, const CommStats &stats) {
+      std::stringstream comm_str;
+      comm_str << "op=" << stats.operation;
+      if (!stats.call_site.empty()) {
+        comm_str << ",site=" << stats.call_site;
+      }
+      comm_str << ",calls=" << stats.calls << ",bytes=" << stats.bytes << std::fixed << std::setprecision(10)
+               << ",time=" << stats.time;
+      std::cout << test_id << ":" << type_test_name << ":" << kind << ":" << comm_str.str() << '\n';
+    };
+    for (const auto &stats : perf_results_.comm.operations) {
+      print("mpi", stats);
+    }
+    for (const auto &stats : perf_results_.comm.call_sites) {
+      print("mpi_site", stats);
+    }
+  }
+  void PrintMemory(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &memory = perf_results_.memory;
+    if (memory.Empty()) {
+      return;
+    }
+    auto print = [&](const std::string &kind, const RankMemory &rank_memory) {
+      std::cout << test_id << ":" << type_test_name << ":" << kind << ":peak_rss=" << rank_memory.peak_rss
+                << ",peak_heap=" << rank_memory.peak_heap << ",allocated_per_run=" << rank_memory.allocated_per_run
+                << '\n';
+    };
+    if (memory.ranks.size() == 1) {
+      print("memory", memory.ranks.front());
+      return;
+    }
+    for (std::size_t rank = 0; rank < memory.ranks.size(); rank++) {
+      print("memory_rank" + std::to_string(rank), memory.ranks[rank]);
+    }
+  }
+  static bool ShouldContinueAdaptive(const PerfAttr &perf_attr, const std::vector<double> &samples, double elapsed) {
+    if (samples.size() >= perf_attr.max_running) {
+      return false;
+    }
+    const double budget = perf_attr.time_budget > 0.0 ? perf_attr.time_budget : ppc::util::GetPerfMaxTime();
+    const double expected_next = elapsed / static_cast<double>(samples.size());
+    const bool keep_running = RelativeStandardError(samples) > perf_attr.target_rse && elapsed + expected_next < budget;
+    return perf_attr.sync_decision(keep_running);
+  }
+  static ppc::task::StageTimings MeanStageTimings(const std::vector<ppc::task::StageTimings> &samples) {
+    ppc::task::StageTimings mean;
+    if (samples.empty()) {
+      return mean;
+    }
+    for (const auto &sample : samples) {
+      mean.validation += sample.validation;
+      mean.preprocessing += sample.preprocessing;
+      mean.run += sample.run;
+      mean.postprocessing += sample.postprocessing;
+    }
+    const auto count = static_cast<double>(samples.size());
+    mean.validation /= count;
+    mean.preprocessing /= count;
+    mean.run /= count;
+    mean.postprocessing /= count;
+    return mean;
+  }
+  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results,
+                        const std::function<void()> &on_timed_run = nullptr) {
+    for (uint64_t i = 0; i < perf_attr.num_warmup; i++) {
       pipeline();
     }
-    auto end = perf_attr.current_timer();
-    perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
+    // Opened after the warm-up and started right away, so no thread of the warm-up is counted
+    auto counters = perf_attr.hw_counters ? std::make_unique<HardwareCounters>() : nullptr;
+    if (counters) {
+      counters->Start();
+    }
+
+    perf_results.time_samples.clear();
+    perf_results.time_samples.reserve(perf_attr.num_running);
+    const ppc::util::HeapScope heap;
+    double elapsed = 0.0;
+    double blocked = 0.0;
+    auto timed_run = [&] {
+      const auto blocked_begin = perf_attr.blocked_time();
+      if (perf_attr.comm_profile) {
+        perf_attr.record_comm(true);
+      }
+      auto begin = perf_attr.current_timer();
+      pipeline();
+      auto end = perf_attr.current_timer();
+      if (perf_attr.comm_profile) {
+        perf_attr.record_comm(false);
+      }
+      blocked += perf_attr.blocked_time() - blocked_begin;
+      perf_results.time_samples.push_back(end - begin);
+      elapsed += end - begin;
+      if (on_timed_run) {
+        on_timed_run();
+      }
+    };
+    for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+      timed_run();
+    }
+    if (perf_attr.adaptive && !perf_results.time_samples.empty()) {
+      while (ShouldContinueAdaptive(perf_attr, perf_results.time_samples, elapsed)) {
+        timed_run();
+      }
+    }
+    if (counters) {
+      counters->Stop();
+      perf_results.counters = counters->Read();
+      perf_attr.reduce_counters(perf_results.counters);
+    }
+    perf_results.ranks = perf_attr.gather_ranks(perf_results.time_samples, blocked);
+    const auto runs = std::max<std::uint64_t>(perf_results.time_samples.size(), 1);
+    perf_results.memory.ranks = perf_attr.gather_memory({.peak_rss = ppc::util::GetPeakRss(),
+                                                         .peak_heap = heap.PeakBytes(),
+                                                         .allocated_per_run = heap.AllocatedBytes() / runs});
+    perf_results.comm = perf_attr.comm_profile ? perf_attr.collect_comm() : CommProfile{};
+    perf_results.statistics = ComputeStatistics(perf_results.time_samples);
+    perf_results.time_sec = perf_results.statistics.mean;
   }
 };
 
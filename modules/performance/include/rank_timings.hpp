@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Timed iterations of every cooperating process and their spread across processes.
+struct RankTimings {
+  /// @brief Per-iteration durations in seconds, indexed as [rank][iteration].
+  std::vector<std::vector<double>> samples;
+  /// @brief Time in seconds each process spent blocked in MPI calls during timed iterations.
+  std::vector<double> mpi_time;
+  /// @brief Whether mpi_time was measured; if not, it holds zeros and the split into compute and MPI time is unknown.
+  bool mpi_measured = true;
+  /// @brief Total duration of all timed iterations of each process in seconds.
+  std::vector<double> total;
+  /// @brief Smallest per-process total in seconds.
+  double min = 0.0;
+  /// @brief Largest per-process total in seconds.
+  double max = 0.0;
+  /// @brief Mean per-process total in seconds.
+  double mean = 0.0;
+  /// @brief Load-imbalance ratio max / mean; 1 means perfectly balanced.
+  double imbalance = 1.0;
+
+  [[nodiscard]] std::size_t NumRanks() const {
+    return samples.size();
+  }
+  /// @brief Time in seconds a process spent outside of MPI calls during timed iterations.
+  [[nodiscard]] double ComputeTime(std::size_t rank) const {
+    return std::max(total[rank] - mpi_time[rank], 0.0);
+  }
+};
+
+/// @brief Builds RankTimings from per-process samples and derives the cross-process summary.
+/// @param samples Per-iteration durations of every process, indexed as [rank][iteration].
+/// @param mpi_time Time each process spent blocked in MPI calls; must have one entry per process.
+inline RankTimings MakeRankTimings(std::vector<std::vector<double>> samples, std::vector<double> mpi_time) {
+  RankTimings timings;
+  timings.samples = std::move(samples);
+  timings.mpi_time = std::move(mpi_time);
+  timings.mpi_time.resize(timings.samples.size(), 0.0);
+  if (timings.samples.empty()) {
+    return timings;
+  }
+  timings.total.reserve(timings.samples.size());
+  for (const auto &rank_samples : timings.samples) {
+    timings.total.push_back(std::accumulate(rank_samples.begin(), rank_samples.end(), 0.0));
+  }
+  const auto [min_it, max_it] = std::ranges::minmax_element(timings.total);
+  timings.min = *min_it;
+  timings.max = *max_it;
+  timings.mean = std::accumulate(timings.total.begin(), timings.total.end(), 0.0) /
+                 static_cast<double>(timings.total.size());
+  timings.imbalance = timings.mean > 0.0 ? timings.max / timings.mean : 1.0;
+  return timings;
+}
+
+}  // namespace ppc::performance
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "performance/include/statistics.hpp"
+
+namespace ppc::performance {
+
+/// @brief Outcome of comparing current timing samples against baseline samples.
+struct RegressionResult {
+  /// @brief Median of the current samples divided by the median of the baseline samples.
+  double median_ratio = 1.0;
+  /// @brief One-sided p-value of the hypothesis "current samples are slower than the baseline".
+  double p_value = 1.0;
+  /// @brief True if the slowdown exceeds the threshold and is statistically significant.
+  bool regression = false;
+  /// @brief True if the speedup exceeds the threshold and is statistically significant.
+  bool improvement = false;
+};
+
+/// @brief One-sided Mann-Whitney U test that samples of `slower` tend to be larger than samples of `faster`.
+/// @details Uses the normal approximation with tie and continuity corrections.
+/// @return p-value in [0, 1]; 1 when either series is empty.
+inline double MannWhitneyGreaterPValue(const std::vector<double> &slower, const std::vector<double> &faster) {
+  if (slower.empty() || faster.empty()) {
+    return 1.0;
+  }
+  // Rank the pooled samples, averaging ranks of ties; the flag marks samples of `slower`
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(slower.size() + faster.size());
+  for (double sample : slower) {
+    pooled.emplace_back(sample, true);
+  }
+  for (double sample : faster) {
+    pooled.emplace_back(sample, false);
+  }
+  std::ranges::sort(pooled, {}, &std::pair<double, bool>::first);
+
+  const auto n = static_cast<double>(pooled.size());
+  double rank_sum = 0.0;
+  double tie_term = 0.0;
+  for (std::size_t i = 0; i < pooled.size();) {
+    std::size_t j = i;
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+      j++;
+    }
+    const double average_rank = (static_cast<double>(i + j) + 1.0) / 2.0;
+    const auto ties = static_cast<double>(j - i);
+    tie_term += (ties * ties * ties) - ties;
+    for (std::size_t k = i; k < j; k++) {
+      if (pooled[k].second) {
+        rank_sum += average_rank;
+      }
+    }
+    i = j;
+  }
+
+  const auto n1 = static_cast<double>(slower.size());
+  const auto n2 = static_cast<double>(faster.size());
+  const double u = rank_sum - (n1 * (n1 + 1.0) / 2.0);
+  const double mean_u = n1 * n2 / 2.0;
+  const double variance = n1 * n2 / 12.0 * ((n + 1.0) - (tie_term / (n * (n - 1.0))));
+  if (variance <= 0.0) {
+    return 1.0;
+  }
+  const double z = (u - mean_u - 0.5) / std::sqrt(variance);
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+/// @brief Compares current timing samples against baseline samples.
+/// @param baseline Per-iteration durations of the baseline run.
+/// @param current Per-iteration durations of the current run.
+/// @param threshold Relative median change that is tolerated, e.g. 0.05 for 5%.
+/// @param alpha Significance level of the Mann-Whitney U test.
+inline RegressionResult CompareToBaseline(const std::vector<double> &baseline, const std::vector<double> &current,
+                                          double threshold, double alpha = 0.05) {
+  RegressionResult result;
+  const double baseline_median = ComputeStatistics(baseline).median;
+  const double current_median = ComputeStatistics(current).median;
+  if (baseline_median <= 0.0 || current_median <= 0.0) {
+    return result;
+  }
+  result.median_ratio = current_median / baseline_median;
+  result.p_value = MannWhitneyGreaterPValue(current, baseline);
+  result.regression = result.median_ratio > 1.0 + threshold && result.p_value < alpha;
+  result.improvement =
+      result.median_ratio < 1.0 / (1.0 + threshold) && MannWhitneyGreaterPValue(baseline, current) < alpha;
+  return result;
+}
+
+}  // namespace ppc::performance
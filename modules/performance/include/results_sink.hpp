@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "performance/include/performance.hpp"
+
+namespace ppc::performance {
+
+/// @brief Description of the machine a performance record was produced on.
+struct HostInfo {
+  std::string hostname;
+  std::string cpu_model;
+  unsigned logical_cpus = 0;
+  std::string os;
+};
+
+/// @brief Thread pinning and memory placement a measurement ran with.
+struct Placement {
+  /// @brief PPC_THREAD_AFFINITY policy, "none", "compact" or "scatter".
+  std::string affinity = "none";
+  /// @brief PPC_NUMA_PLACEMENT policy, "none", "interleave" or "first_touch".
+  std::string numa = "none";
+  int sockets = 1;
+  int numa_nodes = 1;
+};
+
+/// @brief Task buffers allocated through ppc::util::AllocateBuffer() while the test ran.
+struct BufferStats {
+  /// @brief PPC_HUGE_PAGES policy, "none", "transparent" or "explicit".
+  std::string huge_pages = "none";
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes = 0;
+  std::uint64_t peak_bytes = 0;
+  /// @brief Bytes of the buffers that were backed by huge pages.
+  std::uint64_t huge_page_bytes = 0;
+};
+
+/// @brief One structured performance result, written as a JSON line or a CSV row.
+struct PerfRecord {
+  /// @brief Test identifier, e.g. "nesterov_a_test_task_threads_omp_enabled".
+  std::string task_id;
+  /// @brief Parallel technology, e.g. "mpi" or "omp".
+  std::string technology;
+  /// @brief Measurement mode, "pipeline" or "task_run".
+  std::string mode;
+  int num_proc = 1;
+  int num_threads = 1;
+  /// @brief Problem size of the measured input; 0 if unknown.
+  std::size_t input_size = 0;
+  /// @brief Problem-size multiplier the test ran with (PPC_PERF_PROBLEM_SCALE).
+  double problem_scale = 1.0;
+  Placement placement;
+  BufferStats buffers;
+  PerfResults results;
+};
+
+/// @brief Collects host information once per process.
+const HostInfo &GetHostInfo();
+
+/// @brief Serializes a record as a single-line JSON object.
+std::string ToJsonLine(const PerfRecord &record, const HostInfo &host);
+
+/// @brief Returns the CSV header matching ToCsvRow().
+std::string CsvHeader();
+
+/// @brief Serializes a record as a CSV row; samples are joined with ';'.
+std::string ToCsvRow(const PerfRecord &record, const HostInfo &host);
+
+/// @brief Appends a record to a results file.
+/// @details Files ending with ".csv" receive CSV rows (the header is written to new or empty files),
+/// everything else receives JSON Lines.
+/// @throws std::runtime_error If the file cannot be opened.
+void AppendPerfRecord(const std::string &path, const PerfRecord &record);
+
+}  // namespace ppc::performance
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Summary of a series of per-iteration timing samples.
+struct SampleStatistics {
+  /// @brief Number of samples the statistics were computed from.
+  std::size_t count = 0;
+  /// @brief Arithmetic mean in seconds.
+  double mean = 0.0;
+  /// @brief Fastest sample in seconds.
+  double min = 0.0;
+  /// @brief Slowest sample in seconds.
+  double max = 0.0;
+  /// @brief 50th percentile in seconds.
+  double median = 0.0;
+  /// @brief 90th percentile in seconds.
+  double p90 = 0.0;
+  /// @brief 99th percentile in seconds.
+  double p99 = 0.0;
+  /// @brief Sample standard deviation in seconds.
+  double stddev = 0.0;
+  /// @brief Lower bound of the 95% confidence interval of the mean.
+  double ci_low = 0.0;
+  /// @brief Upper bound of the 95% confidence interval of the mean.
+  double ci_high = 0.0;
+};
+
+/// @brief Returns the q-th quantile of sorted samples using linear interpolation.
+/// @param sorted Samples in ascending order.
+/// @param q Quantile in range [0, 1].
+/// @return Interpolated quantile value, or 0 for empty input.
+inline double Percentile(const std::vector<double> &sorted, double q) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const double pos = std::clamp(q, 0.0, 1.0) * static_cast<double>(sorted.size() - 1);
+  const auto lower = static_cast<std::size_t>(std::floor(pos));
+  const auto upper = std::min(lower + 1, sorted.size() - 1);
+  const double frac = pos - static_cast<double>(lower);
+  return sorted[lower] + ((sorted[upper] - sorted[lower]) * frac);
+}
+
+/// @brief Two-sided 95% critical value of Student's t-distribution.
+/// @param dof Degrees of freedom.
+/// @return Critical value; falls back to the normal approximation for large dof.
+inline double StudentTCritical95(std::size_t dof) {
+  constexpr std::array<double, 30> kTable = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                             2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                             2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  if (dof == 0) {
+    return 0.0;
+  }
+  if (dof <= kTable.size()) {
+    return kTable[dof - 1];
+  }
+  if (dof <= 60) {
+    return 2.000;
+  }
+  if (dof <= 120) {
+    return 1.980;
+  }
+  return 1.960;
+}
+
+/// @brief Relative standard error of the mean (standard error divided by the mean).
+/// @param samples Per-iteration durations in seconds.
+/// @return Relative standard error, or +infinity when it cannot be estimated yet.
+inline double RelativeStandardError(const std::vector<double> &samples) {
+  if (samples.size() < 2) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const auto n = static_cast<double>(samples.size());
+  const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+  if (mean <= 0.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  double sq_sum = 0.0;
+  for (double sample : samples) {
+    sq_sum += (sample - mean) * (sample - mean);
+  }
+  return std::sqrt(sq_sum / (n - 1.0)) / std::sqrt(n) / mean;
+}
+
+/// @brief Computes robust statistics over a series of timing samples.
+/// @param samples Per-iteration durations in seconds.
+/// @return Filled SampleStatistics; all fields are zero for empty input.
+inline SampleStatistics ComputeStatistics(std::vector<double> samples) {
+  SampleStatistics stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  std::ranges::sort(samples);
+
+  const auto n = static_cast<double>(samples.size());
+  stats.count = samples.size();
+  stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+  stats.min = samples.front();
+  stats.max = samples.back();
+  stats.median = Percentile(samples, 0.50);
+  stats.p90 = Percentile(samples, 0.90);
+  stats.p99 = Percentile(samples, 0.99);
+
+  if (samples.size() > 1) {
+    double sq_sum = 0.0;
+    for (double sample : samples) {
+      sq_sum += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = std::sqrt(sq_sum / (n - 1.0));
+  }
+  const double half_width = StudentTCritical95(samples.size() - 1) * stats.stddev / std::sqrt(n);
+  stats.ci_low = stats.mean - half_width;
+  stats.ci_high = stats.mean + half_width;
+  return stats;
+}
+
+}  // namespace ppc::performance
@@ -0,0 +1,64 @@
+#include "performance/include/baseline_store.hpp"
+
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "performance/include/results_sink.hpp"
+
+namespace ppc::performance {
+
+BaselineKey GetBaselineKey(const PerfRecord &record) {
+  return {
+      .task_id = record.task_id, .mode = record.mode, .num_proc = record.num_proc, .num_threads = record.num_threads};
+}
+
+std::string GetBaselinePath(const std::string &directory, const BaselineKey &key) {
+  const std::string file_name = key.task_id + "." + key.mode + ".p" + std::to_string(key.num_proc) + "t" +
+                                std::to_string(key.num_threads) + ".json";
+  return (std::filesystem::path(directory) / file_name).string();
+}
+
+void SaveBaseline(const std::string &directory, const PerfRecord &record) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+
+  auto json = nlohmann::json::parse(ToJsonLine(record, GetHostInfo()));
+  json["format_version"] = kBaselineFormatVersion;
+
+  const auto path = GetBaselinePath(directory, GetBaselineKey(record));
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to write perf baseline " + path);
+  }
+  file << json.dump(2) << '\n';
+}
+
+std::optional<std::vector<double>> LoadBaseline(const std::string &directory, const BaselineKey &key) {
+  std::ifstream file(GetBaselinePath(directory, key));
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+  try {
+    const auto json = nlohmann::json::parse(file);
+    if (json.value("format_version", 0) != kBaselineFormatVersion || !json.contains("samples")) {
+      return std::nullopt;
+    }
+    auto samples = json.at("samples").get<std::vector<double>>();
+    if (samples.empty()) {
+      return std::nullopt;
+    }
+    return samples;
+  } catch (const std::exception &) {
+    // Corrupted or hand-edited files are treated as missing so that they get replaced on the next update
+    return std::nullopt;
+  }
+}
+
+}  // namespace ppc::performance
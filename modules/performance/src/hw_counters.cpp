@@ -0,0 +1,194 @@
+#include "performance/include/hw_counters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+
+#  include <charconv>
+#  include <filesystem>
+#  include <system_error>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+// Indexed by HardwareCounter
+constexpr std::array<const char *, kNumHardwareCounters> kCounterNames = {
+    "cycles",
+    "instructions",
+    "cache_references",
+    "cache_misses",
+    "branch_instructions",
+    "branch_misses",
+    "stalled_cycles_frontend",
+    "stalled_cycles_backend",
+};
+
+#ifdef __linux__
+// Indexed by HardwareCounter
+constexpr std::array<uint64_t, kNumHardwareCounters> kCounterConfigs = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_REFERENCES,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_STALLED_CYCLES_FRONTEND,
+    PERF_COUNT_HW_STALLED_CYCLES_BACKEND,
+};
+
+/// Events of the calling thread are inherited by the threads it starts; those of other threads are not, since
+/// their children get events of their own at the next Start().
+int OpenCounter(uint64_t config, long tid, bool inherit) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = inherit ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, static_cast<pid_t>(tid), -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+/// Thread ids of the process, empty if /proc is not available.
+std::vector<long> ListThreads() {
+  std::vector<long> tids;
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    const auto name = entry.path().filename().string();
+    long tid = 0;
+    if (std::from_chars(name.data(), name.data() + name.size(), tid).ec == std::errc{}) {
+      tids.push_back(tid);
+    }
+  }
+  return tids;
+}
+#endif
+
+}  // namespace
+
+std::string GetCounterName(HardwareCounter counter) {
+  const auto index = static_cast<std::size_t>(counter);
+  if (index >= kCounterNames.size()) {
+    return "unknown";
+  }
+  return kCounterNames[index];
+}
+
+HardwareCounters::HardwareCounters() {
+#ifdef __linux__
+  const long self = syscall(SYS_gettid);
+  ThreadEvents events{.tid = self};
+  for (std::size_t i = 0; i < kCounterConfigs.size(); i++) {
+    events.fds[i] = OpenCounter(kCounterConfigs[i], self, true);
+  }
+  threads_.push_back(events);
+  AttachThreads();
+#endif
+}
+
+HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+  for (const auto &events : threads_) {
+    for (int fd : events.fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+#endif
+}
+
+void HardwareCounters::AttachThreads() {
+#ifdef __linux__
+  for (long tid : ListThreads()) {
+    if (std::ranges::any_of(threads_, [tid](const ThreadEvents &events) { return events.tid == tid; })) {
+      continue;
+    }
+    ThreadEvents events{.tid = tid};
+    for (std::size_t i = 0; i < kCounterConfigs.size(); i++) {
+      events.fds[i] = OpenCounter(kCounterConfigs[i], tid, false);
+    }
+    // Threads that exited meanwhile or cannot be measured are left out
+    if (std::ranges::any_of(events.fds, [](int fd) { return fd >= 0; })) {
+      threads_.push_back(events);
+    }
+  }
+#endif
+}
+
+bool HardwareCounters::IsAvailable() const {
+  return std::ranges::any_of(threads_, [](const ThreadEvents &events) {
+    return std::ranges::any_of(events.fds, [](int fd) { return fd >= 0; });
+  });
+}
+
+void HardwareCounters::Start() {
+#ifdef __linux__
+  AttachThreads();
+  for (const auto &events : threads_) {
+    for (int fd : events.fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+#endif
+}
+
+void HardwareCounters::Stop() {
+#ifdef __linux__
+  for (const auto &events : threads_) {
+    for (int fd : events.fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+  }
+#endif
+}
+
+CounterTotals HardwareCounters::Read() const {
+  CounterTotals totals;
+#ifdef __linux__
+  for (const auto &events : threads_) {
+    for (std::size_t i = 0; i < events.fds.size(); i++) {
+      if (events.fds[i] < 0) {
+        continue;
+      }
+      // Layout defined by PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+      std::array<uint64_t, 3> data{};
+      if (read(events.fds[i], data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+        continue;
+      }
+      const uint64_t value = data[0];
+      const uint64_t time_enabled = data[1];
+      const uint64_t time_running = data[2];
+      if (time_running == 0) {
+        continue;
+      }
+      // Scale for multiplexing when more events are open than the PMU has registers
+      const long double scale = static_cast<long double>(time_enabled) / static_cast<long double>(time_running);
+      totals.values[i] += static_cast<uint64_t>(static_cast<long double>(value) * scale);
+      totals.valid[i] = 1;
+    }
+  }
+#endif
+  return totals;
+}
+
+}  // namespace ppc::performance
@@ -0,0 +1,249 @@
+#include "performance/include/results_sink.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "performance/include/comm_profile.hpp"
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_footprint.hpp"
+#include "performance/include/performance.hpp"
+
+#ifdef _WIN32
+#  include <libenvpp/detail/get.hpp>
+#else
+#  include <sys/utsname.h>
+#  include <unistd.h>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+std::string ReadCpuModel() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.starts_with("model name")) {
+      const auto pos = line.find(':');
+      if (pos != std::string::npos && pos + 2 <= line.size()) {
+        return line.substr(pos + 2);
+      }
+    }
+  }
+  return "unknown";
+}
+
+HostInfo CollectHostInfo() {
+  HostInfo info;
+  info.logical_cpus = std::thread::hardware_concurrency();
+  info.cpu_model = ReadCpuModel();
+#ifdef _WIN32
+  info.hostname = env::get<std::string>("COMPUTERNAME").value_or("unknown");
+  info.os = "Windows";
+#else
+  std::string hostname(256, '\0');
+  if (gethostname(hostname.data(), hostname.size()) == 0) {
+    hostname.resize(hostname.find('\0'));
+    info.hostname = hostname;
+  } else {
+    info.hostname = "unknown";
+  }
+  utsname uts{};
+  if (uname(&uts) == 0) {
+    info.os = std::string(uts.sysname) + " " + uts.release;
+  }
+#endif
+  return info;
+}
+
+std::string CurrentTimestamp() {
+  const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  std::tm utc{};
+#ifdef _WIN32
+  gmtime_s(&utc, &now);
+#else
+  gmtime_r(&now, &utc);
+#endif
+  std::stringstream ss;
+  ss << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+  return ss.str();
+}
+
+std::string EscapeCsv(const std::string &value) {
+  if (value.find_first_of(",\"\n") == std::string::npos) {
+    return value;
+  }
+  std::string escaped = "\"";
+  for (char ch : value) {
+    if (ch == '"') {
+      escaped += '"';
+    }
+    escaped += ch;
+  }
+  escaped += '"';
+  return escaped;
+}
+
+}  // namespace
+
+const HostInfo &GetHostInfo() {
+  static const HostInfo kHostInfo = CollectHostInfo();
+  return kHostInfo;
+}
+
+std::string ToJsonLine(const PerfRecord &record, const HostInfo &host) {
+  const auto &results = record.results;
+  const auto &stats = results.statistics;
+
+  nlohmann::json json;
+  json["timestamp"] = CurrentTimestamp();
+  json["task_id"] = record.task_id;
+  json["technology"] = record.technology;
+  json["mode"] = record.mode;
+  json["num_proc"] = record.num_proc;
+  json["num_threads"] = record.num_threads;
+  json["input_size"] = record.input_size;
+  json["problem_scale"] = record.problem_scale;
+  json["placement"] = {{"affinity", record.placement.affinity},
+                       {"numa", record.placement.numa},
+                       {"sockets", record.placement.sockets},
+                       {"numa_nodes", record.placement.numa_nodes}};
+  if (record.buffers.allocations > 0) {
+    json["buffers"] = {{"huge_pages", record.buffers.huge_pages},
+                       {"allocations", record.buffers.allocations},
+                       {"bytes", record.buffers.bytes},
+                       {"peak_bytes", record.buffers.peak_bytes},
+                       {"huge_page_bytes", record.buffers.huge_page_bytes}};
+  }
+  json["time_sec"] = results.time_sec;
+  json["samples"] = results.time_samples;
+  json["statistics"] = {{"count", stats.count},   {"min", stats.min},       {"max", stats.max},
+                        {"median", stats.median}, {"p90", stats.p90},       {"p99", stats.p99},
+                        {"stddev", stats.stddev}, {"ci95_low", stats.ci_low}, {"ci95_high", stats.ci_high}};
+  if (!results.stage_samples.empty()) {
+    const auto &mean = results.stage_mean;
+    json["stages"] = {{"validation", mean.validation},
+                      {"preprocessing", mean.preprocessing},
+                      {"run", mean.run},
+                      {"postprocessing", mean.postprocessing}};
+  }
+  if (results.counters.Any()) {
+    auto &counters = json["counters"];
+    for (std::size_t i = 0; i < kNumHardwareCounters; i++) {
+      const auto counter = static_cast<HardwareCounter>(i);
+      if (results.counters.IsValid(counter)) {
+        counters[GetCounterName(counter)] = results.counters.Get(counter);
+      }
+    }
+  }
+  if (results.ranks.NumRanks() > 1) {
+    const auto &ranks = results.ranks;
+    auto &ranks_json = json["ranks"];
+    ranks_json["min"] = ranks.min;
+    ranks_json["max"] = ranks.max;
+    ranks_json["mean"] = ranks.mean;
+    ranks_json["imbalance"] = ranks.imbalance;
+    ranks_json["total"] = ranks.total;
+    if (ranks.mpi_measured) {
+      ranks_json["mpi"] = ranks.mpi_time;
+    }
+  }
+  if (!results.comm.Empty()) {
+    auto to_json = [](const std::vector<CommStats> &entries) {
+      nlohmann::json list = nlohmann::json::array();
+      for (const auto &stats : entries) {
+        nlohmann::json entry = {
+            {"op", stats.operation}, {"calls", stats.calls}, {"bytes", stats.bytes}, {"time", stats.time}};
+        if (!stats.call_site.empty()) {
+          entry["site"] = stats.call_site;
+        }
+        list.push_back(entry);
+      }
+      return list;
+    };
+    json["mpi"] = {{"operations", to_json(results.comm.operations)},
+                   {"call_sites", to_json(results.comm.call_sites)}};
+  }
+  if (!results.memory.Empty()) {
+    const auto &memory = results.memory;
+    auto &memory_json = json["memory"];
+    memory_json["peak_rss"] = memory.MaxPeakRss();
+    memory_json["peak_heap"] = memory.MaxPeakHeap();
+    memory_json["ranks"] = nlohmann::json::array();
+    for (const auto &rank : memory.ranks) {
+      memory_json["ranks"].push_back({{"peak_rss", rank.peak_rss},
+                                      {"peak_heap", rank.peak_heap},
+                                      {"allocated_per_run", rank.allocated_per_run}});
+    }
+    if (!results.stage_samples.empty()) {
+      auto to_json = [](const ppc::task::StageFootprint &stage) {
+        return nlohmann::json{{"allocated", stage.allocated_bytes}, {"peak", stage.peak_bytes}};
+      };
+      memory_json["stages"] = {{"validation", to_json(memory.stages.validation)},
+                               {"preprocessing", to_json(memory.stages.preprocessing)},
+                               {"run", to_json(memory.stages.run)},
+                               {"postprocessing", to_json(memory.stages.postprocessing)}};
+    }
+  }
+  json["host"] = {{"hostname", host.hostname},
+                  {"cpu_model", host.cpu_model},
+                  {"logical_cpus", host.logical_cpus},
+                  {"os", host.os}};
+  return json.dump();
+}
+
+std::string CsvHeader() {
+  return "timestamp,task_id,technology,mode,num_proc,num_threads,input_size,problem_scale,time_sec,min,median,p90,"
+         "p99,stddev,ci95_low,ci95_high,samples,hostname,cpu_model,logical_cpus,affinity,numa_placement,"
+         "peak_rss,peak_heap";
+}
+
+std::string ToCsvRow(const PerfRecord &record, const HostInfo &host) {
+  const auto &results = record.results;
+  const auto &stats = results.statistics;
+
+  std::stringstream samples;
+  samples << std::setprecision(10);
+  for (std::size_t i = 0; i < results.time_samples.size(); i++) {
+    samples << (i == 0 ? "" : ";") << results.time_samples[i];
+  }
+
+  std::stringstream row;
+  row << std::setprecision(10) << CurrentTimestamp() << ',' << EscapeCsv(record.task_id) << ','
+      << EscapeCsv(record.technology) << ',' << EscapeCsv(record.mode) << ',' << record.num_proc << ','
+      << record.num_threads << ',' << record.input_size << ',' << record.problem_scale << ',' << results.time_sec
+      << ',' << stats.min << ',' << stats.median << ',' << stats.p90 << ',' << stats.p99 << ',' << stats.stddev << ','
+      << stats.ci_low << ',' << stats.ci_high << ',' << samples.str() << ',' << EscapeCsv(host.hostname) << ','
+      << EscapeCsv(host.cpu_model) << ',' << host.logical_cpus << ',' << EscapeCsv(record.placement.affinity) << ','
+      << EscapeCsv(record.placement.numa) << ',' << results.memory.MaxPeakRss() << ','
+      << results.memory.MaxPeakHeap();
+  return row.str();
+}
+
+void AppendPerfRecord(const std::string &path, const PerfRecord &record) {
+  const bool is_csv = std::filesystem::path(path).extension() == ".csv";
+  std::error_code ec;
+  const bool needs_header = is_csv && (!std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0);
+
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open perf results file " + path);
+  }
+  if (needs_header) {
+    file << CsvHeader() << '\n';
+  }
+  file << (is_csv ? ToCsvRow(record, GetHostInfo()) : ToJsonLine(record, GetHostInfo())) << '\n';
+}
+
+}  // namespace ppc::performance
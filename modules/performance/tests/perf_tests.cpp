@@ -1,19 +1,41 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <iterator>
 #include <libenvpp/detail/environment.hpp>
 #include <memory>
+#include <nlohmann/json.hpp>
 #include <ostream>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "performance/include/baseline_store.hpp"
+#include "performance/include/comm_profile.hpp"
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_footprint.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/rank_timings.hpp"
+#include "performance/include/regression.hpp"
+#include "performance/include/results_sink.hpp"
+#include "performance/include/statistics.hpp"
 #include "task/include/task.hpp"
+#include "util/include/memory_tracker.hpp"
+#include "util/include/perf_test_util.hpp"
 #include "util/include/util.hpp"
 
 using ppc::task::StatusOfTask;
@@ -350,6 +372,700 @@ TEST(PerfTest, PipelineRunAndTaskRun) {
   EXPECT_GT(res_taskrun.time_sec, 0.0);
 }
 
+TEST(PerfTest, CollectsOneSamplePerIteration) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  double time = 0.0;
+  attr.num_running = 4;
+  attr.current_timer = [&time]() {
+    double t = time;
+    time += 0.5;
+    return t;
+  };
+
+  perf.PipelineRun(attr);
+  auto res = perf.GetPerfResults();
+  ASSERT_EQ(res.time_samples.size(), 4U);
+  EXPECT_EQ(res.statistics.count, 4U);
+  for (double sample : res.time_samples) {
+    EXPECT_DOUBLE_EQ(sample, 0.5);
+  }
+  EXPECT_DOUBLE_EQ(res.time_sec, res.statistics.mean);
+  EXPECT_DOUBLE_EQ(res.statistics.stddev, 0.0);
+}
+
+TEST(PerfTest, RecordsMemoryFootprint) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  perf.PipelineRun(attr);
+  auto res = perf.GetPerfResults();
+  ASSERT_EQ(res.memory.ranks.size(), 1U);
+  if (ppc::util::IsHeapTrackingEnabled()) {
+    EXPECT_GT(res.memory.ranks[0].peak_heap, 0U);
+  }
+#ifdef __linux__
+  EXPECT_GT(res.memory.MaxPeakRss(), 0U);
+#endif
+}
+
+TEST(PerfTest, CombinesStageMemoryOfIterations) {
+  ppc::task::StageMemory first;
+  first.run = {.allocated_bytes = 100, .peak_bytes = 1000};
+  ppc::task::StageMemory second;
+  second.run = {.allocated_bytes = 300, .peak_bytes = 500};
+  const auto combined = CombineStageMemory({first, second});
+  EXPECT_EQ(combined.run.allocated_bytes, 200U);
+  EXPECT_EQ(combined.run.peak_bytes, 1000U);
+}
+
+class CountingTask : public Task<int, int> {
+ public:
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    run_calls++;
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+  int run_calls = 0;
+};
+
+namespace {
+
+// Timer whose consecutive begin/end pairs measure the given durations in a loop
+std::function<double()> MakeScriptedTimer(std::vector<double> durations) {
+  return [durations = std::move(durations), time = 0.0, call = std::size_t{0}]() mutable {
+    double t = time;
+    if (call % 2 == 0) {
+      time += durations[(call / 2) % durations.size()];
+    }
+    call++;
+    return t;
+  };
+}
+
+}  // namespace
+
+TEST(PerfTest, WarmupRunsAreNotTimed) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  double time = 0.0;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  attr.current_timer = [&time]() {
+    double t = time;
+    time += 1.0;
+    return t;
+  };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(task_ptr->run_calls, 5);
+  EXPECT_EQ(perf.GetPerfResults().time_samples.size(), 3U);
+}
+
+TEST(PerfTest, AdaptiveModeStopsAtMaxRunning) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.adaptive = true;
+  attr.target_rse = 0.0;
+  attr.max_running = 7;
+  attr.time_budget = 1e9;
+  attr.current_timer = MakeScriptedTimer({1.0, 2.0});
+
+  perf.TaskRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().time_samples.size(), 7U);
+}
+
+TEST(PerfTest, AdaptiveModeStopsWhenSamplesAreStable) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  double time = 0.0;
+  attr.num_running = 3;
+  attr.adaptive = true;
+  attr.time_budget = 1e9;
+  attr.current_timer = [&time]() {
+    double t = time;
+    time += 0.5;
+    return t;
+  };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().time_samples.size(), 3U);
+}
+
+TEST(PerfTest, AdaptiveModeRespectsTimeBudget) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.adaptive = true;
+  attr.target_rse = 0.0;
+  attr.time_budget = 6.5;
+  attr.current_timer = MakeScriptedTimer({1.0, 3.0});
+
+  perf.PipelineRun(attr);
+  // 1 + 3 + 1 = 5 s spent, the next expected run (~1.67 s) would exceed the 6.5 s budget.
+  EXPECT_EQ(perf.GetPerfResults().time_samples.size(), 3U);
+}
+
+TEST(PerfTest, AdaptiveModeFollowsSyncDecision) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.adaptive = true;
+  attr.target_rse = 0.0;
+  attr.time_budget = 1e9;
+  attr.current_timer = MakeScriptedTimer({1.0, 2.0});
+  attr.sync_decision = [](bool /*keep_running*/) { return false; };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().time_samples.size(), 2U);
+}
+
+TEST(StatisticsTest, RelativeStandardErrorNeedsTwoSamples) {
+  EXPECT_TRUE(std::isinf(RelativeStandardError({1.0})));
+  EXPECT_DOUBLE_EQ(RelativeStandardError({1.0, 1.0, 1.0}), 0.0);
+  EXPECT_NEAR(RelativeStandardError({1.0, 3.0}), 0.5, 1e-12);
+}
+
+TEST(RankTimingsTest, ComputesImbalanceAcrossRanks) {
+  auto timings = MakeRankTimings({{1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}}, {0.5, 0.0, 1.0});
+  ASSERT_EQ(timings.NumRanks(), 3U);
+  EXPECT_DOUBLE_EQ(timings.min, 2.0);
+  EXPECT_DOUBLE_EQ(timings.max, 6.0);
+  EXPECT_DOUBLE_EQ(timings.mean, 4.0);
+  EXPECT_DOUBLE_EQ(timings.imbalance, 1.5);
+  EXPECT_DOUBLE_EQ(timings.ComputeTime(0), 1.5);
+  EXPECT_DOUBLE_EQ(timings.ComputeTime(2), 5.0);
+}
+
+TEST(RankTimingsTest, IdleRanksAreBalanced) {
+  auto timings = MakeRankTimings({{0.0}, {0.0}}, {});
+  EXPECT_DOUBLE_EQ(timings.imbalance, 1.0);
+  EXPECT_EQ(timings.mpi_time.size(), 2U);
+}
+
+TEST(HardwareCountersTest, NamesAreStable) {
+  EXPECT_EQ(GetCounterName(HardwareCounter::kCycles), "cycles");
+  EXPECT_EQ(GetCounterName(HardwareCounter::kCacheMisses), "cache_misses");
+  EXPECT_EQ(GetCounterName(HardwareCounter::kCount), "unknown");
+}
+
+TEST(HardwareCountersTest, ReadReportsOnlyOpenedCounters) {
+  HardwareCounters counters;
+  counters.Start();
+  volatile uint64_t sink = 0;
+  for (uint64_t i = 0; i < 100000; i++) {
+    sink = sink + i;
+  }
+  counters.Stop();
+  auto totals = counters.Read();
+  EXPECT_EQ(totals.Any(), counters.IsAvailable());
+  if (totals.IsValid(HardwareCounter::kInstructions)) {
+    EXPECT_GT(totals.Get(HardwareCounter::kInstructions), 0U);
+  }
+}
+
+TEST(HardwareCountersTest, CountsThreadsThatExistedBeforeConstruction) {
+  std::atomic<bool> go{false};
+  std::atomic<bool> done{false};
+  // A pool worker stand-in: started before the counters and idle until the timed region
+  std::thread worker([&] {
+    while (!go.load()) {
+      std::this_thread::yield();
+    }
+    volatile uint64_t sink = 0;
+    for (uint64_t i = 0; i < 10000000; i++) {
+      sink = sink + i;
+    }
+    done = true;
+  });
+  HardwareCounters counters;
+  if (!counters.IsAvailable()) {
+    go = true;
+    worker.join();
+    GTEST_SKIP() << "Hardware counters are unavailable";
+  }
+  counters.Start();
+  go = true;
+  while (!done.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  counters.Stop();
+  worker.join();
+  const auto totals = counters.Read();
+  if (totals.IsValid(HardwareCounter::kInstructions)) {
+    // The calling thread mostly sleeps, so most of the instructions are the worker's
+    EXPECT_GT(totals.Get(HardwareCounter::kInstructions), 10000000U);
+  }
+}
+
+TEST(PerfTest, CountersDegradeGracefullyAndAreReduced) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.hw_counters = true;
+  attr.current_timer = MakeScriptedTimer({1.0});
+  int reduce_calls = 0;
+  attr.reduce_counters = [&reduce_calls](CounterTotals & /*counters*/) { reduce_calls++; };
+
+  EXPECT_NO_THROW(perf.PipelineRun(attr));
+  EXPECT_EQ(reduce_calls, 1);
+  EXPECT_EQ(perf.GetPerfResults().time_samples.size(), 5U);
+  EXPECT_NO_THROW(perf.PrintPerfStatistic("counters_degrade_gracefully"));
+}
+
+TEST(PerfTest, CountersAreNotCapturedByDefault) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.current_timer = MakeScriptedTimer({1.0});
+  perf.TaskRun(attr);
+  EXPECT_FALSE(perf.GetPerfResults().counters.Any());
+}
+
+TEST(PerfTest, SingleProcessRunsReportOneRank) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.current_timer = MakeScriptedTimer({1.0});
+  perf.TaskRun(attr);
+
+  const auto &ranks = perf.GetPerfResults().ranks;
+  ASSERT_EQ(ranks.NumRanks(), 1U);
+  EXPECT_EQ(ranks.samples[0], perf.GetPerfResults().time_samples);
+  EXPECT_DOUBLE_EQ(ranks.imbalance, 1.0);
+}
+
+TEST(PerfTest, RankGatherReceivesBlockedTimeOfTimedRuns) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  double fake_blocked = 0.0;
+  double gathered_blocked = -1.0;
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  attr.current_timer = MakeScriptedTimer({1.0});
+  attr.blocked_time = [&] {
+    fake_blocked += 0.25;
+    return fake_blocked;
+  };
+  attr.gather_ranks = [&](const std::vector<double> &samples, double blocked) {
+    gathered_blocked = blocked;
+    return MakeRankTimings({samples, {3.0, 3.0, 3.0}}, {blocked, 0.0});
+  };
+  perf.TaskRun(attr);
+
+  // Each timed run reads the blocked time twice, 0.25 apart
+  EXPECT_DOUBLE_EQ(gathered_blocked, 0.75);
+  const auto &ranks = perf.GetPerfResults().ranks;
+  ASSERT_EQ(ranks.NumRanks(), 2U);
+  EXPECT_DOUBLE_EQ(ranks.max, 9.0);
+  EXPECT_DOUBLE_EQ(ranks.imbalance, 1.5);
+}
+
+TEST(PerfTest, RankLinesLeaveOutUnmeasuredMpiTime) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  bool measured = true;
+  PerfAttr attr;
+  attr.current_timer = MakeScriptedTimer({1.0});
+  attr.gather_ranks = [&](const std::vector<double> &samples, double blocked) {
+    auto timings = MakeRankTimings({samples, samples}, {blocked, blocked});
+    timings.mpi_measured = measured;
+    return timings;
+  };
+  perf.TaskRun(attr);
+  testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("rank_lines_measured");
+  EXPECT_NE(testing::internal::GetCapturedStdout().find(":rank1:total=5.0000000000,compute="), std::string::npos);
+
+  measured = false;
+  perf.TaskRun(attr);
+  testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("rank_lines_unmeasured");
+  const auto output = testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find(":rank1:total=5.0000000000\n"), std::string::npos) << output;
+  EXPECT_EQ(output.find("mpi="), std::string::npos) << output;
+}
+
+TEST(PerfTest, CommProfileCoversOnlyTimedRuns) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  int enabled_runs = 0;
+  bool recording = false;
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  attr.comm_profile = true;
+  attr.current_timer = [&] {
+    enabled_runs += recording ? 1 : 0;
+    return 0.0;
+  };
+  attr.record_comm = [&](bool enabled) { recording = enabled; };
+  attr.collect_comm = [] {
+    CommProfile profile;
+    profile.operations.push_back({.operation = "Bcast", .call_site = {}, .calls = 3, .bytes = 24, .time = 0.5});
+    return profile;
+  };
+  perf.TaskRun(attr);
+
+  // The timer is read twice per timed run while recording is on
+  EXPECT_EQ(enabled_runs, 6);
+  EXPECT_FALSE(recording);
+  const auto &comm = perf.GetPerfResults().comm;
+  ASSERT_EQ(comm.operations.size(), 1U);
+  EXPECT_EQ(comm.operations[0].operation, "Bcast");
+}
+
+TEST(PerfTest, CommProfileIsNotCollectedByDefault) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  bool collected = false;
+  PerfAttr attr;
+  attr.current_timer = MakeScriptedTimer({1.0});
+  attr.collect_comm = [&] {
+    collected = true;
+    return CommProfile{};
+  };
+  perf.TaskRun(attr);
+  EXPECT_FALSE(collected);
+  EXPECT_TRUE(perf.GetPerfResults().comm.Empty());
+}
+
+TEST(PerfTest, PipelineRunRecordsStageBreakdown) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 1;
+  attr.current_timer = MakeScriptedTimer({1.0});
+  perf.PipelineRun(attr);
+
+  auto res = perf.GetPerfResults();
+  ASSERT_EQ(res.stage_samples.size(), 3U);
+  EXPECT_GE(res.stage_mean.run, 0.0);
+  EXPECT_NO_THROW(perf.PrintPerfStatistic("pipeline_stage_breakdown"));
+
+  perf.TaskRun(attr);
+  EXPECT_TRUE(perf.GetPerfResults().stage_samples.empty());
+}
+
+namespace {
+
+PerfRecord MakeSampleRecord() {
+  PerfRecord record;
+  record.task_id = "example_task_mpi_enabled";
+  record.technology = "mpi";
+  record.mode = "pipeline";
+  record.num_proc = 4;
+  record.num_threads = 2;
+  record.input_size = 1000;
+  record.results.time_samples = {0.5, 0.25, 0.75};
+  record.results.statistics = ComputeStatistics(record.results.time_samples);
+  record.results.time_sec = record.results.statistics.mean;
+  return record;
+}
+
+}  // namespace
+
+TEST(ResultsSinkTest, JsonLineContainsRecordFields) {
+  HostInfo host{.hostname = "node1", .cpu_model = "cpu", .logical_cpus = 8, .os = "Linux"};
+  const auto line = ToJsonLine(MakeSampleRecord(), host);
+  EXPECT_EQ(line.find('\n'), std::string::npos);
+
+  auto json = nlohmann::json::parse(line);
+  EXPECT_EQ(json["task_id"].get<std::string>(), "example_task_mpi_enabled");
+  EXPECT_EQ(json["technology"].get<std::string>(), "mpi");
+  EXPECT_EQ(json["mode"].get<std::string>(), "pipeline");
+  EXPECT_EQ(json["num_proc"].get<int>(), 4);
+  EXPECT_EQ(json["num_threads"].get<int>(), 2);
+  EXPECT_EQ(json["input_size"].get<std::size_t>(), 1000U);
+  EXPECT_EQ(json["samples"].size(), 3U);
+  EXPECT_DOUBLE_EQ(json["statistics"]["median"].get<double>(), 0.5);
+  EXPECT_EQ(json["host"]["hostname"].get<std::string>(), "node1");
+  EXPECT_EQ(json["placement"]["affinity"].get<std::string>(), "none");
+  EXPECT_EQ(json["placement"]["numa_nodes"].get<int>(), 1);
+  EXPECT_FALSE(json.contains("counters"));
+  EXPECT_FALSE(json.contains("buffers"));
+}
+
+TEST(ResultsSinkTest, JsonLineContainsMpiProfile) {
+  auto record = MakeSampleRecord();
+  record.results.comm.operations.push_back(
+      {.operation = "Bcast", .call_site = {}, .calls = 4, .bytes = 64, .time = 0.25});
+  record.results.comm.call_sites.push_back(
+      {.operation = "Bcast", .call_site = "Task::RunImpl+0x10", .calls = 1, .bytes = 16, .time = 0.125});
+  auto json = nlohmann::json::parse(ToJsonLine(record, HostInfo{}));
+
+  ASSERT_TRUE(json.contains("mpi"));
+  EXPECT_EQ(json["mpi"]["operations"][0]["op"].get<std::string>(), "Bcast");
+  EXPECT_EQ(json["mpi"]["operations"][0]["bytes"].get<uint64_t>(), 64U);
+  EXPECT_FALSE(json["mpi"]["operations"][0].contains("site"));
+  EXPECT_EQ(json["mpi"]["call_sites"][0]["site"].get<std::string>(), "Task::RunImpl+0x10");
+}
+
+TEST(ResultsSinkTest, JsonLineLeavesOutUnmeasuredMpiTime) {
+  auto record = MakeSampleRecord();
+  record.results.ranks = MakeRankTimings({{1.0}, {2.0}}, {0.5, 0.0});
+  auto json = nlohmann::json::parse(ToJsonLine(record, HostInfo{}));
+  ASSERT_TRUE(json.contains("ranks"));
+  EXPECT_EQ(json["ranks"]["mpi"][0].get<double>(), 0.5);
+
+  record.results.ranks.mpi_measured = false;
+  json = nlohmann::json::parse(ToJsonLine(record, HostInfo{}));
+  ASSERT_TRUE(json.contains("ranks"));
+  EXPECT_FALSE(json["ranks"].contains("mpi"));
+  EXPECT_EQ(json["ranks"]["total"][1].get<double>(), 2.0);
+}
+
+TEST(ResultsSinkTest, JsonLineContainsBufferStats) {
+  auto record = MakeSampleRecord();
+  record.buffers = {
+      .huge_pages = "transparent", .allocations = 2, .bytes = 4096, .peak_bytes = 4096, .huge_page_bytes = 0};
+  auto json = nlohmann::json::parse(ToJsonLine(record, HostInfo{}));
+
+  ASSERT_TRUE(json.contains("buffers"));
+  EXPECT_EQ(json["buffers"]["huge_pages"].get<std::string>(), "transparent");
+  EXPECT_EQ(json["buffers"]["allocations"].get<uint64_t>(), 2U);
+  EXPECT_EQ(json["buffers"]["peak_bytes"].get<uint64_t>(), 4096U);
+}
+
+TEST(ResultsSinkTest, JsonLineContainsMemoryFootprint) {
+  auto record = MakeSampleRecord();
+  record.results.memory.ranks = {{.peak_rss = 4096, .peak_heap = 100, .allocated_per_run = 10},
+                                 {.peak_rss = 8192, .peak_heap = 50, .allocated_per_run = 20}};
+  auto json = nlohmann::json::parse(ToJsonLine(record, HostInfo{}));
+
+  ASSERT_TRUE(json.contains("memory"));
+  EXPECT_EQ(json["memory"]["peak_rss"].get<uint64_t>(), 8192U);
+  EXPECT_EQ(json["memory"]["peak_heap"].get<uint64_t>(), 100U);
+  EXPECT_EQ(json["memory"]["ranks"][1]["allocated_per_run"].get<uint64_t>(), 20U);
+  EXPECT_FALSE(json["memory"].contains("stages"));
+}
+
+TEST(ResultsSinkTest, CsvRowMatchesHeader) {
+  HostInfo host{.hostname = "node1", .cpu_model = "Some CPU, 8 cores", .logical_cpus = 8, .os = "Linux"};
+  const auto header = CsvHeader();
+  const auto row = ToCsvRow(MakeSampleRecord(), host);
+  const auto header_columns = std::count(header.begin(), header.end(), ',');
+  // The quoted CPU model contributes one extra comma
+  EXPECT_EQ(std::count(row.begin(), row.end(), ','), header_columns + 1);
+  EXPECT_NE(row.find("0.5;0.25;0.75"), std::string::npos);
+  EXPECT_NE(row.find("\"Some CPU, 8 cores\""), std::string::npos);
+}
+
+TEST(ResultsSinkTest, AppendWritesCsvHeaderOnce) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_results_sink_test.csv").string();
+  std::filesystem::remove(path);
+  AppendPerfRecord(path, MakeSampleRecord());
+  AppendPerfRecord(path, MakeSampleRecord());
+
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 3U);
+  EXPECT_EQ(lines[0], CsvHeader());
+  std::filesystem::remove(path);
+}
+
+TEST(ResultsSinkTest, AppendWritesJsonLines) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_results_sink_test.jsonl").string();
+  std::filesystem::remove(path);
+  AppendPerfRecord(path, MakeSampleRecord());
+  AppendPerfRecord(path, MakeSampleRecord());
+
+  std::ifstream file(path);
+  std::size_t count = 0;
+  for (std::string line; std::getline(file, line);) {
+    EXPECT_TRUE(nlohmann::json::accept(line)) << line;
+    count++;
+  }
+  EXPECT_EQ(count, 2U);
+  std::filesystem::remove(path);
+}
+
+TEST(RegressionTest, MannWhitneyDetectsShiftedSamples) {
+  const std::vector<double> faster = {1.0, 1.1, 1.2, 1.3, 1.4};
+  const std::vector<double> slower = {2.0, 2.1, 2.2, 2.3, 2.4};
+  EXPECT_LT(MannWhitneyGreaterPValue(slower, faster), 0.01);
+  EXPECT_GT(MannWhitneyGreaterPValue(faster, slower), 0.99);
+}
+
+TEST(RegressionTest, MannWhitneyIgnoresIdenticalSamples) {
+  const std::vector<double> samples = {1.0, 1.0, 1.0, 1.0};
+  EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue(samples, samples), 1.0);
+  EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue({}, samples), 1.0);
+}
+
+TEST(RegressionTest, FlagsSignificantSlowdownAboveThreshold) {
+  const std::vector<double> baseline = {1.00, 1.01, 0.99, 1.02, 0.98, 1.00, 1.01, 0.99};
+  std::vector<double> slower;
+  std::ranges::transform(baseline, std::back_inserter(slower), [](double sample) { return sample * 1.2; });
+
+  const auto result = CompareToBaseline(baseline, slower, 0.05);
+  EXPECT_NEAR(result.median_ratio, 1.2, 1e-9);
+  EXPECT_TRUE(result.regression);
+  EXPECT_FALSE(result.improvement);
+
+  // The same slowdown is tolerated by a looser threshold
+  EXPECT_FALSE(CompareToBaseline(baseline, slower, 0.5).regression);
+  // Speedups are reported as improvements
+  const auto reverse = CompareToBaseline(slower, baseline, 0.05);
+  EXPECT_FALSE(reverse.regression);
+  EXPECT_TRUE(reverse.improvement);
+}
+
+TEST(RegressionTest, NoiseIsNotARegression) {
+  const std::vector<double> baseline = {1.00, 1.03, 0.97, 1.01, 0.99};
+  const std::vector<double> current = {1.01, 0.98, 1.02, 1.00, 0.99};
+  const auto result = CompareToBaseline(baseline, current, 0.05);
+  EXPECT_FALSE(result.regression);
+  EXPECT_FALSE(result.improvement);
+}
+
+TEST(BaselineStoreTest, SaveAndLoadRoundTrip) {
+  const auto dir = (std::filesystem::temp_directory_path() / "ppc_perf_baseline_test").string();
+  std::filesystem::remove_all(dir);
+  const auto record = MakeSampleRecord();
+  const auto key = GetBaselineKey(record);
+  EXPECT_FALSE(LoadBaseline(dir, key).has_value());
+
+  SaveBaseline(dir, record);
+  EXPECT_TRUE(GetBaselinePath(dir, key).ends_with("example_task_mpi_enabled.pipeline.p4t2.json"));
+  const auto samples = LoadBaseline(dir, key);
+  ASSERT_TRUE(samples.has_value());
+  EXPECT_EQ(*samples, record.results.time_samples);
+
+  // Other configurations of the same task have their own baselines
+  auto other = key;
+  other.num_proc = 2;
+  EXPECT_FALSE(LoadBaseline(dir, other).has_value());
+  std::filesystem::remove_all(dir);
+}
+
+TEST(BaselineStoreTest, IgnoresUnknownFormatVersion) {
+  const auto dir = (std::filesystem::temp_directory_path() / "ppc_perf_baseline_version_test").string();
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto key = GetBaselineKey(MakeSampleRecord());
+  std::ofstream(GetBaselinePath(dir, key)) << R"({"format_version": 999, "samples": [1.0]})";
+  EXPECT_FALSE(LoadBaseline(dir, key).has_value());
+  std::ofstream(GetBaselinePath(dir, key)) << "not json";
+  EXPECT_FALSE(LoadBaseline(dir, key).has_value());
+  std::filesystem::remove_all(dir);
+}
+
+TEST(PerfSizeLadderTest, ParsesSizeSuffix) {
+  EXPECT_EQ(ppc::util::GetPerfSizeFromName("task_seq_enabled" + ppc::util::PerfSizeSuffix(1000)), 1000U);
+  EXPECT_FALSE(ppc::util::GetPerfSizeFromName("task_seq_enabled").has_value());
+  EXPECT_FALSE(ppc::util::GetPerfSizeFromName("task_size_seq_enabled").has_value());
+  EXPECT_FALSE(ppc::util::GetPerfSizeFromName("task_seq_enabled_size0").has_value());
+  EXPECT_FALSE(ppc::util::GetPerfSizeFromName("task_seq_enabled_size12x").has_value());
+}
+
+namespace {
+
+class LadderTask : public CountingTask {
+ public:
+  explicit LadderTask(const int & /*input*/) {}
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kSEQ;
+  }
+};
+
+}  // namespace
+
+TEST(PerfSizeLadderTest, MakesOneCasePerSizeAndMode) {
+  const auto settings_path = (std::filesystem::temp_directory_path() / "ppc_ladder_settings.json").string();
+  auto settings = ppc::util::InitJSONPtr();
+  (*settings)["tasks"]["seq"] = "enabled";
+  std::ofstream(settings_path) << settings->dump();
+
+  constexpr std::array<std::size_t, 2> kSizes = {100, 2000};
+  const auto cases = ppc::util::MakeAllPerfTasks<int, LadderTask>(settings_path, kSizes);
+  std::filesystem::remove(settings_path);
+
+  static_assert(std::tuple_size_v<std::decay_t<decltype(cases)>> == 4);
+  const auto &name = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kNameTest)>(std::get<0>(cases));
+  EXPECT_TRUE(name.ends_with("_seq_enabled_size100"));
+  EXPECT_EQ(ppc::util::GetPerfSizeFromName(
+                std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kNameTest)>(std::get<2>(cases))),
+            2000U);
+  EXPECT_EQ(std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(std::get<3>(cases)),
+            PerfResults::TypeOfRunning::kTaskRun);
+}
+
+TEST(ResultsSinkTest, DeducesInputSize) {
+  EXPECT_EQ(ppc::util::DeduceInputSize(std::vector<int>(7)), 7U);
+  EXPECT_EQ(ppc::util::DeduceInputSize(std::string("abc")), 3U);
+  EXPECT_EQ(ppc::util::DeduceInputSize(200), 200U);
+  EXPECT_EQ(ppc::util::DeduceInputSize(-5), 0U);
+  EXPECT_EQ(ppc::util::DeduceInputSize(2.5), 0U);
+  EXPECT_EQ(ppc::util::DeduceInputSize(std::make_tuple(std::vector<int>(4), 3, std::vector<double>(6))), 10U);
+}
+
+TEST(StatisticsTest, ComputesPercentilesAndSpread) {
+  auto stats = ComputeStatistics({5.0, 1.0, 4.0, 2.0, 3.0});
+  EXPECT_EQ(stats.count, 5U);
+  EXPECT_DOUBLE_EQ(stats.mean, 3.0);
+  EXPECT_DOUBLE_EQ(stats.min, 1.0);
+  EXPECT_DOUBLE_EQ(stats.max, 5.0);
+  EXPECT_DOUBLE_EQ(stats.median, 3.0);
+  EXPECT_DOUBLE_EQ(stats.p90, 4.6);
+  EXPECT_DOUBLE_EQ(stats.p99, 4.96);
+  EXPECT_NEAR(stats.stddev, 1.5811388301, 1e-9);
+  EXPECT_LT(stats.ci_low, stats.mean);
+  EXPECT_GT(stats.ci_high, stats.mean);
+  EXPECT_NEAR(stats.ci_high - stats.mean, 2.776 * stats.stddev / std::sqrt(5.0), 1e-9);
+}
+
+TEST(StatisticsTest, EmptySamplesYieldZeros) {
+  auto stats = ComputeStatistics({});
+  EXPECT_EQ(stats.count, 0U);
+  EXPECT_DOUBLE_EQ(stats.mean, 0.0);
+  EXPECT_DOUBLE_EQ(stats.p99, 0.0);
+}
+
+TEST(StatisticsTest, SingleSampleHasZeroWidthInterval) {
+  auto stats = ComputeStatistics({2.0});
+  EXPECT_DOUBLE_EQ(stats.median, 2.0);
+  EXPECT_DOUBLE_EQ(stats.ci_low, 2.0);
+  EXPECT_DOUBLE_EQ(stats.ci_high, 2.0);
+}
+
 TEST(PerfTest, PrintPerfStatisticThrowsOnNone) {
   {
     auto task_ptr = std::make_shared<DummyTask>();
@@ -37,6 +37,11 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
 };
 
 /// @brief Initializes the testing environment (e.g., MPI, logging).
+/// @details MPI is initialized with MPI_Init_thread at the level named by PPC_MPI_THREAD_LEVEL ("funneled" by
+/// default), and the OpenMP team of every process is sized from PPC_NUM_THREADS. Under PPC_THREAD_AFFINITY the
+/// OpenMP, TBB and ThreadPool workers are pinned, with processes of one node on disjoint CPUs.
+/// When PPC_TRACE_FILE is set, tests and task stages of all processes are traced and written there as one Chrome
+/// trace after the last test; binaries linking ppc_mpi_profiler also trace their MPI calls.
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS or MPI error code if initialization/
@@ -44,6 +49,7 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
 int Init(int argc, char **argv);
 
 /// @brief Initializes the testing environment only for gtest.
+/// @details Threads are pinned under PPC_THREAD_AFFINITY and traced under PPC_TRACE_FILE as in Init().
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS.
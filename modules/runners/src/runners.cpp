@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include <mpi.h>
+#include <omp.h>
 
 #include <chrono>
 #include <cstdint>
@@ -10,12 +11,18 @@
 #include <format>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 
 #include "oneapi/tbb/global_control.h"
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/task_scheduler_observer.h"
+#include "util/include/thread_pool.hpp"
+#include "util/include/topology.hpp"
+#include "util/include/tracing.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
@@ -124,6 +131,110 @@ bool HasFlag(int argc, char **argv, std::string_view flag) {
   return false;
 }
 
+std::optional<int> ParseMpiThreadLevel(std::string_view level) {
+  if (level == "single") {
+    return MPI_THREAD_SINGLE;
+  }
+  if (level == "funneled") {
+    return MPI_THREAD_FUNNELED;
+  }
+  if (level == "serialized") {
+    return MPI_THREAD_SERIALIZED;
+  }
+  if (level == "multiple") {
+    return MPI_THREAD_MULTIPLE;
+  }
+  return std::nullopt;
+}
+
+/// Binds every TBB worker to the CPU of its arena slot when it joins an arena.
+class PinningObserver : public tbb::task_scheduler_observer {
+ public:
+  PinningObserver() {
+    observe(true);
+  }
+  PinningObserver(const PinningObserver &) = delete;
+  PinningObserver &operator=(const PinningObserver &) = delete;
+  PinningObserver(PinningObserver &&) = delete;
+  PinningObserver &operator=(PinningObserver &&) = delete;
+  ~PinningObserver() override {
+    observe(false);
+  }
+
+  void on_scheduler_entry(bool is_worker) override {  // NOLINT(readability-identifier-naming)
+    if (is_worker) {
+      ppc::util::PinWorkerThread(tbb::this_task_arena::current_thread_index());
+    }
+  }
+};
+
+/// Applies PPC_THREAD_AFFINITY to the main thread and the OpenMP team of this process.
+/// Processes sharing a node use disjoint CPU slots, ordered by their node-local rank.
+void PinThreads(int local_rank) {
+  const int num_threads = ppc::util::GetNumThreads();
+  ppc::util::SetAffinitySlotOffset(local_rank * num_threads);
+  if (ppc::util::GetThreadAffinity() == ppc::util::AffinityPolicy::kNone) {
+    return;
+  }
+  ppc::util::PinMainThread(num_threads);
+#pragma omp parallel default(none) num_threads(num_threads)
+  {
+    if (omp_get_thread_num() != 0) {
+      ppc::util::PinWorkerThread(omp_get_thread_num());
+    }
+  }
+}
+
+int NodeLocalRank() {
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int local_rank = 0;
+  MPI_Comm_rank(node_comm, &local_rank);
+  MPI_Comm_free(&node_comm);
+  return local_rank;
+}
+
+/// Records every test as a span, so the task stages and MPI calls of the trace can be told apart.
+class TraceListener : public ::testing::EmptyTestEventListener {
+ public:
+  void OnTestStart(const ::testing::TestInfo & /*test_info*/) override {
+    begin_ns_ = ppc::util::TraceClock();
+  }
+  void OnTestEnd(const ::testing::TestInfo &test_info) override {
+    if (ppc::util::IsTracingEnabled()) {
+      const auto name = std::format("{}.{}", test_info.test_suite_name(), test_info.name());
+      ppc::util::RecordTraceEvent(ppc::util::InternTraceName(name), "test", begin_ns_, ppc::util::TraceClock());
+    }
+  }
+
+ private:
+  std::uint64_t begin_ns_ = 0;
+};
+
+/// Starts tracing under PPC_TRACE_FILE; returns the path of the trace, empty if disabled.
+std::string StartTracing() {
+  auto path = ppc::util::GetTraceFile();
+  if (!path.empty()) {
+    ppc::util::SetTracing(true);
+    ::testing::UnitTest::GetInstance()->listeners().Append(new TraceListener());
+  }
+  return path;
+}
+
+void FinishTracing(const std::string &path) {
+  if (path.empty()) {
+    return;
+  }
+  ppc::util::SetTracing(false);
+  ppc::util::WriteTrace(path);
+}
+
+/// Parks the framework pool, if a task started it, and releases the OpenMP team once no task runs anymore, so no
+/// worker keeps spinning while the process shuts down.
+void ReleaseThreads() {
+  ppc::util::ThreadPool::PauseIfCreated();
+}
+
 int RunAllTestsSafely() {
   try {
     return RunAllTests();
@@ -140,15 +251,34 @@ int RunAllTestsSafely() {
 }  // namespace
 
 int Init(int argc, char **argv) {
-  const int init_res = MPI_Init(&argc, &argv);
+  const auto thread_level = ppc::util::GetMpiThreadLevel();
+  const auto required = ParseMpiThreadLevel(thread_level);
+  if (!required.has_value()) {
+    std::cerr << std::format("[  ERROR  ] Unknown PPC_MPI_THREAD_LEVEL '{}'", thread_level) << '\n';
+    return EXIT_FAILURE;
+  }
+
+  int provided = MPI_THREAD_SINGLE;
+  const int init_res = MPI_Init_thread(&argc, &argv, *required, &provided);
   if (init_res != MPI_SUCCESS) {
-    std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
+    std::cerr << std::format("[  ERROR  ] MPI_Init_thread failed with code {}", init_res) << '\n';
     MPI_Abort(MPI_COMM_WORLD, init_res);
     return init_res;
   }
 
-  // Limit the number of threads in TBB
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (provided < *required && rank == 0) {
+    std::cerr << std::format("[  WARNING  ] MPI provides thread level {} instead of {} ({})", provided, *required,
+                             thread_level)
+              << '\n';
+  }
+
+  // Every process runs its threaded kernels on PPC_NUM_THREADS threads
+  omp_set_num_threads(ppc::util::GetNumThreads());
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  PinThreads(NodeLocalRank());
+  const PinningObserver pinning;
 
   ::testing::InitGoogleTest(&argc, argv);
 
@@ -157,16 +287,17 @@ int Init(int argc, char **argv) {
   SyncGTestFilter();
 
   auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
-  int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   const bool print_workers = HasFlag(argc, argv, "--print-workers");
   if (rank != 0 && !print_workers) {
     auto *listener = listeners.Release(listeners.default_result_printer());
     listeners.Append(new WorkerTestFailurePrinter(std::shared_ptr<::testing::TestEventListener>(listener)));
   }
   listeners.Append(new UnreadMessagesDetector());
+  const auto trace_file = StartTracing();
 
   const int status = RunAllTestsSafely();
+  FinishTracing(trace_file);
+  ReleaseThreads();
 
   const int finalize_res = MPI_Finalize();
   if (finalize_res != MPI_SUCCESS) {
@@ -180,9 +311,15 @@ int Init(int argc, char **argv) {
 int SimpleInit(int argc, char **argv) {
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  PinThreads(0);
+  const PinningObserver pinning;
 
   testing::InitGoogleTest(&argc, argv);
-  return RunAllTests();
+  const auto trace_file = StartTracing();
+  const int status = RunAllTests();
+  FinishTracing(trace_file);
+  ReleaseThreads();
+  return status;
 }
 
 }  // namespace ppc::runners
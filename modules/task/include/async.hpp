@@ -0,0 +1,274 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::task {
+
+/// @brief Resources given to a task that runs off the calling thread.
+struct AsyncOptions {
+  /// @brief Value of ppc::util::GetNumThreads() inside the task; 0 keeps the process-wide setting.
+  int num_threads = 0;
+};
+
+/// @brief Checks whether a task type may run on a thread other than the one that initialized MPI.
+/// @details MPI and hybrid tasks issue collectives on MPI_COMM_WORLD, so they have to stay on the main thread and
+/// run in the same order on every process. Other tasks can overlap with them, e.g. while rank 0 waits in a gather.
+template <typename TaskType>
+constexpr bool RunsOffMainThread() {
+  constexpr auto kType = TaskType::GetStaticTypeOfTask();
+  return kType != TypeOfTask::kMPI && kType != TypeOfTask::kALL;
+}
+
+/// @brief Runs all four pipeline stages of a task.
+/// @details Like the perf harness, later stages run even after a stage returned false, so the task always ends in
+/// a finished state.
+/// @return True if every stage succeeded.
+template <typename InType, typename OutType>
+bool RunPipeline(Task<InType, OutType> &task) {
+  bool ok = task.Validation();
+  ok = task.PreProcessing() && ok;
+  ok = task.Run() && ok;
+  return task.PostProcessing() && ok;
+}
+
+/// @brief Wraps the pipeline of a task into a callable that can run on any thread.
+/// @details The callable shares ownership of the task, so the task outlives the run.
+template <typename TaskType>
+std::function<bool()> MakePipelineJob(std::shared_ptr<TaskType> task, AsyncOptions options = {}) {
+  static_assert(RunsOffMainThread<TaskType>(), "MPI tasks must run on the thread that initialized MPI");
+  return [task = std::move(task), options] {
+    const ppc::util::ScopedNumThreads threads(options.num_threads);
+    return ppc::task::RunPipeline(*task);
+  };
+}
+
+/// @brief Starts the pipeline of a task on a new thread.
+/// @return Future of the pipeline result; exceptions thrown by the task are rethrown by get().
+template <typename TaskType>
+std::future<bool> RunAsync(std::shared_ptr<TaskType> task, AsyncOptions options = {}) {
+  return std::async(std::launch::async, MakePipelineJob(std::move(task), options));
+}
+
+/// @brief Awaitable that runs one or more task pipelines concurrently, each on its own thread.
+/// @details The awaiting coroutine is resumed on the thread of the pipeline that finishes last; co_await yields
+/// true if all pipelines succeeded and rethrows the first exception thrown by any of them.
+class PipelineAwaiter {
+ public:
+  explicit PipelineAwaiter(std::vector<std::function<bool()>> jobs) : jobs_(std::move(jobs)) {}
+
+  [[nodiscard]] bool await_ready() const noexcept {  // NOLINT(readability-identifier-naming)
+    return jobs_.empty();
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {  // NOLINT(readability-identifier-naming)
+    state_ = std::make_shared<State>(jobs_.size(), handle);
+    // The coroutine, and this awaiter with it, may be destroyed as soon as the last job finishes, so only locals
+    // are touched after the first thread has started
+    auto jobs = std::move(jobs_);
+    auto state = state_;
+    for (auto &job : jobs) {
+      std::thread([state, job = std::move(job)]() mutable {
+        bool ok = false;
+        try {
+          ok = job();
+        } catch (...) {
+          state->SetError(std::current_exception());
+        }
+        // The job shares ownership of its task; release it before the coroutine can resume, so the task is never
+        // destroyed on this thread after the awaiting side has let go of it
+        job = nullptr;
+        state->Finish(ok);
+      }).detach();
+    }
+  }
+
+  bool await_resume() {  // NOLINT(readability-identifier-naming)
+    if (!state_) {
+      return true;
+    }
+    if (state_->error) {
+      std::rethrow_exception(state_->error);
+    }
+    return state_->ok.load();
+  }
+
+  /// @brief Adds the pipelines of another awaiter, which must not have been awaited yet.
+  void Append(PipelineAwaiter &&other) {
+    for (auto &job : other.jobs_) {
+      jobs_.push_back(std::move(job));
+    }
+    other.jobs_.clear();
+  }
+
+ private:
+  struct State {
+    State(std::size_t count, std::coroutine_handle<> handle) : remaining(count), continuation(handle) {}
+
+    void SetError(std::exception_ptr exception) {
+      std::lock_guard lock(mutex);
+      if (!error) {
+        error = std::move(exception);
+      }
+    }
+
+    void Finish(bool job_ok) {
+      if (!job_ok) {
+        ok.store(false);
+      }
+      if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        continuation.resume();
+      }
+    }
+
+    std::atomic<std::size_t> remaining;
+    std::atomic<bool> ok{true};
+    std::mutex mutex;
+    std::exception_ptr error;
+    std::coroutine_handle<> continuation;
+  };
+
+  std::vector<std::function<bool()>> jobs_;
+  std::shared_ptr<State> state_;
+};
+
+/// @brief Returns an awaitable that runs the pipeline of a task on its own thread.
+template <typename TaskType>
+PipelineAwaiter Await(std::shared_ptr<TaskType> task, AsyncOptions options = {}) {
+  std::vector<std::function<bool()>> jobs;
+  jobs.push_back(MakePipelineJob(std::move(task), options));
+  return PipelineAwaiter(std::move(jobs));
+}
+
+/// @brief Returns an awaitable that runs several pipelines concurrently and completes when all of them have finished.
+template <typename... Awaiters>
+PipelineAwaiter WhenAll(PipelineAwaiter first, Awaiters &&...rest) {
+  (first.Append(std::forward<Awaiters>(rest)), ...);
+  return first;
+}
+
+template <typename T>
+class AsyncJob;
+
+namespace detail {
+
+template <typename T>
+struct AsyncPromiseBase {
+  std::promise<T> result;
+  std::exception_ptr error;
+
+  /// Publishes the result only after destroying the coroutine frame. The frame holds the coroutine parameters,
+  /// typically the shared_ptrs of the awaited tasks, and it finishes on a pipeline thread; releasing them first
+  /// keeps tasks from being destroyed there after Get() has returned on the waiting thread.
+  struct FinalAwaiter {
+    [[nodiscard]] bool await_ready() const noexcept {  // NOLINT(readability-identifier-naming)
+      return false;
+    }
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle) noexcept {  // NOLINT(readability-identifier-naming)
+      auto &promise = handle.promise();
+      auto result = std::move(promise.result);
+      auto error = std::move(promise.error);
+      if constexpr (std::is_void_v<T>) {
+        handle.destroy();
+        if (error) {
+          result.set_exception(std::move(error));
+        } else {
+          result.set_value();
+        }
+      } else {
+        auto value = std::move(promise.value);
+        handle.destroy();
+        if (error) {
+          result.set_exception(std::move(error));
+        } else {
+          result.set_value(std::move(*value));
+        }
+      }
+    }
+    void await_resume() const noexcept {}  // NOLINT(readability-identifier-naming)
+  };
+
+  std::suspend_never initial_suspend() noexcept {  // NOLINT(readability-identifier-naming)
+    return {};
+  }
+  FinalAwaiter final_suspend() noexcept {  // NOLINT(readability-identifier-naming)
+    return {};
+  }
+  void unhandled_exception() {  // NOLINT(readability-identifier-naming)
+    error = std::current_exception();
+  }
+};
+
+template <typename T>
+struct AsyncPromise : AsyncPromiseBase<T> {
+  std::optional<T> value;
+
+  AsyncJob<T> get_return_object();  // NOLINT(readability-identifier-naming)
+  void return_value(T result) {     // NOLINT(readability-identifier-naming)
+    value.emplace(std::move(result));
+  }
+};
+
+template <>
+struct AsyncPromise<void> : AsyncPromiseBase<void> {
+  AsyncJob<void> get_return_object();  // NOLINT(readability-identifier-naming)
+  void return_void() {}                // NOLINT(readability-identifier-naming)
+};
+
+}  // namespace detail
+
+/// @brief Coroutine type for composing task pipelines.
+/// @details The coroutine starts immediately and continues on the threads of the pipelines it awaits, so the caller
+/// is free to run other work, such as an MPI task, until it needs the result:
+/// @code
+/// ppc::task::AsyncJob<bool> Compare(std::shared_ptr<SeqTask> seq, std::shared_ptr<OmpTask> omp) {
+///   co_return co_await ppc::task::WhenAll(ppc::task::Await(seq), ppc::task::Await(omp, {.num_threads = 4}));
+/// }
+/// @endcode
+template <typename T>
+class AsyncJob {
+ public:
+  using promise_type = detail::AsyncPromise<T>;  // NOLINT(readability-identifier-naming)
+
+  explicit AsyncJob(std::future<T> result) : result_(std::move(result)) {}
+
+  /// @brief Blocks until the coroutine has finished and returns its result.
+  T Get() {
+    return result_.get();
+  }
+
+  /// @brief Checks whether the coroutine has finished.
+  [[nodiscard]] bool IsReady() const {
+    return result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+ private:
+  std::future<T> result_;
+};
+
+template <typename T>
+AsyncJob<T> detail::AsyncPromise<T>::get_return_object() {
+  return AsyncJob<T>(this->result.get_future());
+}
+
+inline AsyncJob<void> detail::AsyncPromise<void>::get_return_object() {
+  return AsyncJob<void>(result.get_future());
+}
+
+}  // namespace ppc::task
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+
+namespace ppc::task {
+
+/// @brief Options of a BatchRunner.
+struct BatchOptions {
+  /// @brief Number of inputs validated and preprocessed ahead of the one being run; 0 disables pipelining.
+  /// @details Must be 0 for MPI and hybrid tasks, see BatchRunner.
+  std::size_t pipeline_depth = 1;
+  /// @brief Feeds new inputs into finished task objects instead of constructing a task per input.
+  /// @details SetupImpl() and the scratch arena of a reused task are kept, so this is only valid when all inputs of
+  /// a batch have the same shape. The output is reset to the value the task had right after construction.
+  bool reuse_tasks = false;
+};
+
+/// @brief Counters of the most recent BatchRunner::Run() call.
+struct BatchStats {
+  std::size_t inputs = 0;
+  /// @brief Inputs for which a pipeline stage returned false.
+  std::size_t failed = 0;
+  /// @brief Task objects constructed; lower than inputs when tasks are reused.
+  std::size_t tasks_created = 0;
+  /// @brief Wall time of the whole batch in seconds.
+  double elapsed = 0.0;
+  /// @brief Summed Validation and PreProcessing time in seconds.
+  double prepare_time = 0.0;
+  /// @brief Summed Run and PostProcessing time in seconds.
+  double run_time = 0.0;
+
+  [[nodiscard]] double InputsPerSecond() const {
+    return elapsed > 0.0 ? static_cast<double>(inputs) / elapsed : 0.0;
+  }
+};
+
+/// @brief Runs one task type over a sequence of inputs.
+/// @details Validation and PreProcessing of the next inputs run on a helper thread while the current input is in
+/// Run and PostProcessing, so the stages of consecutive inputs overlap. Outputs are returned in input order.
+/// MPI and hybrid tasks cannot be pipelined: their stages issue collectives on the communicators they pick
+/// themselves, usually MPI_COMM_WORLD, so stages of two inputs running at once would interleave their messages.
+/// Their inputs run one after another, which the default options select for them; requesting a pipeline depth
+/// for them is an error rather than being dropped silently.
+/// @tparam TaskType Concrete task type, constructible from its input type.
+template <typename TaskType>
+class BatchRunner {
+ public:
+  using InType = std::remove_cvref_t<decltype(std::declval<TaskType &>().GetInput())>;
+  using OutType = std::remove_cvref_t<decltype(std::declval<TaskType &>().GetOutput())>;
+
+  /// @throws std::invalid_argument If a pipeline depth is requested for an MPI or hybrid task.
+  explicit BatchRunner(BatchOptions options = {.pipeline_depth = CanPipeline() ? 1U : 0U}) : options_(options) {
+    if (!CanPipeline() && options_.pipeline_depth != 0) {
+      throw std::invalid_argument("MPI and hybrid tasks cannot be pipelined, set pipeline_depth to 0");
+    }
+  }
+
+  /// @brief Runs the full pipeline for every input.
+  /// @return Outputs in input order.
+  std::vector<OutType> Run(std::vector<InType> inputs) {
+    stats_ = BatchStats{};
+    tasks_created_ = 0;
+    stats_.inputs = inputs.size();
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<OutType> outputs;
+    outputs.reserve(inputs.size());
+    if (options_.pipeline_depth == 0 || inputs.size() < 2) {
+      for (auto &input : inputs) {
+        auto item = Prepare(std::move(input), stats_.prepare_time);
+        outputs.push_back(Finish(item));
+      }
+    } else {
+      RunPipelined(inputs, outputs);
+    }
+
+    stats_.elapsed = SecondsSince(start);
+    stats_.tasks_created = tasks_created_;
+    return outputs;
+  }
+
+  [[nodiscard]] const BatchStats &GetStats() const {
+    return stats_;
+  }
+
+ private:
+  struct PooledTask {
+    std::shared_ptr<TaskType> task;
+    OutType initial_output;
+  };
+
+  struct Item {
+    PooledTask pooled;
+    bool ok = false;
+  };
+
+  static constexpr bool CanPipeline() {
+    constexpr auto kType = TaskType::GetStaticTypeOfTask();
+    return kType != TypeOfTask::kMPI && kType != TypeOfTask::kALL;
+  }
+
+  static double SecondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+  }
+
+  PooledTask Acquire(InType &&input) {
+    if (options_.reuse_tasks) {
+      std::lock_guard lock(pool_mutex_);
+      if (!pool_.empty()) {
+        auto pooled = std::move(pool_.back());
+        pool_.pop_back();
+        pooled.task->GetInput() = std::move(input);
+        pooled.task->GetOutput() = pooled.initial_output;
+        return pooled;
+      }
+    }
+    auto task = std::make_shared<TaskType>(std::move(input));
+    task->GetStateOfTesting() = StateOfTesting::kPerf;
+    tasks_created_++;
+    auto initial_output = options_.reuse_tasks ? task->GetOutput() : OutType{};
+    return {.task = std::move(task), .initial_output = std::move(initial_output)};
+  }
+
+  Item Prepare(InType &&input, double &prepare_time) {
+    Item item{.pooled = Acquire(std::move(input)), .ok = false};
+    const auto start = std::chrono::high_resolution_clock::now();
+    // Like Perf, every stage is driven even after a failure so that the task finishes its pipeline
+    item.ok = item.pooled.task->Validation();
+    item.ok = item.pooled.task->PreProcessing() && item.ok;
+    prepare_time += SecondsSince(start);
+    return item;
+  }
+
+  OutType Finish(Item &item) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    bool ok = item.pooled.task->Run() && item.ok;
+    ok = item.pooled.task->PostProcessing() && ok;
+    stats_.run_time += SecondsSince(start);
+    if (!ok) {
+      stats_.failed++;
+    }
+    if (!options_.reuse_tasks) {
+      return std::move(item.pooled.task->GetOutput());
+    }
+    OutType output = std::move(item.pooled.task->GetOutput());
+    std::lock_guard lock(pool_mutex_);
+    pool_.push_back(std::move(item.pooled));
+    return output;
+  }
+
+  void RunPipelined(std::vector<InType> &inputs, std::vector<OutType> &outputs) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Item> ready;
+    std::exception_ptr error;
+    bool stop = false;
+    double prepare_time = 0.0;
+
+    std::thread producer([&] {
+      for (auto &input : inputs) {
+        std::optional<Item> item;
+        try {
+          item.emplace(Prepare(std::move(input), prepare_time));
+        } catch (...) {
+          std::lock_guard lock(mutex);
+          error = std::current_exception();
+          cv.notify_all();
+          return;
+        }
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return stop || ready.size() < options_.pipeline_depth; });
+        if (stop) {
+          return;
+        }
+        ready.push_back(std::move(*item));
+        cv.notify_all();
+      }
+    });
+
+    try {
+      for (std::size_t i = 0; i < inputs.size(); i++) {
+        Item item;
+        {
+          std::unique_lock lock(mutex);
+          cv.wait(lock, [&] { return !ready.empty() || error != nullptr; });
+          if (ready.empty()) {
+            std::rethrow_exception(error);
+          }
+          item = std::move(ready.front());
+          ready.pop_front();
+          cv.notify_all();
+        }
+        outputs.push_back(Finish(item));
+      }
+    } catch (...) {
+      {
+        std::lock_guard lock(mutex);
+        stop = true;
+        cv.notify_all();
+      }
+      producer.join();
+      throw;
+    }
+    producer.join();
+    stats_.prepare_time = prepare_time;
+  }
+
+  BatchOptions options_;
+  BatchStats stats_;
+  std::mutex pool_mutex_;
+  std::vector<PooledTask> pool_;
+  std::size_t tasks_created_ = 0;
+};
+
+}  // namespace ppc::task
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "util/include/aligned_allocator.hpp"
+
+namespace ppc::task {
+
+/// @brief Bump allocator for task working buffers that keeps its memory across pipeline executions.
+/// @details Buffers are carved from large aligned blocks. Reset() rewinds to the persistent mark instead of freeing,
+/// so a task that requests the same buffers on every run allocates only on the first one. Blocks come from
+/// ppc::util::AllocateBuffer(), so large ones are backed by huge pages. Allocations made before
+/// Persist() survive Reset() and are meant for data prepared once in Task::SetupImpl().
+/// Only trivially copyable, trivially destructible element types are supported; buffers are not initialized.
+class ScratchArena {
+ public:
+  /// @brief Alignment of every buffer, one cache line.
+  static constexpr std::size_t kAlignment = ppc::util::kCacheLineSize;
+
+  ScratchArena() = default;
+  ScratchArena(const ScratchArena &) = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+  ScratchArena(ScratchArena &&) noexcept = default;
+  ScratchArena &operator=(ScratchArena &&) noexcept = default;
+  ~ScratchArena() = default;
+
+  /// @brief Returns an uninitialized buffer of `count` elements that stays valid until the next Reset() or Release().
+  template <typename T>
+  std::span<T> Allocate(std::size_t count) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "ScratchArena only holds trivially copyable element types");
+    static_assert(alignof(T) <= kAlignment, "Element alignment exceeds the arena alignment");
+    if (count == 0) {
+      return {};
+    }
+    auto *memory = AllocateBytes(count * sizeof(T));
+    return {std::launder(reinterpret_cast<T *>(memory)), count};
+  }
+
+  /// @brief Returns a buffer of `count` elements set to `value`.
+  template <typename T>
+  std::span<T> AllocateFilled(std::size_t count, const T &value) {
+    auto buffer = Allocate<T>(count);
+    std::ranges::fill(buffer, value);
+    return buffer;
+  }
+
+  /// @brief Makes all current allocations survive subsequent Reset() calls.
+  void Persist() {
+    persistent_block_ = block_;
+    persistent_offset_ = offset_;
+  }
+
+  /// @brief Invalidates the buffers handed out since the last Persist() and keeps the memory for reuse.
+  void Reset() {
+    block_ = persistent_block_;
+    offset_ = persistent_offset_;
+  }
+
+  /// @brief Frees all memory, including persistent allocations.
+  void Release() {
+    blocks_.clear();
+    block_ = 0;
+    offset_ = 0;
+    persistent_block_ = 0;
+    persistent_offset_ = 0;
+  }
+
+  /// @brief Total bytes owned by the arena.
+  [[nodiscard]] std::size_t Capacity() const {
+    std::size_t capacity = 0;
+    for (const auto &block : blocks_) {
+      capacity += block.size;
+    }
+    return capacity;
+  }
+
+  /// @brief Number of memory blocks obtained from the system so far; stays constant once runs are allocation-free.
+  [[nodiscard]] std::size_t NumBlocks() const {
+    return blocks_.size();
+  }
+
+ private:
+  static constexpr std::size_t kMinBlockSize = std::size_t{64} * 1024;
+
+  struct BufferDelete {
+    std::size_t size = 0;
+    void operator()(std::byte *ptr) const {
+      ppc::util::DeallocateBuffer(ptr, size);
+    }
+  };
+
+  struct Block {
+    std::unique_ptr<std::byte[], BufferDelete> data;
+    std::size_t size = 0;
+  };
+
+  static std::size_t AlignUp(std::size_t value) {
+    return (value + kAlignment - 1) & ~(kAlignment - 1);
+  }
+
+  std::byte *AllocateBytes(std::size_t bytes) {
+    bytes = AlignUp(bytes);
+    // Continue in the current block, then in blocks kept from previous runs, and only then ask for new memory
+    for (; block_ < blocks_.size(); block_++, offset_ = 0) {
+      if (offset_ + bytes <= blocks_[block_].size) {
+        auto *memory = blocks_[block_].data.get() + offset_;
+        offset_ += bytes;
+        return memory;
+      }
+    }
+    const std::size_t size = std::max(bytes, kMinBlockSize);
+    blocks_.push_back({.data = std::unique_ptr<std::byte[], BufferDelete>(
+                           static_cast<std::byte *>(ppc::util::AllocateBuffer(size)), BufferDelete{.size = size}),
+                       .size = size});
+    block_ = blocks_.size() - 1;
+    offset_ = bytes;
+    return blocks_[block_].data.get();
+  }
+
+  std::vector<Block> blocks_;
+  std::size_t block_ = 0;
+  std::size_t offset_ = 0;
+  std::size_t persistent_block_ = 0;
+  std::size_t persistent_offset_ = 0;
+};
+
+}  // namespace ppc::task
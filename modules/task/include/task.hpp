@@ -1,7 +1,5 @@
 #pragma once
 
-#include <omp.h>
-
 #include <array>
 #include <chrono>
 #include <cstdint>
@@ -16,6 +14,10 @@
 #include <util/include/util.hpp>
 #include <utility>
 
+#include "task/include/scratch_arena.hpp"
+#include "util/include/memory_tracker.hpp"
+#include "util/include/tracing.hpp"
+
 namespace ppc::task {
 
 /// @brief Represents the type of task (parallelization technology).
@@ -98,8 +100,34 @@ inline std::string GetStringTaskType(TypeOfTask type_of_task, const std::string
 
 enum class StateOfTesting : uint8_t { kFunc, kPerf };
 
+/// @brief Durations of the pipeline stages of the most recent execution, in seconds.
+struct StageTimings {
+  double validation = 0.0;
+  double preprocessing = 0.0;
+  double run = 0.0;
+  double postprocessing = 0.0;
+};
+
+/// @brief Heap footprint of one pipeline stage.
+struct StageFootprint {
+  /// @brief Heap bytes allocated during the stage, including memory freed before it ended.
+  std::uint64_t allocated_bytes = 0;
+  /// @brief Largest number of heap bytes in use by the process during the stage.
+  std::uint64_t peak_bytes = 0;
+};
+
+/// @brief Heap footprint of the pipeline stages of the most recent execution, see ppc::util::HeapScope.
+struct StageMemory {
+  StageFootprint validation;
+  StageFootprint preprocessing;
+  StageFootprint run;
+  StageFootprint postprocessing;
+};
+
 template <typename InType, typename OutType>
 /// @brief Base abstract class representing a generic task with a defined pipeline.
+/// @details Every execution runs Validation, PreProcessing, Run and PostProcessing. The same object can be executed
+/// repeatedly; SetupImpl() runs only before the first execution, and the scratch arena keeps its memory between runs.
 /// @tparam InType Input data type.
 /// @tparam OutType Output data type.
 class Task {
@@ -113,7 +141,8 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Validation should be called before preprocessing");
     }
-    return ValidationImpl();
+    return MeasureStage("Validation", stage_timings_.validation, stage_memory_.validation,
+                        [this] { return ValidationImpl(); });
   }
 
   /// @brief Performs preprocessing on the input data.
@@ -128,7 +157,8 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PreProcessingImpl();
+    return MeasureStage("PreProcessing", stage_timings_.preprocessing, stage_memory_.preprocessing,
+                        [this] { return Prepare() && PreProcessingImpl(); });
   }
 
   /// @brief Executes the main logic of the task.
@@ -140,7 +170,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Run should be called after preprocessing");
     }
-    return RunImpl();
+    return MeasureStage("Run", stage_timings_.run, stage_memory_.run, [this] { return RunImpl(); });
   }
 
   /// @brief Performs postprocessing on the output data.
@@ -155,7 +185,8 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PostProcessingImpl();
+    return MeasureStage("PostProcessing", stage_timings_.postprocessing, stage_memory_.postprocessing,
+                        [this] { return PostProcessingImpl(); });
   }
 
   /// @brief Returns the current testing mode.
@@ -188,6 +219,36 @@ class Task {
     return TypeOfTask::kUnknown;
   }
 
+  /// @brief Returns the stage durations recorded during the most recent pipeline execution.
+  /// @return Durations of Validation, PreProcessing, Run and PostProcessing in seconds.
+  [[nodiscard]] const StageTimings &GetStageTimings() const {
+    return stage_timings_;
+  }
+
+  /// @brief Returns the heap footprint recorded during the most recent pipeline execution.
+  [[nodiscard]] const StageMemory &GetStageMemory() const {
+    return stage_memory_;
+  }
+
+  /// @brief Returns true once SetupImpl() has succeeded and the task can be re-run without setting up again.
+  [[nodiscard]] bool IsPrepared() const {
+    return prepared_;
+  }
+
+  /// @brief Makes the next pipeline execution run SetupImpl() again and frees the scratch arena.
+  /// @details Call after replacing the input with data of a different shape.
+  void ResetPreparation() {
+    prepared_ = false;
+    scratch_.Release();
+  }
+
+  /// @brief Returns the scratch arena of the task.
+  /// @details Buffers allocated in SetupImpl() persist across runs; buffers allocated later are recycled at the start
+  /// of every PreProcessing(), so a run that requests the same buffers as the previous one does not allocate.
+  ScratchArena &GetScratch() {
+    return scratch_;
+  }
+
   /// @brief Returns a reference to the input data.
   /// @return Reference to the task's input data.
   InType &GetInput() {
@@ -206,9 +267,6 @@ class Task {
     if (stage_ != PipelineStage::kDone && stage_ != PipelineStage::kException) {
       ppc::util::DestructorFailureFlag::Set();
     }
-#if _OPENMP >= 201811
-    omp_pause_resource_all(omp_pause_soft);
-#endif
   }
 
  protected:
@@ -238,6 +296,14 @@ class Task {
     }
   }
 
+  /// @brief User-defined one-time setup, executed before the first PreProcessingImpl() of the task.
+  /// @details Put work that does not change between repeated runs on the same input here: sizes, partitioning,
+  /// communication counts and working buffers. Measured as part of the first preprocessing stage.
+  /// @return True if setup is successful.
+  virtual bool SetupImpl() {
+    return true;
+  }
+
   /// @brief User-defined validation logic.
   /// @return True if validation is successful.
   virtual bool ValidationImpl() = 0;
@@ -255,12 +321,41 @@ class Task {
   virtual bool PostProcessingImpl() = 0;
 
  private:
+  bool Prepare() {
+    if (prepared_) {
+      scratch_.Reset();
+      return true;
+    }
+    scratch_.Release();
+    if (!SetupImpl()) {
+      return false;
+    }
+    scratch_.Persist();
+    prepared_ = true;
+    return true;
+  }
+
+  template <typename StageFunc>
+  static bool MeasureStage(const char *name, double &duration, StageFootprint &footprint, StageFunc &&stage_func) {
+    const ppc::util::TraceSpan span(name, "stage");
+    const ppc::util::HeapScope heap;
+    const auto start = std::chrono::high_resolution_clock::now();
+    const bool result = std::forward<StageFunc>(stage_func)();
+    duration = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    footprint = {.allocated_bytes = heap.AllocatedBytes(), .peak_bytes = heap.PeakBytes()};
+    return result;
+  }
+
   InType input_{};
   OutType output_{};
   StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  StageTimings stage_timings_;
+  StageMemory stage_memory_;
+  ScratchArena scratch_;
+  bool prepared_ = false;
   enum class PipelineStage : uint8_t {
     kNone,
     kValidation,
@@ -278,13 +373,16 @@ template <typename InType, typename OutType>
 using TaskPtr = std::shared_ptr<Task<InType, OutType>>;
 
 /// @brief Constructs and returns a shared pointer to a task with the given input.
+/// @details The input is moved into the task constructor. Tasks with large inputs take ownership without a deep
+/// copy by declaring the constructor as `explicit MyTask(InType in)` and doing `GetInput() = std::move(in)`.
+/// To borrow data instead, InType can be a non-owning view such as std::span whose storage outlives the task.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Shared a pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::shared_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_shared<TaskType>(in);
+std::shared_ptr<TaskType> TaskGetter(InType in) {
+  return std::make_shared<TaskType>(std::move(in));
 }
 
 }  // namespace ppc::task
@@ -1,22 +1,33 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <libenvpp/env.hpp>
 #include <memory>
+#include <numeric>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <thread>
 #include <utility>
 #include <vector>
 
 #include "runners/include/runners.hpp"
+#include "task/include/async.hpp"
+#include "task/include/batch_runner.hpp"
+#include "task/include/scratch_arena.hpp"
 #include "task/include/task.hpp"
+#include "util/include/memory_tracker.hpp"
+#include "util/include/tracing.hpp"
 #include "util/include/util.hpp"
 
 using ppc::task::StatusOfTask;
@@ -284,6 +295,96 @@ class DummyTask : public Task<int, int> {
   }
 };
 
+class SleepyStagesTask : public Task<int, int> {
+ public:
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return true;
+  }
+  bool RunImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+TEST(TaskTest, RecordsStageTimings) {
+  SleepyStagesTask task;
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  const auto &timings = task.GetStageTimings();
+  EXPECT_GE(timings.preprocessing, 0.02);
+  EXPECT_GE(timings.run, 0.04);
+  EXPECT_LT(timings.validation, timings.preprocessing);
+  EXPECT_LT(timings.postprocessing, timings.run);
+}
+
+class AllocatingRunTask : public Task<int, int> {
+ public:
+  static constexpr std::size_t kBytes = std::size_t{1} << 20;
+
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    buffer_.assign(kBytes, 1);
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    return true;
+  }
+
+ private:
+  std::vector<char> buffer_;
+};
+
+TEST(TaskTest, RecordsStageMemory) {
+  if (!ppc::util::IsHeapTrackingEnabled()) {
+    GTEST_SKIP() << "Heap tracking is unavailable in this build";
+  }
+  AllocatingRunTask task;
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  const auto &memory = task.GetStageMemory();
+  EXPECT_GE(memory.run.allocated_bytes, AllocatingRunTask::kBytes);
+  EXPECT_GE(memory.run.peak_bytes, AllocatingRunTask::kBytes);
+  EXPECT_LT(memory.validation.allocated_bytes, AllocatingRunTask::kBytes);
+  EXPECT_LT(memory.postprocessing.allocated_bytes, AllocatingRunTask::kBytes);
+}
+
+TEST(TaskTest, TracesStagesWhileTracingIsEnabled) {
+  ppc::util::CollectTraceEvents();
+  const bool previous = ppc::util::IsTracingEnabled();
+  ppc::util::SetTracing(true);
+  auto task = std::make_shared<DummyTask>();
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+  ppc::util::SetTracing(previous);
+  std::vector<std::string> stages;
+  for (const auto &event : ppc::util::CollectTraceEvents()) {
+    if (std::string_view(event.category) == "stage") {
+      stages.emplace_back(event.name);
+    }
+  }
+  EXPECT_EQ(stages, (std::vector<std::string>{"Validation", "PreProcessing", "Run", "PostProcessing"}));
+}
+
 TEST(TaskTest, ValidationThrowsIfCalledTwice) {
   auto task = std::make_shared<DummyTask>();
   task->Validation();
@@ -307,6 +408,441 @@ TEST(TaskTest, PostProcessingThrowsIfCalledBeforeRun) {
   EXPECT_THROW(task->PostProcessing(), std::runtime_error);
 }
 
+namespace {
+
+/// Input that counts how many times it was deep-copied.
+struct CopyCountingInput {
+  CopyCountingInput() = default;
+  explicit CopyCountingInput(std::vector<int> values) : data(std::move(values)) {}
+  CopyCountingInput(const CopyCountingInput &other) : data(other.data) {
+    copies++;
+  }
+  CopyCountingInput(CopyCountingInput &&) noexcept = default;
+  CopyCountingInput &operator=(const CopyCountingInput &other) {
+    data = other.data;
+    copies++;
+    return *this;
+  }
+  CopyCountingInput &operator=(CopyCountingInput &&) noexcept = default;
+  ~CopyCountingInput() = default;
+
+  std::vector<int> data;
+  static inline int copies = 0;
+};
+
+class OwningInputTask : public Task<CopyCountingInput, int> {
+ public:
+  explicit OwningInputTask(CopyCountingInput in) {
+    GetInput() = std::move(in);
+  }
+  bool ValidationImpl() override {
+    return !GetInput().data.empty();
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput() = static_cast<int>(GetInput().data.size());
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class BorrowingInputTask : public Task<std::span<const int>, int> {
+ public:
+  explicit BorrowingInputTask(std::span<const int> in) {
+    GetInput() = in;
+  }
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput() = std::accumulate(GetInput().begin(), GetInput().end(), 0);
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(TaskTest, TaskGetterMovesInputIntoTask) {
+  CopyCountingInput::copies = 0;
+  CopyCountingInput input(std::vector<int>(1000, 1));
+  const int *storage = input.data.data();
+
+  // Same call shape as the test harness: a by-value std::function fed with a temporary
+  const std::function<std::shared_ptr<Task<CopyCountingInput, int>>(CopyCountingInput)> getter =
+      ppc::task::TaskGetter<OwningInputTask, CopyCountingInput>;
+  auto task = getter(std::move(input));
+
+  EXPECT_EQ(CopyCountingInput::copies, 0);
+  EXPECT_EQ(task->GetInput().data.data(), storage);
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+  EXPECT_EQ(task->GetOutput(), 1000);
+}
+
+TEST(TaskTest, TaskGetterCopiesLvalueInputOnce) {
+  CopyCountingInput::copies = 0;
+  const CopyCountingInput input(std::vector<int>(10, 1));
+  auto task = ppc::task::TaskGetter<OwningInputTask>(input);
+  EXPECT_EQ(CopyCountingInput::copies, 1);
+  EXPECT_EQ(task->GetInput().data.size(), 10U);
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+}
+
+TEST(TaskTest, SpanInputBorrowsCallerStorage) {
+  const std::vector<int> values = {1, 2, 3, 4};
+  auto task = ppc::task::TaskGetter<BorrowingInputTask>(std::span<const int>(values));
+  EXPECT_EQ(task->GetInput().data(), values.data());
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+  EXPECT_EQ(task->GetOutput(), 10);
+}
+
+TEST(ScratchArenaTest, BuffersAreAlignedAndDisjoint) {
+  ppc::task::ScratchArena arena;
+  auto first = arena.Allocate<double>(3);
+  auto second = arena.AllocateFilled<int>(5, 7);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first.data()) % ppc::task::ScratchArena::kAlignment, 0U);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second.data()) % ppc::task::ScratchArena::kAlignment, 0U);
+  EXPECT_GE(reinterpret_cast<std::uintptr_t>(second.data()),
+            reinterpret_cast<std::uintptr_t>(first.data() + first.size()));
+  EXPECT_EQ(std::count(second.begin(), second.end(), 7), 5);
+  EXPECT_TRUE(arena.Allocate<int>(0).empty());
+}
+
+TEST(ScratchArenaTest, ResetReusesMemoryAndKeepsPersistentBuffers) {
+  ppc::task::ScratchArena arena;
+  auto persistent = arena.AllocateFilled<int>(16, 42);
+  arena.Persist();
+
+  const double *first_run = nullptr;
+  std::size_t blocks = 0;
+  for (int run = 0; run < 3; run++) {
+    arena.Reset();
+    // Larger than a block, so the first run has to grow the arena
+    auto big = arena.Allocate<double>(100000);
+    auto small = arena.Allocate<char>(10);
+    EXPECT_NE(small.data(), nullptr);
+    if (run == 0) {
+      first_run = big.data();
+      blocks = arena.NumBlocks();
+    }
+    EXPECT_EQ(big.data(), first_run);
+    EXPECT_EQ(arena.NumBlocks(), blocks);
+  }
+  EXPECT_EQ(std::count(persistent.begin(), persistent.end(), 42), 16);
+
+  arena.Release();
+  EXPECT_EQ(arena.Capacity(), 0U);
+}
+
+namespace {
+
+class PreparedTask : public Task<std::vector<int>, int> {
+ public:
+  explicit PreparedTask(std::vector<int> in) {
+    GetInput() = std::move(in);
+  }
+  int setup_calls = 0;
+
+ protected:
+  bool SetupImpl() override {
+    setup_calls++;
+    prefix_ = GetScratch().Allocate<int>(GetInput().size());
+    std::partial_sum(GetInput().begin(), GetInput().end(), prefix_.begin());
+    return true;
+  }
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    work_ = GetScratch().AllocateFilled<int>(GetInput().size(), 0);
+    return true;
+  }
+  bool RunImpl() override {
+    std::ranges::copy(prefix_, work_.begin());
+    GetOutput() = work_.back();
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+
+ private:
+  std::span<int> prefix_;
+  std::span<int> work_;
+};
+
+void RunPipeline(Task<std::vector<int>, int> &task) {
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+}
+
+}  // namespace
+
+TEST(TaskTest, SetupRunsOnceAndRepeatedRunsDoNotAllocate) {
+  PreparedTask task(std::vector<int>(1000, 1));
+  EXPECT_FALSE(task.IsPrepared());
+  RunPipeline(task);
+  EXPECT_TRUE(task.IsPrepared());
+  const auto capacity = task.GetScratch().Capacity();
+
+  for (int run = 0; run < 5; run++) {
+    RunPipeline(task);
+    EXPECT_EQ(task.GetOutput(), 1000);
+  }
+  EXPECT_EQ(task.setup_calls, 1);
+  EXPECT_EQ(task.GetScratch().Capacity(), capacity);
+}
+
+TEST(TaskTest, ResetPreparationRunsSetupAgain) {
+  PreparedTask task(std::vector<int>(10, 1));
+  RunPipeline(task);
+  task.GetInput() = std::vector<int>(20, 2);
+  task.ResetPreparation();
+  RunPipeline(task);
+  EXPECT_EQ(task.setup_calls, 2);
+  EXPECT_EQ(task.GetOutput(), 40);
+}
+
+namespace {
+
+std::atomic<int> batch_setup_calls{0};
+std::atomic<int> batch_prepared_elsewhere{0};
+
+class BatchSumTask : public Task<std::vector<int>, int> {
+ public:
+  explicit BatchSumTask(std::vector<int> in) {
+    GetInput() = std::move(in);
+  }
+ protected:
+  bool SetupImpl() override {
+    batch_setup_calls++;
+    return true;
+  }
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    prepared_on_ = std::this_thread::get_id();
+    return true;
+  }
+  bool RunImpl() override {
+    if (prepared_on_ != std::this_thread::get_id()) {
+      batch_prepared_elsewhere++;
+    }
+    GetOutput() = std::accumulate(GetInput().begin(), GetInput().end(), 0);
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+
+ private:
+  std::thread::id prepared_on_;
+};
+
+std::vector<std::vector<int>> MakeBatchInputs(int count) {
+  std::vector<std::vector<int>> inputs;
+  for (int i = 0; i < count; i++) {
+    inputs.emplace_back(8, i);
+  }
+  return inputs;
+}
+
+}  // namespace
+
+TEST(BatchRunnerTest, ReturnsOutputsInInputOrder) {
+  for (std::size_t depth : {0U, 1U, 4U}) {
+    ppc::task::BatchRunner<BatchSumTask> runner({.pipeline_depth = depth});
+    const auto outputs = runner.Run(MakeBatchInputs(50));
+    ASSERT_EQ(outputs.size(), 50U);
+    for (int i = 0; i < 50; i++) {
+      EXPECT_EQ(outputs[i], 8 * i);
+    }
+    EXPECT_EQ(runner.GetStats().inputs, 50U);
+    EXPECT_EQ(runner.GetStats().failed, 0U);
+    EXPECT_EQ(runner.GetStats().tasks_created, 50U);
+    EXPECT_GT(runner.GetStats().InputsPerSecond(), 0.0);
+  }
+}
+
+TEST(BatchRunnerTest, PipelinePreparesOnHelperThread) {
+  batch_prepared_elsewhere = 0;
+  ppc::task::BatchRunner<BatchSumTask> sequential({.pipeline_depth = 0, .reuse_tasks = true});
+  const auto expected = sequential.Run(MakeBatchInputs(20));
+  EXPECT_EQ(batch_prepared_elsewhere, 0);
+
+  ppc::task::BatchRunner<BatchSumTask> pipelined({.pipeline_depth = 2, .reuse_tasks = true});
+  EXPECT_EQ(pipelined.Run(MakeBatchInputs(20)), expected);
+  EXPECT_EQ(batch_prepared_elsewhere, 20);
+  EXPECT_LE(pipelined.GetStats().tasks_created, 4U);
+}
+
+TEST(BatchRunnerTest, ReusedTasksRunSetupOnce) {
+  batch_setup_calls = 0;
+  ppc::task::BatchRunner<BatchSumTask> runner({.pipeline_depth = 0, .reuse_tasks = true});
+  const auto outputs = runner.Run(MakeBatchInputs(30));
+  EXPECT_EQ(outputs.back(), 8 * 29);
+  EXPECT_EQ(runner.GetStats().tasks_created, 1U);
+  EXPECT_EQ(batch_setup_calls, 1);
+}
+
+TEST(BatchRunnerTest, CountsFailedInputs) {
+  auto inputs = MakeBatchInputs(5);
+  inputs[2].clear();
+  ppc::task::BatchRunner<BatchSumTask> runner;
+  const auto outputs = runner.Run(std::move(inputs));
+  EXPECT_EQ(outputs.size(), 5U);
+  EXPECT_EQ(outputs[4], 32);
+  EXPECT_EQ(runner.GetStats().failed, 1U);
+}
+
+namespace {
+
+class BatchMpiSumTask : public BatchSumTask {
+ public:
+  using BatchSumTask::BatchSumTask;
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kMPI;
+  }
+};
+
+}  // namespace
+
+TEST(BatchRunnerTest, RunsMpiTasksWithoutPipeline) {
+  ppc::task::BatchRunner<BatchMpiSumTask> runner;
+  const auto outputs = runner.Run(MakeBatchInputs(10));
+  EXPECT_EQ(outputs.back(), 8 * 9);
+  EXPECT_THROW(ppc::task::BatchRunner<BatchMpiSumTask>({.pipeline_depth = 1}), std::invalid_argument);
+}
+
+namespace {
+
+class RendezvousTask : public Task<int, int> {
+ public:
+  RendezvousTask(int in, std::atomic<int> &arrived) : arrived_(arrived) {
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    // Succeeds only if the other task runs at the same time
+    arrived_++;
+    if (GetInput() < 0) {
+      throw std::runtime_error("rendezvous failed");
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (arrived_.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    GetOutput() = ppc::util::GetNumThreads();
+    return arrived_.load() >= 2;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+
+ private:
+  std::atomic<int> &arrived_;
+};
+
+ppc::task::AsyncJob<bool> RunSideBySide(std::shared_ptr<RendezvousTask> first,
+                                        std::shared_ptr<RendezvousTask> second) {
+  const bool ok = co_await ppc::task::WhenAll(ppc::task::Await(std::move(first), {.num_threads = 3}),
+                                              ppc::task::Await(std::move(second), {.num_threads = 5}));
+  co_return ok;
+}
+
+ppc::task::AsyncJob<int> SumInSequence(std::vector<std::shared_ptr<BatchSumTask>> tasks) {
+  int sum = 0;
+  for (auto &task : tasks) {
+    if (co_await ppc::task::Await(task)) {
+      sum += task->GetOutput();
+    }
+  }
+  co_return sum;
+}
+
+ppc::task::AsyncJob<int> SumAndLinger(std::shared_ptr<BatchSumTask> task) {
+  // Destroyed after co_return and before the parameters, widening the window in which a result published too
+  // early would let Get() return while the frame still owns the task
+  const std::shared_ptr<void> linger(nullptr, [](void * /*unused*/) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  });
+  co_return co_await ppc::task::Await(task) ? task->GetOutput() : 0;
+}
+
+}  // namespace
+
+TEST(AsyncTest, RunAsyncOverlapsIndependentTasks) {
+  std::atomic<int> arrived{0};
+  auto first = std::make_shared<RendezvousTask>(1, arrived);
+  auto second = std::make_shared<RendezvousTask>(2, arrived);
+  auto first_done = ppc::task::RunAsync(first);
+  auto second_done = ppc::task::RunAsync(second);
+  EXPECT_TRUE(first_done.get());
+  EXPECT_TRUE(second_done.get());
+}
+
+TEST(AsyncTest, WhenAllPartitionsThreads) {
+  std::atomic<int> arrived{0};
+  auto first = std::make_shared<RendezvousTask>(1, arrived);
+  auto second = std::make_shared<RendezvousTask>(2, arrived);
+  EXPECT_TRUE(RunSideBySide(first, second).Get());
+  EXPECT_EQ(first->GetOutput(), 3);
+  EXPECT_EQ(second->GetOutput(), 5);
+}
+
+TEST(AsyncTest, CoroutineComposesPipelines) {
+  std::vector<std::shared_ptr<BatchSumTask>> tasks;
+  for (int i = 1; i <= 4; i++) {
+    tasks.push_back(std::make_shared<BatchSumTask>(std::vector<int>(3, i)));
+  }
+  EXPECT_EQ(SumInSequence(tasks).Get(), 30);
+}
+
+TEST(AsyncTest, CoroutineReleasesParametersBeforeResult) {
+  auto task = std::make_shared<BatchSumTask>(std::vector<int>(3, 2));
+  EXPECT_EQ(SumAndLinger(task).Get(), 6);
+  // The coroutine frame held a copy of the pointer and finished on a pipeline thread
+  EXPECT_EQ(task.use_count(), 1);
+}
+
+TEST(AsyncTest, JobRethrowsTaskException) {
+  std::atomic<int> arrived{0};
+  auto failing = std::make_shared<RendezvousTask>(-1, arrived);
+  auto other = std::make_shared<RendezvousTask>(1, arrived);
+  auto job = RunSideBySide(failing, other);
+  EXPECT_THROW(job.Get(), std::runtime_error);
+  failing.reset();
+  ppc::util::DestructorFailureFlag::Unset();
+}
+
 int main(int argc, char **argv) {
   return ppc::runners::SimpleInit(argc, argv);
 }
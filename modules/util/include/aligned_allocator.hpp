@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Alignment of every buffer handed out by AllocateBuffer(), one cache line.
+inline constexpr std::size_t kCacheLineSize = 64;
+/// @brief Size of a huge page on x86-64 and most AArch64 kernels; buffers of this size or more are mapped directly.
+inline constexpr std::size_t kHugePageSize = std::size_t{2} * 1024 * 1024;
+
+/// @brief How large buffers are backed by huge pages.
+enum class HugePagePolicy : uint8_t {
+  /// @brief Regular pages only.
+  kNone,
+  /// @brief Transparent huge pages requested with madvise(MADV_HUGEPAGE); the kernel may ignore the hint.
+  kTransparent,
+  /// @brief Pages from the hugetlbfs pool (MAP_HUGETLB); falls back to transparent huge pages when the pool is empty.
+  kExplicit,
+};
+
+/// @brief Reads PPC_HUGE_PAGES ("none", "transparent" or "explicit"); default "transparent".
+HugePagePolicy GetHugePagePolicy();
+std::string ToString(HugePagePolicy policy);
+
+/// @brief Counters of the buffers allocated through AllocateBuffer() since the last ResetAllocationStats().
+struct AllocationStats {
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes_allocated = 0;
+  /// @brief Bytes currently allocated, including buffers allocated before the last reset.
+  std::uint64_t bytes_in_use = 0;
+  /// @brief Largest value of bytes_in_use.
+  std::uint64_t peak_bytes = 0;
+  /// @brief Bytes of the allocations that were backed by huge pages.
+  std::uint64_t huge_page_bytes = 0;
+};
+
+AllocationStats GetAllocationStats();
+/// @brief Zeroes the counters; the peak restarts from the bytes currently in use.
+void ResetAllocationStats();
+
+/// @brief Allocates `bytes` aligned to kCacheLineSize.
+/// @details Buffers of kHugePageSize bytes or more are mapped from the operating system, aligned to a huge page and
+/// backed by huge pages according to PPC_HUGE_PAGES. Their pages are then placed on the NUMA nodes according to
+/// PPC_NUMA_PLACEMENT, see PlaceBuffer(), with GetNumThreads() threads.
+/// @throws std::bad_alloc If the memory cannot be obtained.
+void *AllocateBuffer(std::size_t bytes);
+/// @brief Frees a buffer of AllocateBuffer(); `bytes` must match the allocation.
+void DeallocateBuffer(void *ptr, std::size_t bytes) noexcept;
+
+/// @brief Standard allocator on top of AllocateBuffer(), for containers that hold task data.
+template <typename T>
+class AlignedAllocator {
+ public:
+  using value_type = T;  // NOLINT(readability-identifier-naming)
+
+  static_assert(alignof(T) <= kCacheLineSize, "Element alignment exceeds the cache line");
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U> & /*other*/) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  T *allocate(std::size_t count) {  // NOLINT(readability-identifier-naming)
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(AllocateBuffer(count * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t count) noexcept {  // NOLINT(readability-identifier-naming)
+    DeallocateBuffer(ptr, count * sizeof(T));
+  }
+
+  template <typename U>
+  friend bool operator==(const AlignedAllocator & /*lhs*/, const AlignedAllocator<U> & /*rhs*/) noexcept {
+    return true;
+  }
+};
+
+/// @brief Vector whose data is cache-line aligned and huge-page backed when large; a drop-in for std::vector in
+/// input and output types.
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+}  // namespace ppc::util
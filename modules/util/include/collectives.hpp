@@ -0,0 +1,212 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "util/include/distribution.hpp"
+#include "util/include/reduction.hpp"
+
+namespace ppc::util {
+
+/// @brief Messages up to this size are broadcast along a binomial tree.
+inline constexpr std::size_t kBinomialBroadcastMaxBytes = std::size_t{12} << 10;
+/// @brief Messages up to this size are broadcast by a scatter followed by a ring allgather; larger ones are
+/// pipelined along a chain.
+inline constexpr std::size_t kScatterAllgatherBroadcastMaxBytes = std::size_t{512} << 10;
+/// @brief Messages up to this size are reduced along a binomial tree; larger ones are pipelined along a chain.
+inline constexpr std::size_t kBinomialReduceMaxBytes = std::size_t{512} << 10;
+/// @brief Messages up to this size are allreduced by recursive doubling.
+inline constexpr std::size_t kRecursiveDoublingMaxBytes = std::size_t{2} << 10;
+/// @brief From this size on the ring replaces Rabenseifner's algorithm when the number of ranks is not a power of two.
+inline constexpr std::size_t kRingAllreduceMinBytes = std::size_t{1} << 20;
+/// @brief Size of the segments the pipelined algorithms forward.
+inline constexpr std::size_t kPipelineSegmentBytes = std::size_t{64} << 10;
+
+enum class BroadcastAlgorithm : uint8_t {
+  /// @brief Chosen by SelectBroadcastAlgorithm().
+  kAuto,
+  /// @brief ceil(log2 p) rounds of whole messages; best for short messages.
+  kBinomial,
+  /// @brief Binomial scatter of p blocks, then a ring allgather (van de Geijn); about 2x the message per rank.
+  kScatterAllgather,
+  /// @brief Segments flow along the ranks as a chain; bandwidth optimal for long messages.
+  kPipelinedChain,
+  /// @brief Between one leader per node first, then inside every node.
+  kHierarchical,
+};
+
+enum class ReduceAlgorithm : uint8_t {
+  /// @brief Chosen by SelectReduceAlgorithm().
+  kAuto,
+  kBinomial,
+  kPipelinedChain,
+};
+
+enum class AllreduceAlgorithm : uint8_t {
+  /// @brief Chosen by SelectAllreduceAlgorithm().
+  kAuto,
+  /// @brief log2 p exchanges of the whole message; best for short messages.
+  kRecursiveDoubling,
+  /// @brief Reduce-scatter by recursive halving, then allgather by recursive doubling.
+  kRabenseifner,
+  /// @brief Ring reduce-scatter and ring allgather: 2(p-1) steps of 1/p of the message.
+  kRing,
+  /// @brief Reduce inside every node, allreduce between the node leaders, broadcast inside every node.
+  kHierarchical,
+};
+
+std::string_view GetAlgorithmName(BroadcastAlgorithm algorithm);
+std::string_view GetAlgorithmName(ReduceAlgorithm algorithm);
+std::string_view GetAlgorithmName(AllreduceAlgorithm algorithm);
+
+/// @brief Algorithm used by kAuto for `count` elements of `bytes` bytes in total on `size` ranks spread over
+/// `nodes` nodes.
+/// @details Hierarchical variants are chosen when the ranks span several nodes and share at least one of them.
+BroadcastAlgorithm SelectBroadcastAlgorithm(std::size_t count, std::size_t bytes, int size, int nodes = 1);
+ReduceAlgorithm SelectReduceAlgorithm(std::size_t count, std::size_t bytes, int size);
+AllreduceAlgorithm SelectAllreduceAlgorithm(std::size_t count, std::size_t bytes, int size, int nodes = 1);
+
+/// @brief MPI_Bcast built from point-to-point messages.
+/// @details Collective over `comm`; all ranks must pass the same count and algorithm. The messages travel on a
+/// private duplicate of `comm` (created on first use and cached with its node and leader communicators), so they
+/// never match receives of the caller. `type` must be contiguous.
+/// @throws std::invalid_argument If the count is negative or the root is not a rank of `comm`.
+void Broadcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm,
+               BroadcastAlgorithm algorithm = BroadcastAlgorithm::kAuto);
+
+/// @brief MPI_Reduce built from point-to-point messages.
+/// @details `sendbuf` may be MPI_IN_PLACE on the root. Predefined operations on predefined types run compiled
+/// kernels (see PredefinedReduction()), others go through MPI_Reduce_local. Long messages are received in segments,
+/// each combined while the next one arrives. Non-commutative operations fall back to MPI_Reduce, the algorithms here
+/// combine contributions out of rank order.
+void Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm,
+            ReduceAlgorithm algorithm = ReduceAlgorithm::kAuto);
+
+/// @brief MPI_Allreduce built from point-to-point messages; `sendbuf` may be MPI_IN_PLACE.
+/// @details Non-commutative operations fall back to MPI_Allreduce.
+void Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+               AllreduceAlgorithm algorithm = AllreduceAlgorithm::kAuto);
+
+namespace detail {
+
+/// Reduce() and Allreduce() with a type-erased elementwise reduction, which must be commutative.
+void Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, const Reduction &reduction, int root,
+            MPI_Comm comm, ReduceAlgorithm algorithm);
+void Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, const Reduction &reduction,
+               MPI_Comm comm, AllreduceAlgorithm algorithm);
+
+/// Datatype of T for the duration of a call: the predefined one for arithmetic types, sizeof(T) contiguous bytes
+/// for other trivially copyable types.
+template <typename T>
+class ElementType {
+ public:
+  ElementType() {
+    if constexpr (std::is_arithmetic_v<T>) {
+      type_ = MpiDatatype<T>();
+    } else {
+      MPI_Type_contiguous(static_cast<int>(sizeof(T)), MPI_BYTE, &type_);
+      MPI_Type_commit(&type_);
+    }
+  }
+  ElementType(const ElementType &) = delete;
+  ElementType &operator=(const ElementType &) = delete;
+  ElementType(ElementType &&) = delete;
+  ElementType &operator=(ElementType &&) = delete;
+  ~ElementType() {
+    if constexpr (!std::is_arithmetic_v<T>) {
+      MPI_Type_free(&type_);
+    }
+  }
+
+  [[nodiscard]] MPI_Datatype Get() const {
+    return type_;
+  }
+
+ private:
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+};
+
+inline int CollectiveCount(std::size_t size) {
+  if (size > static_cast<std::size_t>(INT_MAX)) {
+    throw std::invalid_argument("Collective buffer exceeds the MPI count range");
+  }
+  return static_cast<int>(size);
+}
+
+}  // namespace detail
+
+template <typename Buffer>
+concept CollectiveBuffer = std::ranges::contiguous_range<Buffer> && std::ranges::sized_range<Buffer>;
+
+/// @brief A predefined MPI operation for arithmetic T, or an operator such as Sum, Min or a lambda T(T, T).
+template <typename Op, typename T>
+concept ReductionArgument =
+    (std::convertible_to<Op, MPI_Op> && std::is_arithmetic_v<T>) || ReductionOperator<Op, T>;
+
+/// @brief Broadcasts the root's `buffer`; every rank must pass a buffer of the same size.
+template <typename Buffer>
+  requires CollectiveBuffer<Buffer>
+void Broadcast(Buffer &&buffer, int root = 0, MPI_Comm comm = MPI_COMM_WORLD,
+               BroadcastAlgorithm algorithm = BroadcastAlgorithm::kAuto) {
+  using T = std::ranges::range_value_t<Buffer>;
+  Broadcast(std::ranges::data(buffer), detail::CollectiveCount(std::ranges::size(buffer)), MpiDatatype<T>(), root,
+            comm, algorithm);
+}
+
+/// @brief Reduces `send` of all ranks into `recv` on the root; `recv` may be empty elsewhere.
+/// @details Operators other than MPI_Op are compiled into the kernel for T, which may be any trivially copyable type.
+/// They must be associative and commutative.
+/// @throws std::invalid_argument If `recv` on the root is not as long as `send`.
+template <typename Send, typename Recv, typename Op>
+  requires CollectiveBuffer<Send> && CollectiveBuffer<Recv> &&
+           std::is_same_v<std::ranges::range_value_t<Send>, std::ranges::range_value_t<Recv>> &&
+           ReductionArgument<Op, std::ranges::range_value_t<Send>>
+void Reduce(const Send &send, Recv &&recv, const Op &op, int root = 0, MPI_Comm comm = MPI_COMM_WORLD,
+            ReduceAlgorithm algorithm = ReduceAlgorithm::kAuto) {
+  using T = std::ranges::range_value_t<Send>;
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == root && std::ranges::size(recv) != std::ranges::size(send)) {
+    throw std::invalid_argument("Reduce result buffer does not match the input size");
+  }
+  const int count = detail::CollectiveCount(std::ranges::size(send));
+  if constexpr (std::convertible_to<Op, MPI_Op>) {
+    Reduce(std::ranges::data(send), std::ranges::data(recv), count, MpiDatatype<T>(), op, root, comm, algorithm);
+  } else {
+    const detail::ElementType<T> type;
+    detail::Reduce(std::ranges::data(send), std::ranges::data(recv), count, type.Get(), MakeReduction<T>(op), root,
+                   comm, algorithm);
+  }
+}
+
+/// @brief Reduces `send` of all ranks into `recv` on every rank.
+/// @throws std::invalid_argument If `recv` is not as long as `send`.
+template <typename Send, typename Recv, typename Op>
+  requires CollectiveBuffer<Send> && CollectiveBuffer<Recv> &&
+           std::is_same_v<std::ranges::range_value_t<Send>, std::ranges::range_value_t<Recv>> &&
+           ReductionArgument<Op, std::ranges::range_value_t<Send>>
+void Allreduce(const Send &send, Recv &&recv, const Op &op, MPI_Comm comm = MPI_COMM_WORLD,
+               AllreduceAlgorithm algorithm = AllreduceAlgorithm::kAuto) {
+  using T = std::ranges::range_value_t<Send>;
+  if (std::ranges::size(recv) != std::ranges::size(send)) {
+    throw std::invalid_argument("Allreduce result buffer does not match the input size");
+  }
+  const int count = detail::CollectiveCount(std::ranges::size(send));
+  if constexpr (std::convertible_to<Op, MPI_Op>) {
+    Allreduce(std::ranges::data(send), std::ranges::data(recv), count, MpiDatatype<T>(), op, comm, algorithm);
+  } else {
+    const detail::ElementType<T> type;
+    detail::Allreduce(std::ranges::data(send), std::ranges::data(recv), count, type.Get(), MakeReduction<T>(op),
+                      comm, algorithm);
+  }
+}
+
+}  // namespace ppc::util
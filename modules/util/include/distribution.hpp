@@ -0,0 +1,242 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Half-open range [begin, end) of global indices.
+struct IndexRange {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+
+  [[nodiscard]] std::size_t Size() const {
+    return end - begin;
+  }
+  bool operator==(const IndexRange &) const = default;
+};
+
+/// @brief Splits `total` items into `parts` contiguous blocks whose sizes differ by at most one.
+/// @details Part i owns [Offset(i), Offset(i) + Count(i)); the first total % parts parts hold the extra items.
+class BlockDistribution {
+ public:
+  BlockDistribution(std::size_t total, int parts);
+
+  [[nodiscard]] std::size_t Total() const {
+    return total_;
+  }
+  [[nodiscard]] int Parts() const {
+    return parts_;
+  }
+  [[nodiscard]] std::size_t Count(int part) const;
+  [[nodiscard]] std::size_t Offset(int part) const;
+  [[nodiscard]] IndexRange Range(int part) const;
+  /// @brief Part that owns the global index.
+  [[nodiscard]] int Owner(std::size_t index) const;
+  /// @brief Counts of all parts as MPI counts, each multiplied by `unit` (e.g. the row length of row stripes).
+  [[nodiscard]] std::vector<int> Counts(std::size_t unit = 1) const;
+  /// @brief Offsets of all parts as MPI displacements, each multiplied by `unit`.
+  [[nodiscard]] std::vector<int> Displacements(std::size_t unit = 1) const;
+
+ private:
+  std::size_t total_;
+  int parts_;
+  std::size_t base_;
+  std::size_t remainder_;
+};
+
+/// @brief Deals blocks of `block` consecutive items to the parts in turn: block b belongs to part b % parts.
+/// @details A part stores its items in global order, so local index l of part p is global index
+/// GlobalIndex(p, l). The last block may be shorter.
+class BlockCyclicDistribution {
+ public:
+  BlockCyclicDistribution(std::size_t total, int parts, std::size_t block);
+
+  [[nodiscard]] std::size_t Total() const {
+    return total_;
+  }
+  [[nodiscard]] int Parts() const {
+    return parts_;
+  }
+  [[nodiscard]] std::size_t Block() const {
+    return block_;
+  }
+  [[nodiscard]] std::size_t Count(int part) const;
+  [[nodiscard]] int Owner(std::size_t index) const;
+  [[nodiscard]] std::size_t LocalIndex(std::size_t index) const;
+  [[nodiscard]] std::size_t GlobalIndex(int part, std::size_t local_index) const;
+  /// @brief Global ranges owned by the part, in local order.
+  [[nodiscard]] std::vector<IndexRange> Ranges(int part) const;
+
+ private:
+  std::size_t total_;
+  int parts_;
+  std::size_t block_;
+};
+
+/// @brief How MatrixDistribution splits a matrix.
+enum class MatrixLayout : uint8_t {
+  /// @brief Stripes of whole rows.
+  kRows,
+  /// @brief Stripes of whole columns.
+  kColumns,
+  /// @brief A grid of GridRows() x GridCols() rectangular tiles, as square as the number of parts allows.
+  kTiles,
+};
+
+/// @brief Splits a row-major rows x cols matrix among parts; part p holds a row-major LocalRows(p) x LocalCols(p)
+/// block.
+/// @details Tiles are numbered row by row over the process grid; grid rows and columns are block distributed.
+class MatrixDistribution {
+ public:
+  MatrixDistribution(std::size_t rows, std::size_t cols, int parts, MatrixLayout layout);
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+  [[nodiscard]] int Parts() const {
+    return grid_rows_ * grid_cols_;
+  }
+  [[nodiscard]] MatrixLayout Layout() const {
+    return layout_;
+  }
+  [[nodiscard]] int GridRows() const {
+    return grid_rows_;
+  }
+  [[nodiscard]] int GridCols() const {
+    return grid_cols_;
+  }
+  [[nodiscard]] IndexRange RowRange(int part) const;
+  [[nodiscard]] IndexRange ColRange(int part) const;
+  [[nodiscard]] std::size_t LocalRows(int part) const;
+  [[nodiscard]] std::size_t LocalCols(int part) const;
+  [[nodiscard]] std::size_t LocalSize(int part) const;
+  [[nodiscard]] int Owner(std::size_t row, std::size_t col) const;
+
+ private:
+  std::size_t rows_;
+  std::size_t cols_;
+  MatrixLayout layout_;
+  int grid_rows_;
+  int grid_cols_;
+  BlockDistribution row_blocks_;
+  BlockDistribution col_blocks_;
+};
+
+/// @brief MPI datatype of an arithmetic type.
+template <typename T>
+MPI_Datatype MpiDatatype() {
+  using U = std::remove_cv_t<T>;
+  static_assert(std::is_arithmetic_v<U>, "Only arithmetic types have a predefined MPI datatype");
+  if constexpr (std::is_same_v<U, bool>) {
+    return MPI_CXX_BOOL;
+  } else if constexpr (std::is_same_v<U, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_same_v<U, signed char>) {
+    return MPI_SIGNED_CHAR;
+  } else if constexpr (std::is_same_v<U, unsigned char>) {
+    return MPI_UNSIGNED_CHAR;
+  } else if constexpr (std::is_same_v<U, short>) {
+    return MPI_SHORT;
+  } else if constexpr (std::is_same_v<U, unsigned short>) {
+    return MPI_UNSIGNED_SHORT;
+  } else if constexpr (std::is_same_v<U, int>) {
+    return MPI_INT;
+  } else if constexpr (std::is_same_v<U, unsigned>) {
+    return MPI_UNSIGNED;
+  } else if constexpr (std::is_same_v<U, long>) {
+    return MPI_LONG;
+  } else if constexpr (std::is_same_v<U, unsigned long>) {
+    return MPI_UNSIGNED_LONG;
+  } else if constexpr (std::is_same_v<U, long long>) {
+    return MPI_LONG_LONG;
+  } else if constexpr (std::is_same_v<U, unsigned long long>) {
+    return MPI_UNSIGNED_LONG_LONG;
+  } else if constexpr (std::is_same_v<U, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<U, double>) {
+    return MPI_DOUBLE;
+  } else {
+    static_assert(std::is_same_v<U, long double>, "Unsupported arithmetic type");
+    return MPI_LONG_DOUBLE;
+  }
+}
+
+namespace detail {
+
+/// Type-erased collectives: `global` is only read (scatter) or written (gather) on the root, buffer sizes are
+/// counted in elements of `type`.
+void Scatter(const BlockDistribution &dist, const void *global, std::size_t global_size, void *local,
+             std::size_t local_size, MPI_Datatype type, int root, MPI_Comm comm);
+void Gather(const BlockDistribution &dist, const void *local, std::size_t local_size, void *global,
+            std::size_t global_size, MPI_Datatype type, int root, MPI_Comm comm);
+void Allgather(const BlockDistribution &dist, const void *local, std::size_t local_size, void *global,
+               std::size_t global_size, MPI_Datatype type, MPI_Comm comm);
+
+void Scatter(const BlockCyclicDistribution &dist, const void *global, std::size_t global_size, void *local,
+             std::size_t local_size, MPI_Datatype type, int root, MPI_Comm comm);
+void Gather(const BlockCyclicDistribution &dist, const void *local, std::size_t local_size, void *global,
+            std::size_t global_size, MPI_Datatype type, int root, MPI_Comm comm);
+void Allgather(const BlockCyclicDistribution &dist, const void *local, std::size_t local_size, void *global,
+               std::size_t global_size, MPI_Datatype type, MPI_Comm comm);
+
+void Scatter(const MatrixDistribution &dist, const void *global, std::size_t global_size, void *local,
+             std::size_t local_size, MPI_Datatype type, int root, MPI_Comm comm);
+void Gather(const MatrixDistribution &dist, const void *local, std::size_t local_size, void *global,
+            std::size_t global_size, MPI_Datatype type, int root, MPI_Comm comm);
+void Allgather(const MatrixDistribution &dist, const void *local, std::size_t local_size, void *global,
+               std::size_t global_size, MPI_Datatype type, MPI_Comm comm);
+
+}  // namespace detail
+
+template <typename Global, typename Local>
+concept DistributableBuffers =
+    std::ranges::contiguous_range<Global> && std::ranges::contiguous_range<Local> &&
+    std::ranges::sized_range<Global> && std::ranges::sized_range<Local> &&
+    std::is_same_v<std::ranges::range_value_t<Global>, std::ranges::range_value_t<Local>>;
+
+/// @brief Distributes the root's `global` data: every rank receives its part into `local`.
+/// @details One collective call: MPI_Scatterv for contiguous parts, derived datatypes for column stripes, tiles and
+/// block-cyclic parts, so the root neither packs the data nor loops over the ranks. `global` is only read on the
+/// root and may be empty elsewhere. `local` must hold exactly the part of the calling rank.
+/// @throws std::invalid_argument If the distribution does not match the communicator or a buffer size. Buffer sizes
+/// are checked on every rank before the data moves, and a wrong size on any rank throws on all of them, so no rank
+/// is left waiting in the collective. The same holds for Gather() and Allgather().
+template <typename Distribution, typename Global, typename Local>
+  requires DistributableBuffers<Global, Local>
+void Scatter(const Distribution &dist, const Global &global, Local &&local, int root = 0,
+             MPI_Comm comm = MPI_COMM_WORLD) {
+  using T = std::ranges::range_value_t<Local>;
+  detail::Scatter(dist, std::ranges::data(global), std::ranges::size(global), std::ranges::data(local),
+                  std::ranges::size(local), MpiDatatype<T>(), root, comm);
+}
+
+/// @brief Collects the parts of all ranks into `global` on the root, the inverse of Scatter().
+/// @details `global` is only written on the root and may be empty elsewhere.
+template <typename Distribution, typename Local, typename Global>
+  requires DistributableBuffers<Global, Local>
+void Gather(const Distribution &dist, const Local &local, Global &&global, int root = 0,
+            MPI_Comm comm = MPI_COMM_WORLD) {
+  using T = std::ranges::range_value_t<Local>;
+  detail::Gather(dist, std::ranges::data(local), std::ranges::size(local), std::ranges::data(global),
+                 std::ranges::size(global), MpiDatatype<T>(), root, comm);
+}
+
+/// @brief Collects the parts of all ranks into `global` on every rank, in place of a gather and a broadcast.
+template <typename Distribution, typename Local, typename Global>
+  requires DistributableBuffers<Global, Local>
+void Allgather(const Distribution &dist, const Local &local, Global &&global, MPI_Comm comm = MPI_COMM_WORLD) {
+  using T = std::ranges::range_value_t<Local>;
+  detail::Allgather(dist, std::ranges::data(local), std::ranges::size(local), std::ranges::data(global),
+                    std::ranges::size(global), MpiDatatype<T>(), comm);
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include "util/include/collectives.hpp"
+#include "util/include/distribution.hpp"
+
+namespace ppc::util {
+
+/// @brief Ghost items a block of a 1D decomposition keeps in front of and behind its own items.
+struct HaloWidth {
+  std::size_t before = 0;
+  std::size_t after = 0;
+};
+
+/// @brief Which neighbours of a tile a 2D exchange reaches.
+enum class HaloShape : uint8_t {
+  /// @brief The four tiles sharing an edge; enough for 5-point stencils.
+  kFaces,
+  /// @brief The eight tiles sharing an edge or a corner; needed by 3x3 kernels.
+  kFacesAndCorners,
+};
+
+/// @brief Side of a block whose ghost region a neighbour fills.
+enum class HaloSide : uint8_t {
+  /// @brief Lower indices: the previous block of a 1D decomposition, the rows above a tile.
+  kBefore,
+  /// @brief Higher indices: the next block of a 1D decomposition, the rows below a tile.
+  kAfter,
+  /// @brief Columns left of a tile.
+  kLeft,
+  /// @brief Columns right of a tile.
+  kRight,
+};
+
+/// @brief Exchanges the ghost regions of a block decomposition with persistent point-to-point requests.
+/// @details The local buffer holds the owned items surrounded by ghost regions:
+/// - 1D (BlockDistribution): `width.before` ghost items, the Count(rank) owned items, `width.after` ghost items. An
+///   item is `unit` consecutive elements, e.g. a row of a row stripe.
+/// - 2D (MatrixDistribution): a row-major (LocalRows + 2 width) x (LocalCols + 2 width) block whose inner
+///   LocalRows x LocalCols elements are owned.
+///
+/// The requests are bound to the buffer once, in the constructor; every exchange then only starts and completes
+/// them. Start() lets the caller compute everything that does not read ghosts while the messages are in flight;
+/// owned items next to a ghost region must not be written and ghosts must not be read until Finish() returns.
+/// Blocks without items take no part, and ghost regions at the edges of the decomposition are never written. The
+/// messages travel on a private duplicate of the communicator.
+class HaloExchange {
+ public:
+  /// @brief Collective over `comm`; `buffer` must hold PaddedSize() elements and must not move while this object
+  /// lives.
+  /// @throws std::invalid_argument If the distribution does not match the communicator or the buffer, or a block
+  /// next to a neighbour owns fewer items than the ghost region it fills.
+  HaloExchange(const BlockDistribution &dist, HaloWidth width, std::size_t unit, void *buffer, std::size_t size,
+               MPI_Datatype type, MPI_Comm comm);
+  HaloExchange(const MatrixDistribution &dist, std::size_t width, HaloShape shape, void *buffer, std::size_t size,
+               MPI_Datatype type, MPI_Comm comm);
+
+  template <typename Buffer>
+    requires CollectiveBuffer<Buffer>
+  HaloExchange(const BlockDistribution &dist, HaloWidth width, Buffer &buffer, MPI_Comm comm = MPI_COMM_WORLD,
+               std::size_t unit = 1)
+      : HaloExchange(dist, width, unit, std::ranges::data(buffer), std::ranges::size(buffer),
+                     detail::ElementType<std::ranges::range_value_t<Buffer>>().Get(), comm) {}
+
+  template <typename Buffer>
+    requires CollectiveBuffer<Buffer>
+  HaloExchange(const MatrixDistribution &dist, std::size_t width, HaloShape shape, Buffer &buffer,
+               MPI_Comm comm = MPI_COMM_WORLD)
+      : HaloExchange(dist, width, shape, std::ranges::data(buffer), std::ranges::size(buffer),
+                     detail::ElementType<std::ranges::range_value_t<Buffer>>().Get(), comm) {}
+
+  HaloExchange(const HaloExchange &) = delete;
+  HaloExchange &operator=(const HaloExchange &) = delete;
+  HaloExchange(HaloExchange &&) = delete;
+  HaloExchange &operator=(HaloExchange &&) = delete;
+  /// @brief Completes an exchange still in flight.
+  ~HaloExchange();
+
+  /// @brief Elements of the local buffer of `part`, ghost regions included.
+  static std::size_t PaddedSize(const BlockDistribution &dist, int part, HaloWidth width, std::size_t unit = 1);
+  static std::size_t PaddedSize(const MatrixDistribution &dist, int part, std::size_t width);
+
+  /// @brief Starts sending the owned boundary and receiving the ghost regions.
+  /// @throws std::logic_error If an exchange is already in flight.
+  void Start();
+  /// @brief Lets MPI advance the exchange during long computations; true once it is complete.
+  bool Progress();
+  /// @brief Waits until the ghost regions are filled and the owned boundary may be written again.
+  void Finish();
+  /// @brief Start() and Finish() without overlap.
+  void Exchange();
+
+  [[nodiscard]] bool InFlight() const {
+    return in_flight_;
+  }
+  /// @brief Whether a neighbour fills the ghost region on `side`; if not, the region keeps its contents.
+  [[nodiscard]] bool HasNeighbour(HaloSide side) const;
+  /// @brief Whether a neighbour fills the ghost region on `side` of `part`; never for a part without items.
+  [[nodiscard]] static bool HasNeighbour(const BlockDistribution &dist, int part, HaloSide side);
+  [[nodiscard]] static bool HasNeighbour(const MatrixDistribution &dist, int part, HaloSide side);
+
+ private:
+  /// Derived datatypes built for the exchange.
+  class Types {
+   public:
+    Types() = default;
+    Types(const Types &) = delete;
+    Types &operator=(const Types &) = delete;
+    Types(Types &&) = delete;
+    Types &operator=(Types &&) = delete;
+    ~Types();
+
+    MPI_Datatype Add(MPI_Datatype type);
+
+   private:
+    std::vector<MPI_Datatype> types_;
+  };
+
+  /// Part of the local buffer: `count` elements of `type` starting `offset` elements into it.
+  struct Region {
+    std::size_t offset = 0;
+    int count = 0;
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+  };
+
+  void Link(int neighbour, int send_tag, int receive_tag, Region send, Region receive);
+
+  std::byte *buffer_ = nullptr;
+  MPI_Aint extent_ = 0;
+  MPI_Comm comm_ = MPI_COMM_NULL;
+  Types types_;
+  std::vector<MPI_Request> requests_;
+  std::uint8_t sides_ = 0;
+  bool in_flight_ = false;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "util/include/collectives.hpp"
+#include "util/include/distribution.hpp"
+
+namespace ppc::util {
+
+namespace detail {
+
+/// @brief Ranks among `candidates` whose blocks `rank` receives: sorted, without duplicates, without `rank` itself
+/// and without ranks whose blocks are empty.
+/// @throws std::invalid_argument If a candidate is not a part of the distribution.
+std::vector<int> SourcesWithBlocks(const BlockDistribution &dist, int rank, std::span<const int> candidates);
+
+}  // namespace detail
+
+/// @brief Per-iteration communication of an iterative solver whose iterate is distributed in blocks.
+/// @details Every rank holds the whole iterate in `vector` and computes its own block of it, Range(rank) of the
+/// distribution. An iteration then needs the blocks of the other ranks and a global convergence measure. Both are
+/// set up once, in the constructor, and every iteration only restarts them:
+/// - the blocks travel through persistent point-to-point requests to every rank;
+/// - with `sources`, a rank only receives the blocks of the listed ranks. A distributed graph communicator works out
+///   which ranks read the own block, and every iteration issues one MPI_Ineighbor_allgatherv over it. MPI 3.1 has
+///   no persistent neighbourhood collectives, so only the graph and the arguments are reused;
+/// - the residual passed to Start() is reduced by an MPI_Iallreduce that is in flight together with the blocks.
+///
+/// So an iteration waits once, in Finish(), instead of exchanging the iterate and then reducing and broadcasting
+/// the convergence test. All ranks get the same reduced residual and therefore stop at the same iteration.
+class IterationExchange {
+ public:
+  /// @brief Collective over `comm`; `vector` must hold Total() elements and must not move while this object lives.
+  /// @param residual_op Combines the residuals of all ranks, e.g. MPI_SUM of squared differences or MPI_MAX.
+  /// @throws std::invalid_argument If the distribution does not match the communicator or the vector.
+  IterationExchange(const BlockDistribution &dist, void *vector, std::size_t size, MPI_Datatype type, MPI_Comm comm,
+                    MPI_Op residual_op = MPI_SUM);
+  /// @brief Exchange with the ranks whose blocks this rank reads; `sources` may name any rank, the calling one and
+  /// ranks with empty blocks are skipped.
+  IterationExchange(const BlockDistribution &dist, std::span<const int> sources, void *vector, std::size_t size,
+                    MPI_Datatype type, MPI_Comm comm, MPI_Op residual_op = MPI_SUM);
+
+  template <typename Buffer>
+    requires CollectiveBuffer<Buffer>
+  IterationExchange(const BlockDistribution &dist, Buffer &vector, MPI_Comm comm = MPI_COMM_WORLD,
+                    MPI_Op residual_op = MPI_SUM)
+      : IterationExchange(dist, std::ranges::data(vector), std::ranges::size(vector),
+                          MpiDatatype<std::ranges::range_value_t<Buffer>>(), comm, residual_op) {}
+
+  template <typename Buffer>
+    requires CollectiveBuffer<Buffer>
+  IterationExchange(const BlockDistribution &dist, std::span<const int> sources, Buffer &vector,
+                    MPI_Comm comm = MPI_COMM_WORLD, MPI_Op residual_op = MPI_SUM)
+      : IterationExchange(dist, sources, std::ranges::data(vector), std::ranges::size(vector),
+                          MpiDatatype<std::ranges::range_value_t<Buffer>>(), comm, residual_op) {}
+
+  IterationExchange(const IterationExchange &) = delete;
+  IterationExchange &operator=(const IterationExchange &) = delete;
+  IterationExchange(IterationExchange &&) = delete;
+  IterationExchange &operator=(IterationExchange &&) = delete;
+  /// @brief Completes an iteration still in flight.
+  ~IterationExchange();
+
+  /// @brief Starts sending the own block and reducing `local_residual`.
+  /// @details The own block must not be written and the other blocks must not be read until Finish() returns.
+  /// @throws std::logic_error If the previous iteration has not finished.
+  void Start(double local_residual);
+  /// @brief Waits for the blocks and returns the residual reduced over all ranks.
+  double Finish();
+  /// @brief Start() and Finish() without overlap.
+  double Exchange(double local_residual);
+
+  [[nodiscard]] bool InFlight() const {
+    return in_flight_;
+  }
+  /// @brief Ranks whose blocks this rank receives.
+  [[nodiscard]] const std::vector<int> &Sources() const {
+    return sources_;
+  }
+
+ private:
+  /// Binds the exchange of the blocks with `sources_` and `destinations` to `vector`.
+  void SetUp(const BlockDistribution &dist, int rank, const std::vector<int> &destinations, void *vector);
+  /// Prepares the neighbourhood collective that exchanges the blocks over the graph communicator `comm_`.
+  void SetUpNeighbours(const BlockDistribution &dist, int rank, void *vector);
+
+  MPI_Comm comm_ = MPI_COMM_NULL;
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+  std::vector<int> sources_;
+  /// The residual reduction first, then the exchange of the blocks.
+  std::vector<MPI_Request> requests_;
+  /// Arguments of the MPI_Ineighbor_allgatherv of an exchange with `sources`, counts and displacements in the order
+  /// of `sources_`.
+  bool neighbour_collective_ = false;
+  void *vector_ = nullptr;
+  std::byte *own_block_ = nullptr;
+  int own_count_ = 0;
+  std::vector<int> counts_;
+  std::vector<int> displacements_;
+  MPI_Op residual_op_ = MPI_SUM;
+  double local_residual_ = 0.0;
+  double residual_ = 0.0;
+  bool in_flight_ = false;
+};
+
+}  // namespace ppc::util
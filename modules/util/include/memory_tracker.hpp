@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::util {
+
+/// @brief Heap usage of the process as counted by the global operator new/delete replacements.
+/// @details Counting is opt-in through PPC_HEAP_TRACKING=1, read once at the first allocation; otherwise the
+/// replacements forward to malloc and free and every counter stays at zero. Sizes are the usable sizes of the
+/// blocks, so they include allocator rounding. Buffers mapped by AllocateBuffer() are counted as well. All threads
+/// contribute to the same counters.
+struct HeapUsage {
+  std::uint64_t allocations = 0;
+  /// @brief Bytes allocated since process start; never decreases.
+  std::uint64_t bytes_allocated = 0;
+  std::uint64_t bytes_in_use = 0;
+  /// @brief Largest value of bytes_in_use since process start.
+  std::uint64_t peak_bytes = 0;
+};
+
+/// @brief Returns false if the counters stay at zero: PPC_HEAP_TRACKING is not set, or the build runs under
+/// AddressSanitizer or Valgrind, which replace the allocation functions themselves.
+bool IsHeapTrackingEnabled();
+
+HeapUsage GetHeapUsage();
+
+/// @brief Counts memory obtained outside of operator new, such as mapped buffers.
+void RecordHeapAllocation(std::size_t bytes);
+void RecordHeapDeallocation(std::size_t bytes);
+
+/// @brief Peak resident set size of the process since start, in bytes; 0 if unknown.
+std::uint64_t GetPeakRss();
+
+/// @brief Measures the heap bytes allocated and the peak heap usage between construction and the query.
+/// @details Every scope keeps its own peak, so scopes may nest and overlap on any threads without disturbing each
+/// other; they all measure the usage of the whole process, including the allocations of other threads. Does
+/// nothing and reports zero while heap tracking is disabled. At most 64 scopes track a peak at once; a scope
+/// opened beyond that still counts the allocated bytes but reports a zero peak, see GetHeapScopeOverflows().
+class HeapScope {
+ public:
+  HeapScope();
+  HeapScope(const HeapScope &) = delete;
+  HeapScope &operator=(const HeapScope &) = delete;
+  HeapScope(HeapScope &&) = delete;
+  HeapScope &operator=(HeapScope &&) = delete;
+  ~HeapScope();
+
+  [[nodiscard]] std::uint64_t AllocatedBytes() const;
+  /// @brief Largest number of heap bytes in use at any point since construction.
+  [[nodiscard]] std::uint64_t PeakBytes() const;
+  /// @brief False if heap tracking is disabled or too many scopes were active, so PeakBytes() reports zero.
+  [[nodiscard]] bool TracksPeak() const;
+
+ private:
+  std::uint64_t start_allocated_ = 0;
+  /// Index of the peak counter owned by this scope, -1 while tracking is disabled or every slot is taken.
+  int slot_ = -1;
+};
+
+/// @brief Number of heap scopes that opened while 64 others were active and so report no peak.
+std::uint64_t GetHeapScopeOverflows();
+
+}  // namespace ppc::util
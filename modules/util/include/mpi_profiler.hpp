@@ -0,0 +1,29 @@
+#pragma once
+
+#include "performance/include/comm_profile.hpp"
+
+namespace ppc::util {
+
+/// @brief Cumulative wall time in seconds the calling process has spent inside blocking MPI calls.
+/// @details Measured through the MPI profiling interface: MPI calls made anywhere in the process are wrapped and
+/// forwarded to their PMPI counterparts. Blocking point-to-point, wait and collective calls add their duration here;
+/// posting nonblocking operations, starting persistent requests and MPI_Test* polling only show up in the profile.
+/// While tracing is enabled (see tracing.hpp) each wrapped call is also recorded as a span. The wrappers are built
+/// as the separate ppc_mpi_profiler object library. Only ppc_perf_tests and core_func_tests, which tests the
+/// profiler, link it, so ppc_func_tests and core_mpi_tests call MPI directly. Always 0 on Windows, where the
+/// wrappers are not built.
+double GetMPIBlockedTime();
+
+/// @brief Whether GetMPIBlockedTime() measures anything; false where the wrappers are not built.
+bool MeasuresMPIBlockedTime();
+
+/// @brief Starts or pauses recording of per-operation and per-call-site MPI traffic of the calling process.
+/// @details Only takes effect under PPC_PERF_MPI_PROFILE=1, which keeps the bookkeeping out of ordinary runs.
+void SetMPIProfiling(bool enabled);
+
+/// @brief Returns the traffic recorded since the previous collection and clears it.
+/// @details Collective over MPI_COMM_WORLD: operation totals are summed over all processes, call sites
+/// are reported for rank 0 only.
+ppc::performance::CommProfile CollectMPIProfile();
+
+}  // namespace ppc::util
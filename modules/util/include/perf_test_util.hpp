@@ -3,25 +3,95 @@
 #include <gtest/gtest.h>
 #include <omp.h>
 
+#include <array>
+#include <charconv>
 #include <chrono>
 #include <csignal>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "performance/include/baseline_store.hpp"
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_footprint.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/rank_timings.hpp"
+#include "performance/include/regression.hpp"
+#include "performance/include/results_sink.hpp"
 #include "task/include/task.hpp"
+#include "util/include/aligned_allocator.hpp"
+#include "util/include/mpi_profiler.hpp"
+#include "util/include/topology.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
 
 double GetTimeMPI();
 int GetMPIRank();
+int GetMPISize();
+/// @brief Makes every process follow rank 0's adaptive-mode decision.
+bool SyncPerfDecision(bool keep_running);
+/// @brief Sums hardware counter totals over all processes; a counter stays valid only if valid everywhere.
+void ReducePerfCounters(ppc::performance::CounterTotals &counters);
+/// @brief Gathers per-iteration samples and MPI blocked time of every process.
+ppc::performance::RankTimings GatherRankTimings(const std::vector<double> &samples, double mpi_time);
+/// @brief Gathers the memory use of every process, indexed by rank.
+std::vector<ppc::performance::RankMemory> GatherRankMemory(const ppc::performance::RankMemory &memory);
+
+/// @brief Best-effort problem size of a task input for perf reports.
+/// @details Sized ranges report their length, positive integers their value, and tuple-like inputs the summed
+/// length of their sized-range members. Anything else reports 0 (unknown).
+template <typename T>
+std::size_t DeduceInputSize(const T &input) {
+  if constexpr (std::ranges::sized_range<T>) {
+    return static_cast<std::size_t>(std::ranges::size(input));
+  } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+    return input > 0 ? static_cast<std::size_t>(input) : 0;
+  } else if constexpr (requires { std::tuple_size<T>::value; }) {
+    return std::apply([](const auto &...members) {
+      std::size_t total = 0;
+      ((total += std::ranges::sized_range<std::decay_t<decltype(members)>> ? DeduceInputSize(members) : 0), ...);
+      return total;
+    }, input);
+  } else {
+    return 0;
+  }
+}
+
+/// @brief Test-name suffix tagging a perf case with its problem size, e.g. "_size1000".
+inline std::string PerfSizeSuffix(std::size_t size) {
+  return "_size" + std::to_string(size);
+}
+
+/// @brief Extracts the problem size from a perf test name tagged with PerfSizeSuffix().
+/// @return The tagged size, or std::nullopt if the name carries no valid size tag.
+inline std::optional<std::size_t> GetPerfSizeFromName(std::string_view test_name) {
+  constexpr std::string_view kSizeTag = "_size";
+  const auto pos = test_name.rfind(kSizeTag);
+  if (pos == std::string_view::npos) {
+    return std::nullopt;
+  }
+  const auto digits = test_name.substr(pos + kSizeTag.size());
+  std::size_t size = 0;
+  const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), size);
+  if (ec != std::errc() || end != digits.data() + digits.size() || size == 0) {
+    return std::nullopt;
+  }
+  return size;
+}
 
 template <typename InType, typename OutType>
 using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
@@ -45,11 +115,35 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   /// @brief Supplies input data for performance testing.
   virtual InType GetTestInputData() = 0;
 
+  /// @brief Problem size recorded in structured perf results; override if the input has no natural size.
+  virtual std::size_t GetTestInputSize(const InType &input) {
+    return DeduceInputSize(input);
+  }
+
+  /// @brief Problem size of the current case when the suite is instantiated with a size ladder.
+  /// @param default_size Returned for cases without a size tag.
+  [[nodiscard]] std::size_t GetPerfTestSize(std::size_t default_size) const {
+    const auto &test_name = std::get<static_cast<std::size_t>(GTestParamIndex::kNameTest)>(this->GetParam());
+    return GetPerfSizeFromName(test_name).value_or(default_size);
+  }
+
   virtual void SetPerfAttributes(ppc::performance::PerfAttr &perf_attrs) {
     if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
         task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
       const double t0 = GetTimeMPI();
       perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
+      perf_attrs.sync_decision = SyncPerfDecision;
+      perf_attrs.reduce_counters = ReducePerfCounters;
+      perf_attrs.blocked_time = GetMPIBlockedTime;
+      perf_attrs.gather_ranks = [](const std::vector<double> &samples, double mpi_time) {
+        auto timings = GatherRankTimings(samples, mpi_time);
+        timings.mpi_measured = MeasuresMPIBlockedTime();
+        return timings;
+      };
+      perf_attrs.gather_memory = GatherRankMemory;
+      perf_attrs.comm_profile = GetPerfMpiProfile();
+      perf_attrs.record_comm = SetMPIProfiling;
+      perf_attrs.collect_comm = CollectMPIProfile;
     } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kOMP) {
       const double t0 = omp_get_wtime();
       perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
@@ -57,7 +151,7 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSTL ||
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kTBB) {
       const auto t0 = std::chrono::high_resolution_clock::now();
-      perf_attrs.current_timer = [&] {
+      perf_attrs.current_timer = [t0] {
         auto now = std::chrono::high_resolution_clock::now();
         auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
         return static_cast<double>(ns) * 1e-9;
@@ -65,6 +159,10 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     } else {
       throw std::runtime_error("The task type is not supported for performance testing.");
     }
+    perf_attrs.num_warmup = static_cast<uint64_t>(GetPerfWarmupRuns());
+    perf_attrs.adaptive = GetPerfAdaptive();
+    perf_attrs.target_rse = GetPerfTargetRse();
+    perf_attrs.hw_counters = GetPerfHardwareCounters();
   }
 
   void ExecuteTest(const PerfTestParam<InType, OutType> &perf_test_param) {
@@ -79,7 +177,11 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
     const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
 
-    task_ = task_getter(GetTestInputData());
+    // Buffer statistics cover the input data and every measured run
+    ResetAllocationStats();
+    auto input = GetTestInputData();
+    task_ = task_getter(std::move(input));
+    const auto input_size = GetPerfSizeFromName(test_name).value_or(GetTestInputSize(task_->GetInput()));
     ppc::performance::Perf perf(task_);
     ppc::performance::PerfAttr perf_attr;
     SetPerfAttributes(perf_attr);
@@ -95,7 +197,10 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     }
 
     if (GetMPIRank() == 0) {
+      const auto record = MakePerfRecord(perf.GetPerfResults(), test_name, input_size);
+      WritePerfRecord(record);
       perf.PrintPerfStatistic(test_name);
+      CheckPerfBaseline(record);
     }
 
     OutType output_data = task_->GetOutput();
@@ -103,13 +208,73 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   }
 
  private:
+  ppc::performance::PerfRecord MakePerfRecord(const ppc::performance::PerfResults &results,
+                                              const std::string &test_name, std::size_t input_size) {
+    ppc::performance::PerfRecord record;
+    record.task_id = test_name;
+    record.technology = ppc::task::TypeOfTaskToString(task_->GetDynamicTypeOfTask());
+    record.mode = ppc::performance::GetStringParamName(results.type_of_running);
+    record.num_proc = GetMPISize();
+    record.num_threads = GetNumThreads();
+    record.input_size = input_size;
+    record.problem_scale = GetPerfProblemScale();
+    record.placement = {.affinity = ToString(GetThreadAffinity()),
+                        .numa = ToString(GetNumaPlacement()),
+                        .sockets = GetCpuTopology().NumSockets(),
+                        .numa_nodes = GetCpuTopology().NumNumaNodes()};
+    const auto buffers = GetAllocationStats();
+    record.buffers = {.huge_pages = ToString(GetHugePagePolicy()),
+                      .allocations = buffers.allocations,
+                      .bytes = buffers.bytes_allocated,
+                      .peak_bytes = buffers.peak_bytes,
+                      .huge_page_bytes = buffers.huge_page_bytes};
+    record.results = results;
+    return record;
+  }
+
+  static void WritePerfRecord(const ppc::performance::PerfRecord &record) {
+    const auto results_file = GetPerfResultsFile();
+    if (!results_file.empty()) {
+      ppc::performance::AppendPerfRecord(results_file, record);
+    }
+  }
+
+  /// @brief Stores the record as a baseline or compares it against the stored one (PPC_PERF_BASELINE_DIR).
+  /// @details A statistically significant slowdown above PPC_PERF_REGRESSION_THRESHOLD fails the test.
+  static void CheckPerfBaseline(const ppc::performance::PerfRecord &record) {
+    const auto baseline_dir = GetPerfBaselineDir();
+    if (baseline_dir.empty()) {
+      return;
+    }
+    const auto prefix = record.task_id + ":" + record.mode + ":baseline:";
+    if (GetPerfBaselineUpdate()) {
+      ppc::performance::SaveBaseline(baseline_dir, record);
+      std::cout << prefix << "updated" << '\n';
+      return;
+    }
+    const auto baseline = ppc::performance::LoadBaseline(baseline_dir, ppc::performance::GetBaselineKey(record));
+    if (!baseline.has_value()) {
+      std::cout << prefix << "missing" << '\n';
+      return;
+    }
+    const double threshold = GetPerfRegressionThreshold();
+    const auto result = ppc::performance::CompareToBaseline(*baseline, record.results.time_samples, threshold);
+    const char *verdict = result.regression ? "regression" : (result.improvement ? "improvement" : "ok");
+    std::stringstream comparison;
+    comparison << std::fixed << std::setprecision(4) << "median_ratio=" << result.median_ratio
+               << ",p_value=" << result.p_value << ",verdict=" << verdict;
+    std::cout << prefix << comparison.str() << '\n';
+    EXPECT_FALSE(result.regression) << record.task_id << " (" << record.mode << ") is slower than its baseline: "
+                                    << comparison.str();
+  }
+
   ppc::task::TaskPtr<InType, OutType> task_;
 };
 
 template <typename TaskType, typename InputType>
-auto MakePerfTaskTuples(const std::string &settings_path) {
+auto MakePerfTaskTuples(const std::string &settings_path, const std::string &name_suffix = {}) {
   const auto name = std::string(GetNamespace<TaskType>()) + "_" +
-                    ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
+                    ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path) + name_suffix;
 
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
                                          ppc::performance::PerfResults::TypeOfRunning::kPipeline),
@@ -133,4 +298,19 @@ auto MakeAllPerfTasks(const std::string &settings_path) {
   return std::tuple_cat(MakePerfTaskTuples<TaskTypes, InputType>(settings_path)...);
 }
 
+template <typename TaskType, typename InputType, std::size_t N, std::size_t... I>
+auto MakeSizedPerfTaskTuplesImpl(const std::string &settings_path, const std::array<std::size_t, N> &sizes,
+                                 std::index_sequence<I...> /*unused*/) {
+  return std::tuple_cat(MakePerfTaskTuples<TaskType, InputType>(settings_path, PerfSizeSuffix(sizes[I]))...);
+}
+
+/// @brief Builds perf cases of every task for every problem size of a ladder.
+/// @details Each size becomes its own measured case tagged with PerfSizeSuffix(); fixtures read the size of
+/// the current case with BaseRunPerfTests::GetPerfTestSize().
+template <typename InputType, typename... TaskTypes, std::size_t N>
+auto MakeAllPerfTasks(const std::string &settings_path, const std::array<std::size_t, N> &sizes) {
+  return std::tuple_cat(MakeSizedPerfTaskTuplesImpl<TaskTypes, InputType>(settings_path, sizes,
+                                                                          std::make_index_sequence<N>{})...);
+}
+
 }  // namespace ppc::util
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace ppc::util {
+
+/// @brief Elementwise operators of the reductions; any other callable T(T, T) can be used as well.
+using Sum = std::plus<>;
+using Prod = std::multiplies<>;
+using BitAnd = std::bit_and<>;
+using BitOr = std::bit_or<>;
+using BitXor = std::bit_xor<>;
+
+struct Min {
+  template <typename T>
+  constexpr T operator()(const T &lhs, const T &rhs) const {
+    return rhs < lhs ? rhs : lhs;
+  }
+};
+
+struct Max {
+  template <typename T>
+  constexpr T operator()(const T &lhs, const T &rhs) const {
+    return lhs < rhs ? rhs : lhs;
+  }
+};
+
+template <typename Op, typename T>
+concept ReductionOperator = std::is_trivially_copyable_v<T> && std::invocable<const Op &, const T &, const T &> &&
+                            std::convertible_to<std::invoke_result_t<const Op &, const T &, const T &>, T>;
+
+/// @brief Sets inout[i] = op(in[i], inout[i]), the argument order of MPI_Reduce_local.
+/// @details Instantiated per element type and operator, so the operator is inlined and the loop vectorized.
+/// `in` and `inout` must not overlap.
+template <typename T, typename Op>
+  requires ReductionOperator<Op, T>
+void CombineElements(const T *in, T *inout, std::size_t count, const Op &op) {
+#pragma omp simd
+  for (std::size_t i = 0; i < count; i++) {
+    inout[i] = op(in[i], inout[i]);
+  }
+}
+
+/// @brief Type-erased elementwise reduction used by the collectives of collectives.hpp.
+/// @details The operator must be associative and commutative: the collectives combine contributions in the order
+/// they arrive, not in rank order.
+struct Reduction {
+  /// @brief Applies the operator to `count` elements as CombineElements() does.
+  void (*combine)(const void *in, void *inout, std::size_t count, const void *state) = nullptr;
+  /// @brief Operator object passed to `combine`; must outlive the collective call.
+  const void *state = nullptr;
+
+  void operator()(const void *in, void *inout, std::size_t count) const {
+    combine(in, inout, count, state);
+  }
+};
+
+/// @brief Reduction applying `op` to elements of type T; `op` is referenced, not copied.
+template <typename T, typename Op>
+  requires ReductionOperator<Op, T>
+Reduction MakeReduction(const Op &op) {
+  return {.combine =
+              [](const void *in, void *inout, std::size_t count, const void *state) {
+                CombineElements(static_cast<const T *>(in), static_cast<T *>(inout), count,
+                                *static_cast<const Op *>(state));
+              },
+          .state = &op};
+}
+
+/// @brief Compiled reduction for a predefined operation and datatype.
+/// @details Covers MPI_SUM, MPI_PROD, MPI_MIN, MPI_MAX over the integer and floating point types and MPI_BAND,
+/// MPI_BOR, MPI_BXOR over the integer types. Returns a reduction with a null `combine` for other pairs, which the
+/// collectives then apply through MPI_Reduce_local.
+Reduction PredefinedReduction(MPI_Op op, MPI_Datatype type);
+
+}  // namespace ppc::util
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Work-stealing thread pool whose workers live as long as the pool.
+/// @details Every worker owns a job deque: it takes its own jobs from the back and steals from the front of the
+/// other deques when it runs dry. Jobs submitted from a worker stay on that worker's deque, other threads spread
+/// their jobs round-robin. Threads that wait for pool work (ParallelFor(), Wait()) run pending jobs meanwhile, so
+/// nested parallel loops cannot deadlock.
+class ThreadPool {
+ public:
+  /// @brief Starts a pool with `num_threads` workers (at least one).
+  explicit ThreadPool(int num_threads);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+  /// @brief Runs the remaining jobs and joins the workers.
+  ~ThreadPool();
+
+  /// @brief Returns the framework pool shared by all tasks of the process.
+  /// @details Created on first use with GetNumThreads() workers and destroyed at process exit.
+  static ThreadPool &Global();
+  /// @brief Pauses the framework pool if Global() has created it; the OpenMP thread team is released either way.
+  /// @details Lets shutdown code park the workers without starting a pool that no task used.
+  static void PauseIfCreated();
+
+  [[nodiscard]] int NumThreads() const {
+    return static_cast<int>(threads_.size());
+  }
+
+  /// @brief Queues a callable and returns a future of its result.
+  template <typename F>
+  auto Submit(F &&func) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    auto job = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+    auto result = job->get_future();
+    Push([job] { (*job)(); });
+    return result;
+  }
+
+  /// @brief Calls `body(i)` for every i in [begin, end), split into `num_chunks` contiguous chunks.
+  /// @details The calling thread processes the first chunk and helps with pending jobs until the others are done.
+  /// The first exception thrown by `body` is rethrown after all chunks have finished. A paused pool runs the whole
+  /// range on the calling thread.
+  /// @param num_chunks Degree of parallelism; defaults to GetNumThreads() so that ScopedNumThreads applies.
+  template <typename Body>
+  void ParallelFor(int begin, int end, Body &&body, int num_chunks = 0);
+
+  /// @brief Runs pending jobs on the calling thread until `done()` returns true.
+  void Wait(const std::function<bool()> &done);
+
+  /// @brief Stops the workers from taking jobs and releases the OpenMP thread team.
+  /// @details Jobs submitted while paused are kept and run after Resume().
+  void Pause();
+  /// @brief Lets the workers take jobs again.
+  void Resume();
+  [[nodiscard]] bool IsPaused() const {
+    return paused_.load();
+  }
+
+ private:
+  using Job = std::function<void()>;
+
+  struct JobQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  static int DefaultChunks();
+  void Push(Job job);
+  bool TryRunOne(std::size_t first_queue);
+  void WorkerLoop(std::size_t index);
+
+  std::vector<std::unique_ptr<JobQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> pending_{0};
+  std::atomic<std::size_t> next_queue_{0};
+  std::atomic<bool> paused_{false};
+  bool stop_ = false;
+};
+
+template <typename Body>
+void ThreadPool::ParallelFor(int begin, int end, Body &&body, int num_chunks) {
+  const int count = end - begin;
+  if (count <= 0) {
+    return;
+  }
+  const int chunks = std::clamp(num_chunks > 0 ? num_chunks : DefaultChunks(), 1, count);
+  if (chunks == 1 || IsPaused()) {
+    for (int i = begin; i < end; i++) {
+      body(i);
+    }
+    return;
+  }
+
+  std::atomic<int> remaining(chunks);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto run_chunk = [&](int chunk) {
+    const int chunk_begin = begin + static_cast<int>(static_cast<long long>(count) * chunk / chunks);
+    const int chunk_end = begin + static_cast<int>(static_cast<long long>(count) * (chunk + 1) / chunks);
+    try {
+      for (int i = chunk_begin; i < chunk_end; i++) {
+        body(i);
+      }
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+  };
+
+  for (int chunk = 1; chunk < chunks; chunk++) {
+    Push([&run_chunk, chunk] { run_chunk(chunk); });
+  }
+  run_chunk(0);
+  Wait([&remaining] { return remaining.load(std::memory_order_acquire) == 0; });
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace ppc::util
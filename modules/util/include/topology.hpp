@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Hardware thread the process may run on.
+struct LogicalCpu {
+  int id = 0;
+  /// @brief Physical core, unique within the socket.
+  int core = 0;
+  int socket = 0;
+  int numa_node = 0;
+};
+
+/// @brief Cache reachable from the first CPU of the process.
+struct CacheInfo {
+  int level = 0;
+  /// @brief "Data", "Instruction" or "Unified".
+  std::string type;
+  std::size_t size_bytes = 0;
+  /// @brief Number of logical CPUs sharing the cache.
+  int shared_cpus = 1;
+};
+
+/// @brief Sockets, cores, NUMA nodes and caches of the machine, as read from sysfs.
+struct CpuTopology {
+  /// @brief CPUs ordered by id.
+  std::vector<LogicalCpu> cpus;
+  std::vector<CacheInfo> caches;
+
+  [[nodiscard]] int NumSockets() const;
+  [[nodiscard]] int NumCores() const;
+  [[nodiscard]] int NumNumaNodes() const;
+};
+
+/// @brief Reads the topology below a sysfs root such as "/sys/devices/system".
+/// @details Falls back to one socket with std::thread::hardware_concurrency() single-threaded cores when the
+/// tree is missing, e.g. on non-Linux systems.
+CpuTopology DiscoverTopology(const std::string &sysfs_root);
+
+/// @brief Returns the topology of this machine restricted to the CPUs the process may run on; read once.
+const CpuTopology &GetCpuTopology();
+
+/// @brief Order in which worker threads are bound to CPUs.
+enum class AffinityPolicy : uint8_t {
+  /// @brief Threads are not pinned.
+  kNone,
+  /// @brief Fill a core, then the next core of the same socket, then the next socket.
+  kCompact,
+  /// @brief Spread over sockets first, then over cores; hardware threads of a core are used last.
+  kScatter,
+};
+
+/// @brief Where the pages of large task buffers are placed on multi-socket machines.
+enum class NumaPlacement : uint8_t {
+  /// @brief Operating system default: first touch, usually by the main thread.
+  kNone,
+  /// @brief Pages are spread round-robin over all NUMA nodes.
+  kInterleave,
+  /// @brief Pages are first touched by the OpenMP threads in the static schedule of the compute loops.
+  kFirstTouch,
+};
+
+/// @brief Reads PPC_THREAD_AFFINITY ("none", "compact" or "scatter"); default "none".
+AffinityPolicy GetThreadAffinity();
+/// @brief Reads PPC_NUMA_PLACEMENT ("none", "interleave" or "first_touch"); default "none".
+NumaPlacement GetNumaPlacement();
+std::string ToString(AffinityPolicy policy);
+std::string ToString(NumaPlacement placement);
+
+/// @brief Returns the CPU for each of `num_threads` threads.
+/// @details CPUs are taken in policy order starting at `first_slot`, wrapping around when there are more threads
+/// than CPUs. Processes sharing a node pass disjoint slot ranges so that their threads do not overlap.
+std::vector<int> PlanThreadPlacement(const CpuTopology &topology, AffinityPolicy policy, int num_threads,
+                                     int first_slot = 0);
+
+/// @brief Sets the first slot used by PinWorkerThread(); set per process by the runners.
+void SetAffinitySlotOffset(int first_slot);
+
+/// @brief Binds the calling thread to one CPU.
+/// @return False if binding is unsupported or was refused.
+bool PinCurrentThread(int cpu);
+/// @brief Binds the calling thread to a set of CPUs.
+bool PinCurrentThread(const std::vector<int> &cpus);
+
+/// @brief Binds the calling thread to the CPUs of the first `num_threads` slots under PPC_THREAD_AFFINITY.
+/// @details Used for the main thread, so that threads it starts without pinning stay on the CPUs of the process.
+/// No-op for "none".
+void PinMainThread(int num_threads);
+
+/// @brief Binds the calling thread to the CPU of worker `index` under PPC_THREAD_AFFINITY; no-op for "none".
+void PinWorkerThread(int index);
+
+/// @brief Spreads the pages of a buffer over all NUMA nodes of the topology; existing pages are migrated.
+/// @details Only pages lying entirely inside the buffer are affected, so the buffer should be page-aligned, as
+/// AlignedVector buffers of kHugePageSize bytes or more are.
+/// @return False if the system does not support memory policies.
+bool InterleaveMemory(void *data, std::size_t bytes, const CpuTopology &topology);
+
+/// @brief Value-initializes a freshly allocated buffer from the OpenMP threads, in the same static schedule that
+/// `#pragma omp parallel for` loops over the buffer use, so every page lands on the node of the thread using it.
+template <typename T>
+void FirstTouchParallel(std::span<T> data, int num_threads) {
+  static_assert(std::is_trivially_copyable_v<T>, "First touch writes elements without running constructors");
+  const auto size = static_cast<std::int64_t>(data.size());
+  T *ptr = data.data();
+#pragma omp parallel for default(none) shared(ptr, size) schedule(static) num_threads(num_threads)
+  for (std::int64_t i = 0; i < size; i++) {
+    ptr[i] = T{};
+  }
+}
+
+/// @brief Applies PPC_NUMA_PLACEMENT to a freshly allocated buffer.
+/// @details "first_touch" also zero-initializes the buffer; the other policies leave the contents untouched.
+/// AllocateBuffer() applies it to every buffer it maps, so large AlignedVector data is already placed.
+template <typename T>
+void PlaceBuffer(std::span<T> data, int num_threads) {
+  switch (GetNumaPlacement()) {
+    case NumaPlacement::kInterleave:
+      InterleaveMemory(data.data(), data.size_bytes(), GetCpuTopology());
+      break;
+    case NumaPlacement::kFirstTouch:
+      FirstTouchParallel(data, num_threads);
+      break;
+    case NumaPlacement::kNone:
+      break;
+  }
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Number of events kept per thread; once a buffer is full the oldest events are overwritten.
+inline constexpr std::size_t kTraceBufferCapacity = std::size_t{1} << 15;
+
+/// @brief One completed span of a thread.
+struct TraceEvent {
+  /// @brief Must outlive the trace: a string literal or a name returned by InternTraceName().
+  const char *name = nullptr;
+  const char *category = nullptr;
+  /// @brief Steady clock timestamps of this process in nanoseconds, see TraceClock().
+  std::uint64_t begin_ns = 0;
+  std::uint64_t end_ns = 0;
+  /// @brief Payload of MPI calls; 0 if not applicable.
+  std::uint64_t bytes = 0;
+  /// @brief Index of the recording thread in the order the threads first recorded an event.
+  std::uint32_t thread = 0;
+};
+
+/// @brief Reads PPC_TRACE_FILE, the path of the Chrome trace written at the end of a run; empty if unset.
+std::string GetTraceFile();
+
+/// @brief Starts or stops recording of spans by all threads of the process.
+void SetTracing(bool enabled);
+bool IsTracingEnabled();
+
+/// @brief Current time of the trace clock (std::chrono::steady_clock) in nanoseconds.
+std::uint64_t TraceClock();
+
+/// @brief Returns a copy of `name` that stays valid until the process exits; equal names share one copy.
+const char *InternTraceName(std::string_view name);
+
+/// @brief Appends an event to the ring buffer of the calling thread.
+/// @details Lock-free: each thread owns its buffer and is its only writer. Recorded even when tracing is disabled.
+void RecordTraceEvent(const char *name, const char *category, std::uint64_t begin_ns, std::uint64_t end_ns,
+                      std::uint64_t bytes = 0);
+
+/// @brief Records the lifetime of the object as a span of the calling thread if tracing is enabled at construction.
+/// @details Costs one relaxed atomic load while tracing is disabled. `name` and `category` must outlive the trace.
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char *name, const char *category = "task");
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+  TraceSpan(TraceSpan &&) = delete;
+  TraceSpan &operator=(TraceSpan &&) = delete;
+  ~TraceSpan();
+
+ private:
+  const char *name_;
+  const char *category_;
+  std::uint64_t begin_ns_ = 0;
+};
+
+/// @brief Removes the recorded events of all threads of the process and returns them ordered by start time.
+/// @details Meant to be called while no other thread records; events written concurrently either stay for the next
+/// call or, if a buffer wraps around during the copy, may be torn.
+std::vector<TraceEvent> CollectTraceEvents();
+
+/// @brief Formats events as comma-separated Chrome trace event objects, preceded by process and thread names.
+/// @param pid Process id shown in the viewer, the MPI rank.
+/// @param origin_ns Trace clock value, in the clock of this process, that becomes timestamp 0.
+std::string FormatTraceEvents(const std::vector<TraceEvent> &events, int pid, std::int64_t origin_ns);
+
+/// @brief Collects the events of every process and writes them to `path` as Chrome trace JSON.
+/// @details The file opens in Perfetto and chrome://tracing. Collective over MPI_COMM_WORLD when MPI is initialized:
+/// the clocks of all ranks are aligned to rank 0 by ping-pong offset estimation, rank 0 writes the file and every
+/// rank appears as its own process. Without MPI only the calling process is written. The communication goes through
+/// PMPI and does not show up in the trace.
+void WriteTrace(const std::filesystem::path &path);
+
+}  // namespace ppc::util
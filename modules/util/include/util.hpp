@@ -4,6 +4,7 @@
 #include <array>
 #include <atomic>
 #include <cctype>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -64,13 +65,49 @@ class DestructorFailureFlag {
   inline static std::atomic<bool> failure_flag{false};
 };
 
+/// @brief Overrides GetNumThreads() for the calling thread while in scope.
+/// @details Lets tasks running concurrently on different threads split the available cores between them.
+/// A value of 0 or less leaves the current setting unchanged.
+class ScopedNumThreads {
+ public:
+  explicit ScopedNumThreads(int num_threads);
+  ScopedNumThreads(const ScopedNumThreads &) = delete;
+  ScopedNumThreads &operator=(const ScopedNumThreads &) = delete;
+  ScopedNumThreads(ScopedNumThreads &&) = delete;
+  ScopedNumThreads &operator=(ScopedNumThreads &&) = delete;
+  ~ScopedNumThreads();
+
+ private:
+  int previous_;
+};
+
 enum class GTestParamIndex : uint8_t { kTaskGetter, kNameTest, kTestParams };
 
 std::string GetAbsoluteTaskPath(const std::string &id_path, const std::string &relative_path);
 int GetNumThreads();
 int GetNumProc();
+std::string GetMpiThreadLevel();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
+int GetPerfWarmupRuns();
+bool GetPerfAdaptive();
+double GetPerfTargetRse();
+bool GetPerfHardwareCounters();
+bool GetPerfMpiProfile();
+std::string GetPerfResultsFile();
+double GetPerfProblemScale();
+std::string GetPerfBaselineDir();
+bool GetPerfBaselineUpdate();
+double GetPerfRegressionThreshold();
+
+/// @brief Scales a base perf problem size by PPC_PERF_PROBLEM_SCALE.
+/// @details Lets scaling sweeps grow the problem with the number of workers (weak scaling); the result is
+/// never smaller than 1.
+template <typename T>
+T ScalePerfSize(T base_size) {
+  const auto scaled = std::llround(static_cast<double>(base_size) * GetPerfProblemScale());
+  return static_cast<T>(std::max<long long>(scaled, 1));
+}
 
 template <typename T>
 std::string GetNamespace() {
@@ -0,0 +1,167 @@
+#include "util/include/aligned_allocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <libenvpp/detail/get.hpp>
+#include <new>
+#include <span>
+#include <string>
+
+#include "util/include/memory_tracker.hpp"
+#include "util/include/topology.hpp"
+#include "util/include/util.hpp"
+
+#ifdef __linux__
+#  include <sys/mman.h>
+#endif
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> bytes_allocated{0};
+std::atomic<std::uint64_t> bytes_in_use{0};
+std::atomic<std::uint64_t> peak_bytes{0};
+std::atomic<std::uint64_t> huge_page_bytes{0};
+
+void RecordAllocation(std::size_t bytes, bool huge_pages) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+  if (huge_pages) {
+    huge_page_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  const auto in_use = bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  auto peak = peak_bytes.load(std::memory_order_relaxed);
+  while (peak < in_use && !peak_bytes.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+  }
+}
+
+#ifdef __linux__
+constexpr std::size_t RoundToHugePage(std::size_t bytes) {
+  return (bytes + ppc::util::kHugePageSize - 1) & ~(ppc::util::kHugePageSize - 1);
+}
+
+/// Maps `length` bytes aligned to a huge page by over-mapping and trimming both ends.
+void *MapAligned(std::size_t length) {
+  const std::size_t padded = length + ppc::util::kHugePageSize;
+  void *raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto begin = reinterpret_cast<std::uintptr_t>(raw);
+  const auto aligned = (begin + ppc::util::kHugePageSize - 1) & ~(ppc::util::kHugePageSize - 1);
+  if (aligned > begin) {
+    munmap(raw, aligned - begin);
+  }
+  const std::size_t tail = begin + padded - (aligned + length);
+  if (tail > 0) {
+    munmap(reinterpret_cast<void *>(aligned + length), tail);
+  }
+  return reinterpret_cast<void *>(aligned);
+}
+
+void *MapLargeBuffer(std::size_t bytes, bool &huge_pages) {
+  const std::size_t length = RoundToHugePage(bytes);
+  const auto policy = ppc::util::GetHugePagePolicy();
+#  ifdef MAP_HUGETLB
+  if (policy == ppc::util::HugePagePolicy::kExplicit) {
+    void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+      huge_pages = true;
+      ppc::util::RecordHeapAllocation(length);
+      return ptr;
+    }
+  }
+#  endif
+  void *ptr = MapAligned(length);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  ppc::util::RecordHeapAllocation(length);
+#  ifdef MADV_HUGEPAGE
+  if (policy != ppc::util::HugePagePolicy::kNone) {
+    huge_pages = madvise(ptr, length, MADV_HUGEPAGE) == 0;
+  }
+#  endif
+  return ptr;
+}
+#endif
+
+}  // namespace
+
+namespace ppc::util {
+
+HugePagePolicy GetHugePagePolicy() {
+  const auto val = env::get<std::string>("PPC_HUGE_PAGES");
+  if (val.has_value()) {
+    if (*val == "none") {
+      return HugePagePolicy::kNone;
+    }
+    if (*val == "explicit") {
+      return HugePagePolicy::kExplicit;
+    }
+  }
+  return HugePagePolicy::kTransparent;
+}
+
+std::string ToString(HugePagePolicy policy) {
+  switch (policy) {
+    case HugePagePolicy::kNone:
+      return "none";
+    case HugePagePolicy::kExplicit:
+      return "explicit";
+    case HugePagePolicy::kTransparent:
+      break;
+  }
+  return "transparent";
+}
+
+AllocationStats GetAllocationStats() {
+  return {.allocations = allocations.load(),
+          .bytes_allocated = bytes_allocated.load(),
+          .bytes_in_use = bytes_in_use.load(),
+          .peak_bytes = peak_bytes.load(),
+          .huge_page_bytes = huge_page_bytes.load()};
+}
+
+void ResetAllocationStats() {
+  allocations = 0;
+  bytes_allocated = 0;
+  huge_page_bytes = 0;
+  peak_bytes = bytes_in_use.load();
+}
+
+void *AllocateBuffer(std::size_t bytes) {
+  bool huge_pages = false;
+  void *ptr = nullptr;
+#ifdef __linux__
+  if (bytes >= kHugePageSize) {
+    ptr = MapLargeBuffer(bytes, huge_pages);
+    // No page of a fresh mapping has been touched yet, so PPC_NUMA_PLACEMENT still decides where they all land
+    PlaceBuffer(std::span(static_cast<std::byte *>(ptr), RoundToHugePage(bytes)), GetNumThreads());
+  }
+#endif
+  if (ptr == nullptr) {
+    ptr = ::operator new(std::max<std::size_t>(bytes, 1), std::align_val_t{kCacheLineSize});
+  }
+  RecordAllocation(bytes, huge_pages);
+  return ptr;
+}
+
+void DeallocateBuffer(void *ptr, std::size_t bytes) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  bytes_in_use.fetch_sub(bytes, std::memory_order_relaxed);
+#ifdef __linux__
+  if (bytes >= kHugePageSize) {
+    munmap(ptr, RoundToHugePage(bytes));
+    RecordHeapDeallocation(RoundToHugePage(bytes));
+    return;
+  }
+#endif
+  ::operator delete(ptr, std::align_val_t{kCacheLineSize});
+}
+
+}  // namespace ppc::util
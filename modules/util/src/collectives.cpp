@@ -0,0 +1,824 @@
+#include "util/include/collectives.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "util/include/aligned_allocator.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/reduction.hpp"
+
+namespace {
+
+/// Tag of all messages; they travel on private communicators, where collectives are the only traffic.
+constexpr int kTag = 0;
+
+/// Private duplicate of a user communicator together with its split by shared-memory node.
+struct Context {
+  MPI_Comm comm = MPI_COMM_NULL;
+  /// Ranks of `comm` on the node of the calling rank.
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  /// One rank per node, the first of the node; MPI_COMM_NULL on the other ranks.
+  MPI_Comm leader_comm = MPI_COMM_NULL;
+  int nodes = 1;
+  /// Rank in `leader_comm` of the leader of the node of each rank of `comm`.
+  std::vector<int> node_of;
+  /// Rank in its `node_comm` of each rank of `comm`.
+  std::vector<int> local_rank_of;
+};
+
+int DeleteContext(MPI_Comm /*comm*/, int /*key*/, void *attribute, void * /*extra_state*/) {
+  std::unique_ptr<Context> context(static_cast<Context *>(attribute));
+  for (MPI_Comm *comm : {&context->leader_comm, &context->node_comm, &context->comm}) {
+    if (*comm != MPI_COMM_NULL) {
+      PMPI_Comm_free(comm);
+    }
+  }
+  return MPI_SUCCESS;
+}
+
+int ContextKey() {
+  static const int kKey = [] {
+    int key = MPI_KEYVAL_INVALID;
+    PMPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, DeleteContext, &key, nullptr);
+    return key;
+  }();
+  return kKey;
+}
+
+/// Context cached on `comm`; created collectively on first use and freed together with `comm`.
+const Context &GetContext(MPI_Comm comm) {
+  void *attribute = nullptr;
+  int found = 0;
+  PMPI_Comm_get_attr(comm, ContextKey(), &attribute, &found);
+  if (found != 0) {
+    return *static_cast<const Context *>(attribute);
+  }
+
+  auto context = std::make_unique<Context>();
+  PMPI_Comm_dup(comm, &context->comm);
+  PMPI_Comm_split_type(context->comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &context->node_comm);
+  int local_rank = 0;
+  PMPI_Comm_rank(context->node_comm, &local_rank);
+  PMPI_Comm_split(context->comm, local_rank == 0 ? 0 : MPI_UNDEFINED, 0, &context->leader_comm);
+  int node = 0;
+  if (context->leader_comm != MPI_COMM_NULL) {
+    PMPI_Comm_rank(context->leader_comm, &node);
+  }
+  PMPI_Bcast(&node, 1, MPI_INT, 0, context->node_comm);
+
+  int size = 0;
+  PMPI_Comm_size(context->comm, &size);
+  const std::array<int, 2> own{node, local_rank};
+  std::vector<int> all(static_cast<std::size_t>(size) * 2);
+  PMPI_Allgather(own.data(), 2, MPI_INT, all.data(), 2, MPI_INT, context->comm);
+  for (std::size_t i = 0; i < all.size(); i += 2) {
+    context->node_of.push_back(all[i]);
+    context->local_rank_of.push_back(all[i + 1]);
+  }
+  context->nodes = std::ranges::max(context->node_of) + 1;
+
+  PMPI_Comm_set_attr(comm, ContextKey(), context.get());
+  return *context.release();
+}
+
+int RankOf(MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  return rank;
+}
+
+int SizeOf(MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  return size;
+}
+
+std::size_t ExtentOf(MPI_Datatype type) {
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type, &lower_bound, &extent);
+  return static_cast<std::size_t>(extent);
+}
+
+/// Address of element `index` of a buffer of `type`.
+void *At(void *buffer, std::size_t index, MPI_Datatype type) {
+  return static_cast<std::byte *>(buffer) + (index * ExtentOf(type));
+}
+
+const void *At(const void *buffer, std::size_t index, MPI_Datatype type) {
+  return static_cast<const std::byte *>(buffer) + (index * ExtentOf(type));
+}
+
+std::size_t BytesOf(int count, MPI_Datatype type) {
+  return static_cast<std::size_t>(count) * ExtentOf(type);
+}
+
+/// Largest buffer kept for reuse; bigger ones are freed after the call that needed them.
+constexpr std::size_t kMaxPooledBytes = std::size_t{64} << 20;
+
+/// Scratch buffers of the calling thread, kept between collective calls so that repeated calls do not allocate.
+class ScratchPool {
+ public:
+  using Buffer = ppc::util::AlignedVector<std::byte>;
+
+  /// A buffer borrowed from the pool and given back on destruction.
+  class Lease {
+   public:
+    Lease(ScratchPool &pool, Buffer buffer) : pool_(&pool), buffer_(std::move(buffer)) {}
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+    Lease(Lease &&) = delete;
+    Lease &operator=(Lease &&) = delete;
+    ~Lease() {
+      pool_->Release(std::move(buffer_));
+    }
+
+    [[nodiscard]] std::byte *Data() {
+      return buffer_.data();
+    }
+
+   private:
+    ScratchPool *pool_;
+    Buffer buffer_;
+  };
+
+  /// Smallest free buffer of at least `bytes` bytes, or the largest one grown to that size.
+  Lease Acquire(std::size_t bytes) {
+    Buffer buffer;
+    auto fit = std::ranges::find_if(free_, [&](const Buffer &candidate) { return candidate.size() >= bytes; });
+    if (fit == free_.end() && !free_.empty()) {
+      fit = std::prev(free_.end());
+    }
+    if (fit != free_.end()) {
+      buffer = std::move(*fit);
+      free_.erase(fit);
+    }
+    if (buffer.size() < bytes) {
+      buffer.resize(bytes);
+    }
+    return {*this, std::move(buffer)};
+  }
+
+ private:
+  void Release(Buffer buffer) {
+    if (buffer.size() > kMaxPooledBytes) {
+      return;
+    }
+    // Kept sorted by size for Acquire()
+    auto position = std::ranges::find_if(free_, [&](const Buffer &other) { return other.size() > buffer.size(); });
+    free_.insert(position, std::move(buffer));
+  }
+
+  std::vector<Buffer> free_;
+};
+
+ScratchPool &LocalPool() {
+  thread_local ScratchPool pool;
+  return pool;
+}
+
+int LargestPowerOfTwo(int size) {
+  int power = 1;
+  while (power * 2 <= size) {
+    power *= 2;
+  }
+  return power;
+}
+
+/// Elements of the blocks [first, last) of `blocks`; `last` may pass the number of blocks.
+int BlockSpan(const ppc::util::BlockDistribution &blocks, int first, int last) {
+  const int parts = blocks.Parts();
+  return static_cast<int>(blocks.Offset(std::min(last, parts)) - blocks.Offset(std::min(first, parts)));
+}
+
+/// Ranks are numbered relative to the root, which becomes relative rank 0.
+struct RootedRanks {
+  int root;
+  int size;
+
+  [[nodiscard]] int Relative(int rank) const {
+    return (rank - root + size) % size;
+  }
+  [[nodiscard]] int Absolute(int relative) const {
+    return (relative + root) % size;
+  }
+};
+
+void BinomialBroadcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm) {
+  const RootedRanks ranks{.root = root, .size = SizeOf(comm)};
+  const int relative = ranks.Relative(RankOf(comm));
+  int mask = 1;
+  while (mask < ranks.size) {
+    if ((relative & mask) != 0) {
+      MPI_Recv(buffer, count, type, ranks.Absolute(relative - mask), kTag, comm, MPI_STATUS_IGNORE);
+      break;
+    }
+    mask <<= 1;
+  }
+  // Largest subtree first
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (relative + mask < ranks.size) {
+      MPI_Send(buffer, count, type, ranks.Absolute(relative + mask), kTag, comm);
+    }
+  }
+}
+
+void ScatterAllgatherBroadcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm) {
+  const RootedRanks ranks{.root = root, .size = SizeOf(comm)};
+  const int relative = ranks.Relative(RankOf(comm));
+  // Block i belongs to relative rank i; a subtree of the binomial tree owns a contiguous run of blocks
+  const ppc::util::BlockDistribution blocks(static_cast<std::size_t>(count), ranks.size);
+  auto block_at = [&](int block) { return At(buffer, blocks.Offset(block), type); };
+
+  int mask = 1;
+  while (mask < ranks.size) {
+    if ((relative & mask) != 0) {
+      MPI_Recv(block_at(relative), BlockSpan(blocks, relative, relative + mask), type, ranks.Absolute(relative - mask),
+               kTag, comm, MPI_STATUS_IGNORE);
+      break;
+    }
+    mask <<= 1;
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    const int child = relative + mask;
+    if (child < ranks.size) {
+      MPI_Send(block_at(child), BlockSpan(blocks, child, child + mask), type, ranks.Absolute(child), kTag, comm);
+    }
+  }
+
+  const int right = ranks.Absolute(relative + 1);
+  const int left = ranks.Absolute(relative + ranks.size - 1);
+  for (int step = 0; step + 1 < ranks.size; step++) {
+    const int send_block = (relative - step + ranks.size) % ranks.size;
+    const int recv_block = (relative - step - 1 + ranks.size) % ranks.size;
+    MPI_Sendrecv(block_at(send_block), static_cast<int>(blocks.Count(send_block)), type, right, kTag,
+                 block_at(recv_block), static_cast<int>(blocks.Count(recv_block)), type, left, kTag, comm,
+                 MPI_STATUS_IGNORE);
+  }
+}
+
+int SegmentLength(MPI_Datatype type) {
+  return static_cast<int>(std::max<std::size_t>(1, ppc::util::kPipelineSegmentBytes / ExtentOf(type)));
+}
+
+void PipelinedChainBroadcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm) {
+  const RootedRanks ranks{.root = root, .size = SizeOf(comm)};
+  const int relative = ranks.Relative(RankOf(comm));
+  const int segment = SegmentLength(type);
+  std::vector<MPI_Request> requests;
+  for (int first = 0; first < count; first += segment) {
+    const int length = std::min(segment, count - first);
+    void *data = At(buffer, static_cast<std::size_t>(first), type);
+    if (relative > 0) {
+      MPI_Recv(data, length, type, ranks.Absolute(relative - 1), kTag, comm, MPI_STATUS_IGNORE);
+    }
+    // Forwarded without waiting, so the next segment is received while this one travels on
+    if (relative + 1 < ranks.size) {
+      MPI_Request request = MPI_REQUEST_NULL;
+      MPI_Isend(data, length, type, ranks.Absolute(relative + 1), kTag, comm, &request);
+      requests.push_back(request);
+    }
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/// Posts `count` elements to `dest` as one message per segment, the layout ReceiveAndCombine() expects.
+void SendSegments(const void *data, int count, MPI_Datatype type, int dest, MPI_Comm comm,
+                  std::vector<MPI_Request> &requests) {
+  const int segment = SegmentLength(type);
+  for (int first = 0; first < count; first += segment) {
+    MPI_Request request = MPI_REQUEST_NULL;
+    MPI_Isend(At(data, static_cast<std::size_t>(first), type), std::min(segment, count - first), type, dest, kTag,
+              comm, &request);
+    requests.push_back(request);
+  }
+}
+
+/// Receives `count` elements from `source` segment by segment and combines each into `inout` while the next one is
+/// still arriving; two pooled buffers alternate. `on_combined(first, length)` runs after every segment.
+template <typename OnCombined>
+void ReceiveAndCombine(void *inout, int count, MPI_Datatype type, int source, const ppc::util::Reduction &reduction,
+                       MPI_Comm comm, const OnCombined &on_combined) {
+  if (count == 0) {
+    return;
+  }
+  const int segment = std::min(SegmentLength(type), count);
+  const std::size_t bytes = BytesOf(segment, type);
+  auto &pool = LocalPool();
+  std::array<ScratchPool::Lease, 2> buffers{pool.Acquire(bytes), pool.Acquire(count > segment ? bytes : 0)};
+  std::array<MPI_Request, 2> requests{MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+  auto length_of = [&](int first) { return std::min(segment, count - first); };
+  auto post = [&](int first, std::size_t slot) {
+    MPI_Irecv(buffers.at(slot).Data(), length_of(first), type, source, kTag, comm, &requests.at(slot));
+  };
+
+  post(0, 0);
+  std::size_t slot = 0;
+  for (int first = 0; first < count; first += segment, slot ^= 1U) {
+    if (first + segment < count) {
+      post(first + segment, slot ^ 1U);
+    }
+    MPI_Wait(&requests.at(slot), MPI_STATUS_IGNORE);
+    const int length = length_of(first);
+    reduction(buffers.at(slot).Data(), At(inout, static_cast<std::size_t>(first), type),
+              static_cast<std::size_t>(length));
+    on_combined(first, length);
+  }
+}
+
+void ReceiveAndCombine(void *inout, int count, MPI_Datatype type, int source, const ppc::util::Reduction &reduction,
+                       MPI_Comm comm) {
+  ReceiveAndCombine(inout, count, type, source, reduction, comm, [](int /*first*/, int /*length*/) {});
+}
+
+/// Sends `send_count` elements to `dest` while receiving `recv_count` elements from `source` into `inout`.
+/// `send` must not overlap the received range of `inout`.
+void ExchangeAndCombine(const void *send, int send_count, int dest, void *inout, int recv_count, int source,
+                        MPI_Datatype type, const ppc::util::Reduction &reduction, MPI_Comm comm) {
+  std::vector<MPI_Request> requests;
+  SendSegments(send, send_count, type, dest, comm, requests);
+  ReceiveAndCombine(inout, recv_count, type, source, reduction, comm);
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+void SendAll(const void *data, int count, MPI_Datatype type, int dest, MPI_Comm comm) {
+  std::vector<MPI_Request> requests;
+  SendSegments(data, count, type, dest, comm, requests);
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/// The reductions combine `data` of all ranks in place; only the root's (or every rank's for allreduce) `data`
+/// holds the result afterwards.
+void BinomialReduce(void *data, int count, MPI_Datatype type, const ppc::util::Reduction &reduction, int root,
+                    MPI_Comm comm) {
+  const RootedRanks ranks{.root = root, .size = SizeOf(comm)};
+  const int relative = ranks.Relative(RankOf(comm));
+  for (int mask = 1; mask < ranks.size; mask <<= 1) {
+    if ((relative & mask) != 0) {
+      SendAll(data, count, type, ranks.Absolute(relative - mask), comm);
+      break;
+    }
+    if (relative + mask < ranks.size) {
+      ReceiveAndCombine(data, count, type, ranks.Absolute(relative + mask), reduction, comm);
+    }
+  }
+}
+
+void PipelinedChainReduce(void *data, int count, MPI_Datatype type, const ppc::util::Reduction &reduction, int root,
+                          MPI_Comm comm) {
+  const RootedRanks ranks{.root = root, .size = SizeOf(comm)};
+  const int relative = ranks.Relative(RankOf(comm));
+  if (relative + 1 == ranks.size) {
+    SendAll(data, count, type, ranks.Absolute(relative - 1), comm);
+    return;
+  }
+  // A segment moves on towards the root as soon as it is combined
+  std::vector<MPI_Request> requests;
+  auto forward = [&](int first, int length) {
+    if (relative > 0) {
+      MPI_Request request = MPI_REQUEST_NULL;
+      MPI_Isend(At(data, static_cast<std::size_t>(first), type), length, type, ranks.Absolute(relative - 1), kTag,
+                comm, &request);
+      requests.push_back(request);
+    }
+  };
+  ReceiveAndCombine(data, count, type, ranks.Absolute(relative + 1), reduction, comm, forward);
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/// Recursive doubling and halving need a power of two of ranks: the first 2 * excess ranks pair up, even ones hand
+/// their data to the odd neighbour and sit out. Returns the rank among the remaining ranks, -1 for those sitting out.
+int FoldExcessRanks(void *data, int count, MPI_Datatype type, const ppc::util::Reduction &reduction, int rank,
+                    int excess, MPI_Comm comm) {
+  if (rank >= 2 * excess) {
+    return rank - excess;
+  }
+  if (rank % 2 == 0) {
+    SendAll(data, count, type, rank + 1, comm);
+    return -1;
+  }
+  ReceiveAndCombine(data, count, type, rank - 1, reduction, comm);
+  return rank / 2;
+}
+
+void UnfoldExcessRanks(void *data, int count, MPI_Datatype type, int rank, int excess, MPI_Comm comm) {
+  if (rank >= 2 * excess) {
+    return;
+  }
+  if (rank % 2 == 0) {
+    MPI_Recv(data, count, type, rank + 1, kTag, comm, MPI_STATUS_IGNORE);
+  } else {
+    MPI_Send(data, count, type, rank - 1, kTag, comm);
+  }
+}
+
+/// Rank in the communicator of the remaining rank `folded_rank`.
+int UnfoldedRank(int folded_rank, int excess) {
+  return folded_rank < excess ? (folded_rank * 2) + 1 : folded_rank + excess;
+}
+
+void RecursiveDoublingAllreduce(void *data, int count, MPI_Datatype type, const ppc::util::Reduction &reduction,
+                                MPI_Comm comm) {
+  const int rank = RankOf(comm);
+  const int powered = LargestPowerOfTwo(SizeOf(comm));
+  const int excess = SizeOf(comm) - powered;
+  const int folded = FoldExcessRanks(data, count, type, reduction, rank, excess, comm);
+  if (folded >= 0) {
+    // The whole buffer is sent and combined into at once, so the outgoing copy must be separate
+    auto outgoing = LocalPool().Acquire(BytesOf(count, type));
+    for (int mask = 1; mask < powered; mask <<= 1) {
+      const int partner = UnfoldedRank(folded ^ mask, excess);
+      std::memcpy(outgoing.Data(), data, BytesOf(count, type));
+      ExchangeAndCombine(outgoing.Data(), count, partner, data, count, partner, type, reduction, comm);
+    }
+  }
+  UnfoldExcessRanks(data, count, type, rank, excess, comm);
+}
+
+void RabenseifnerAllreduce(void *data, int count, MPI_Datatype type, const ppc::util::Reduction &reduction,
+                           MPI_Comm comm) {
+  const int rank = RankOf(comm);
+  const int powered = LargestPowerOfTwo(SizeOf(comm));
+  const int excess = SizeOf(comm) - powered;
+  const int folded = FoldExcessRanks(data, count, type, reduction, rank, excess, comm);
+  if (folded >= 0) {
+    const ppc::util::BlockDistribution blocks(static_cast<std::size_t>(count), powered);
+    auto data_at = [&](int block) { return At(data, blocks.Offset(block), type); };
+
+    // Reduce-scatter by recursive halving: each exchange keeps half of the blocks still owned, so the rank ends up
+    // with the reduced blocks [send_block, last_block)
+    int send_block = 0;
+    int recv_block = 0;
+    int last_block = powered;
+    int mask = 1;
+    for (; mask < powered; mask <<= 1) {
+      const int partner_folded = folded ^ mask;
+      const int half = powered / (mask * 2);
+      int send_count = 0;
+      int recv_count = 0;
+      if (folded < partner_folded) {
+        send_block = recv_block + half;
+        send_count = BlockSpan(blocks, send_block, last_block);
+        recv_count = BlockSpan(blocks, recv_block, send_block);
+      } else {
+        recv_block = send_block + half;
+        send_count = BlockSpan(blocks, send_block, recv_block);
+        recv_count = BlockSpan(blocks, recv_block, last_block);
+      }
+      const int partner = UnfoldedRank(partner_folded, excess);
+      ExchangeAndCombine(data_at(send_block), send_count, partner, data_at(recv_block), recv_count, partner, type,
+                         reduction, comm);
+      send_block = recv_block;
+      if (mask * 2 < powered) {
+        last_block = recv_block + (powered / (mask * 2));
+      }
+    }
+
+    // Allgather by recursive doubling retraces the exchanges in reverse
+    for (mask >>= 1; mask > 0; mask >>= 1) {
+      const int partner_folded = folded ^ mask;
+      const int half = powered / (mask * 2);
+      int send_count = 0;
+      int recv_count = 0;
+      if (folded < partner_folded) {
+        if (mask != powered / 2) {
+          last_block += half;
+        }
+        recv_block = send_block + half;
+        send_count = BlockSpan(blocks, send_block, recv_block);
+        recv_count = BlockSpan(blocks, recv_block, last_block);
+      } else {
+        recv_block = send_block - half;
+        send_count = BlockSpan(blocks, send_block, last_block);
+        recv_count = BlockSpan(blocks, recv_block, send_block);
+      }
+      const int partner = UnfoldedRank(partner_folded, excess);
+      MPI_Sendrecv(data_at(send_block), send_count, type, partner, kTag, data_at(recv_block), recv_count, type,
+                   partner, kTag, comm, MPI_STATUS_IGNORE);
+      if (folded > partner_folded) {
+        send_block = recv_block;
+      }
+    }
+  }
+  UnfoldExcessRanks(data, count, type, rank, excess, comm);
+}
+
+void RingAllreduce(void *data, int count, MPI_Datatype type, const ppc::util::Reduction &reduction, MPI_Comm comm) {
+  const int rank = RankOf(comm);
+  const int size = SizeOf(comm);
+  const ppc::util::BlockDistribution blocks(static_cast<std::size_t>(count), size);
+  auto data_at = [&](int block) { return At(data, blocks.Offset(block), type); };
+  auto block_count = [&](int block) { return static_cast<int>(blocks.Count(block)); };
+  const int right = (rank + 1) % size;
+  const int left = (rank + size - 1) % size;
+
+  // After step s the rank holds block rank - s - 1 reduced over s + 2 ranks, after size - 1 steps block rank + 1
+  // is complete
+  for (int step = 0; step + 1 < size; step++) {
+    const int send_block = (rank - step + size) % size;
+    const int recv_block = (rank - step - 1 + size) % size;
+    ExchangeAndCombine(data_at(send_block), block_count(send_block), right, data_at(recv_block),
+                       block_count(recv_block), left, type, reduction, comm);
+  }
+  for (int step = 0; step + 1 < size; step++) {
+    const int send_block = (rank + 1 - step + size) % size;
+    const int recv_block = (rank - step + size) % size;
+    MPI_Sendrecv(data_at(send_block), block_count(send_block), type, right, kTag, data_at(recv_block),
+                 block_count(recv_block), type, left, kTag, comm, MPI_STATUS_IGNORE);
+  }
+}
+
+/// Runs a non-hierarchical broadcast on a private communicator.
+void FlatBroadcast(ppc::util::BroadcastAlgorithm algorithm, void *buffer, int count, MPI_Datatype type, int root,
+                   MPI_Comm comm) {
+  using ppc::util::BroadcastAlgorithm;
+  if (algorithm == BroadcastAlgorithm::kAuto || algorithm == BroadcastAlgorithm::kHierarchical) {
+    algorithm = ppc::util::SelectBroadcastAlgorithm(static_cast<std::size_t>(count), BytesOf(count, type),
+                                                    SizeOf(comm));
+  }
+  switch (algorithm) {
+    case BroadcastAlgorithm::kScatterAllgather:
+      ScatterAllgatherBroadcast(buffer, count, type, root, comm);
+      break;
+    case BroadcastAlgorithm::kPipelinedChain:
+      PipelinedChainBroadcast(buffer, count, type, root, comm);
+      break;
+    case BroadcastAlgorithm::kAuto:
+    case BroadcastAlgorithm::kBinomial:
+    case BroadcastAlgorithm::kHierarchical:
+      BinomialBroadcast(buffer, count, type, root, comm);
+      break;
+  }
+}
+
+void FlatAllreduce(ppc::util::AllreduceAlgorithm algorithm, void *data, int count, MPI_Datatype type,
+                   const ppc::util::Reduction &reduction, MPI_Comm comm) {
+  using ppc::util::AllreduceAlgorithm;
+  if (algorithm == AllreduceAlgorithm::kAuto || algorithm == AllreduceAlgorithm::kHierarchical) {
+    algorithm = ppc::util::SelectAllreduceAlgorithm(static_cast<std::size_t>(count), BytesOf(count, type),
+                                                    SizeOf(comm));
+  }
+  switch (algorithm) {
+    case AllreduceAlgorithm::kRabenseifner:
+      RabenseifnerAllreduce(data, count, type, reduction, comm);
+      break;
+    case AllreduceAlgorithm::kRing:
+      RingAllreduce(data, count, type, reduction, comm);
+      break;
+    case AllreduceAlgorithm::kAuto:
+    case AllreduceAlgorithm::kRecursiveDoubling:
+    case AllreduceAlgorithm::kHierarchical:
+      RecursiveDoublingAllreduce(data, count, type, reduction, comm);
+      break;
+  }
+}
+
+void FlatReduce(ppc::util::ReduceAlgorithm algorithm, void *data, int count, MPI_Datatype type,
+                const ppc::util::Reduction &reduction, int root, MPI_Comm comm) {
+  using ppc::util::ReduceAlgorithm;
+  if (algorithm == ReduceAlgorithm::kAuto) {
+    algorithm =
+        ppc::util::SelectReduceAlgorithm(static_cast<std::size_t>(count), BytesOf(count, type), SizeOf(comm));
+  }
+  if (algorithm == ReduceAlgorithm::kPipelinedChain) {
+    PipelinedChainReduce(data, count, type, reduction, root, comm);
+  } else {
+    BinomialReduce(data, count, type, reduction, root, comm);
+  }
+}
+
+void CheckCollective(int count, int root, MPI_Comm comm) {
+  if (count < 0) {
+    throw std::invalid_argument(std::format("Collective count must not be negative, got {}", count));
+  }
+  const int size = SizeOf(comm);
+  if (root < 0 || root >= size) {
+    throw std::invalid_argument(std::format("Root {} is not a rank of a communicator of {} processes", root, size));
+  }
+}
+
+bool IsCommutative(MPI_Op op) {
+  int commutative = 0;
+  MPI_Op_commutative(op, &commutative);
+  return commutative != 0;
+}
+
+/// Operation without a compiled kernel, applied through MPI_Reduce_local.
+struct LocalOperation {
+  MPI_Op op;
+  MPI_Datatype type;
+};
+
+ppc::util::Reduction ReductionOf(const LocalOperation &operation) {
+  auto reduction = ppc::util::PredefinedReduction(operation.op, operation.type);
+  if (reduction.combine == nullptr) {
+    reduction = {.combine =
+                     [](const void *in, void *inout, std::size_t count, const void *state) {
+                       const auto &operation = *static_cast<const LocalOperation *>(state);
+                       MPI_Reduce_local(in, inout, static_cast<int>(count), operation.type, operation.op);
+                     },
+                 .state = &operation};
+  }
+  return reduction;
+}
+
+}  // namespace
+
+namespace ppc::util {
+
+std::string_view GetAlgorithmName(BroadcastAlgorithm algorithm) {
+  switch (algorithm) {
+    case BroadcastAlgorithm::kAuto:
+      return "auto";
+    case BroadcastAlgorithm::kBinomial:
+      return "binomial";
+    case BroadcastAlgorithm::kScatterAllgather:
+      return "scatter_allgather";
+    case BroadcastAlgorithm::kPipelinedChain:
+      return "pipelined_chain";
+    case BroadcastAlgorithm::kHierarchical:
+      return "hierarchical";
+  }
+  return "unknown";
+}
+
+std::string_view GetAlgorithmName(ReduceAlgorithm algorithm) {
+  switch (algorithm) {
+    case ReduceAlgorithm::kAuto:
+      return "auto";
+    case ReduceAlgorithm::kBinomial:
+      return "binomial";
+    case ReduceAlgorithm::kPipelinedChain:
+      return "pipelined_chain";
+  }
+  return "unknown";
+}
+
+std::string_view GetAlgorithmName(AllreduceAlgorithm algorithm) {
+  switch (algorithm) {
+    case AllreduceAlgorithm::kAuto:
+      return "auto";
+    case AllreduceAlgorithm::kRecursiveDoubling:
+      return "recursive_doubling";
+    case AllreduceAlgorithm::kRabenseifner:
+      return "rabenseifner";
+    case AllreduceAlgorithm::kRing:
+      return "ring";
+    case AllreduceAlgorithm::kHierarchical:
+      return "hierarchical";
+  }
+  return "unknown";
+}
+
+BroadcastAlgorithm SelectBroadcastAlgorithm(std::size_t count, std::size_t bytes, int size, int nodes) {
+  if (nodes > 1 && nodes < size) {
+    return BroadcastAlgorithm::kHierarchical;
+  }
+  // Splitting into blocks only pays off when every rank gets a non-empty block and the tree is deep enough
+  if (bytes <= kBinomialBroadcastMaxBytes || size < 8 || count < static_cast<std::size_t>(size)) {
+    return BroadcastAlgorithm::kBinomial;
+  }
+  if (bytes <= kScatterAllgatherBroadcastMaxBytes) {
+    return BroadcastAlgorithm::kScatterAllgather;
+  }
+  return BroadcastAlgorithm::kPipelinedChain;
+}
+
+ReduceAlgorithm SelectReduceAlgorithm(std::size_t count, std::size_t bytes, int size) {
+  if (bytes <= kBinomialReduceMaxBytes || size < 4 || count < static_cast<std::size_t>(size)) {
+    return ReduceAlgorithm::kBinomial;
+  }
+  return ReduceAlgorithm::kPipelinedChain;
+}
+
+AllreduceAlgorithm SelectAllreduceAlgorithm(std::size_t count, std::size_t bytes, int size, int nodes) {
+  if (nodes > 1 && nodes < size) {
+    return AllreduceAlgorithm::kHierarchical;
+  }
+  if (bytes <= kRecursiveDoublingMaxBytes || count < static_cast<std::size_t>(size)) {
+    return AllreduceAlgorithm::kRecursiveDoubling;
+  }
+  // The extra ranks of a non-power of two exchange the whole message twice, which the ring avoids
+  const bool power_of_two = (size & (size - 1)) == 0;
+  if (!power_of_two && bytes >= kRingAllreduceMinBytes) {
+    return AllreduceAlgorithm::kRing;
+  }
+  return AllreduceAlgorithm::kRabenseifner;
+}
+
+void Broadcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm, BroadcastAlgorithm algorithm) {
+  CheckCollective(count, root, comm);
+  if (count == 0 || SizeOf(comm) == 1) {
+    return;
+  }
+  const auto &context = GetContext(comm);
+  if (algorithm == BroadcastAlgorithm::kAuto) {
+    algorithm = SelectBroadcastAlgorithm(static_cast<std::size_t>(count), BytesOf(count, type), SizeOf(comm),
+                                         context.nodes);
+  }
+  if (algorithm != BroadcastAlgorithm::kHierarchical) {
+    FlatBroadcast(algorithm, buffer, count, type, root, context.comm);
+    return;
+  }
+
+  // The node of the root spreads the data first, so its leader can feed the other leaders
+  const auto root_index = static_cast<std::size_t>(root);
+  const int root_node = context.node_of[root_index];
+  const bool on_root_node = context.node_of[static_cast<std::size_t>(RankOf(context.comm))] == root_node;
+  if (on_root_node) {
+    FlatBroadcast(algorithm, buffer, count, type, context.local_rank_of[root_index], context.node_comm);
+  }
+  if (context.leader_comm != MPI_COMM_NULL) {
+    FlatBroadcast(algorithm, buffer, count, type, root_node, context.leader_comm);
+  }
+  if (!on_root_node) {
+    FlatBroadcast(algorithm, buffer, count, type, 0, context.node_comm);
+  }
+}
+
+void Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm,
+            ReduceAlgorithm algorithm) {
+  if (!IsCommutative(op)) {
+    CheckCollective(count, root, comm);
+    MPI_Reduce(sendbuf, recvbuf, count, type, op, root, comm);
+    return;
+  }
+  const LocalOperation operation{.op = op, .type = type};
+  detail::Reduce(sendbuf, recvbuf, count, type, ReductionOf(operation), root, comm, algorithm);
+}
+
+void Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+               AllreduceAlgorithm algorithm) {
+  if (!IsCommutative(op)) {
+    CheckCollective(count, 0, comm);
+    MPI_Allreduce(sendbuf, recvbuf, count, type, op, comm);
+    return;
+  }
+  const LocalOperation operation{.op = op, .type = type};
+  detail::Allreduce(sendbuf, recvbuf, count, type, ReductionOf(operation), comm, algorithm);
+}
+
+namespace detail {
+
+void Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, const Reduction &reduction, int root,
+            MPI_Comm comm, ReduceAlgorithm algorithm) {
+  CheckCollective(count, root, comm);
+  if (count == 0) {
+    return;
+  }
+  // Only the root keeps the result; the other ranks combine partial results in a pooled buffer
+  const bool is_root = RankOf(comm) == root;
+  auto scratch = LocalPool().Acquire(is_root ? 0 : BytesOf(count, type));
+  void *data = is_root ? recvbuf : scratch.Data();
+  if (sendbuf != MPI_IN_PLACE) {
+    std::memcpy(data, sendbuf, BytesOf(count, type));
+  }
+  if (SizeOf(comm) > 1) {
+    FlatReduce(algorithm, data, count, type, reduction, root, GetContext(comm).comm);
+  }
+}
+
+void Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, const Reduction &reduction,
+               MPI_Comm comm, AllreduceAlgorithm algorithm) {
+  CheckCollective(count, 0, comm);
+  if (count == 0) {
+    return;
+  }
+  if (sendbuf != MPI_IN_PLACE) {
+    std::memcpy(recvbuf, sendbuf, BytesOf(count, type));
+  }
+  if (SizeOf(comm) == 1) {
+    return;
+  }
+  const auto &context = GetContext(comm);
+  if (algorithm == AllreduceAlgorithm::kAuto) {
+    algorithm = SelectAllreduceAlgorithm(static_cast<std::size_t>(count), BytesOf(count, type), SizeOf(comm),
+                                         context.nodes);
+  }
+  if (algorithm != AllreduceAlgorithm::kHierarchical) {
+    FlatAllreduce(algorithm, recvbuf, count, type, reduction, context.comm);
+    return;
+  }
+
+  // Node traffic goes through shared memory; only the leaders talk across nodes
+  FlatReduce(ReduceAlgorithm::kAuto, recvbuf, count, type, reduction, 0, context.node_comm);
+  if (context.leader_comm != MPI_COMM_NULL) {
+    FlatAllreduce(algorithm, recvbuf, count, type, reduction, context.leader_comm);
+  }
+  FlatBroadcast(BroadcastAlgorithm::kAuto, recvbuf, count, type, 0, context.node_comm);
+}
+
+}  // namespace detail
+
+}  // namespace ppc::util
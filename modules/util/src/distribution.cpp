@@ -0,0 +1,541 @@
+#include "util/include/distribution.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int CheckParts(int parts) {
+  if (parts <= 0) {
+    throw std::invalid_argument(std::format("A distribution needs at least one part, got {}", parts));
+  }
+  return parts;
+}
+
+int GridRowsOf(int parts, ppc::util::MatrixLayout layout) {
+  switch (layout) {
+    case ppc::util::MatrixLayout::kRows:
+      return parts;
+    case ppc::util::MatrixLayout::kColumns:
+      return 1;
+    case ppc::util::MatrixLayout::kTiles:
+      break;
+  }
+  // Largest divisor not above the square root, so the grid is as square as possible
+  int grid_rows = 1;
+  for (int divisor = 1; divisor * divisor <= parts; divisor++) {
+    if (parts % divisor == 0) {
+      grid_rows = divisor;
+    }
+  }
+  return grid_rows;
+}
+
+/// Rank of the calling process; throws if the communicator does not have one process per part.
+int RankFor(int parts, MPI_Comm comm) {
+  int size = 0;
+  int rank = 0;
+  MPI_Comm_size(comm, &size);
+  MPI_Comm_rank(comm, &rank);
+  if (size != parts) {
+    throw std::invalid_argument(
+        std::format("The distribution has {} parts but the communicator has {} processes", parts, size));
+  }
+  return rank;
+}
+
+/// Buffer sizes checked on every process before a collective. A process that threw on its own would leave the
+/// others waiting in the collective, so the processes first agree whether any of them failed.
+class SizeCheck {
+ public:
+  void Expect(std::size_t actual, std::size_t expected, const char *buffer) {
+    if (error_.empty() && actual != expected) {
+      error_ = std::format("The {} buffer holds {} elements instead of {}", buffer, actual, expected);
+    }
+  }
+
+  /// Collective over `comm`: throws on every process if the sizes were wrong on any of them.
+  void Agree(MPI_Comm comm) const {
+    int failed = error_.empty() ? 0 : 1;
+    MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+    if (!error_.empty()) {
+      throw std::invalid_argument(error_);
+    }
+    if (failed != 0) {
+      throw std::invalid_argument("Another process passed a buffer of the wrong size");
+    }
+  }
+
+ private:
+  std::string error_;
+};
+
+/// Owns a committed derived datatype; MPI_DATATYPE_NULL stands for an empty part.
+class DerivedType {
+ public:
+  explicit DerivedType(MPI_Datatype type) : type_(type) {
+    if (type_ != MPI_DATATYPE_NULL) {
+      MPI_Type_commit(&type_);
+    }
+  }
+  DerivedType(const DerivedType &) = delete;
+  DerivedType &operator=(const DerivedType &) = delete;
+  DerivedType(DerivedType &&other) noexcept : type_(std::exchange(other.type_, MPI_DATATYPE_NULL)) {}
+  DerivedType &operator=(DerivedType &&) = delete;
+  ~DerivedType() {
+    if (type_ != MPI_DATATYPE_NULL) {
+      MPI_Type_free(&type_);
+    }
+  }
+
+  [[nodiscard]] MPI_Datatype Get() const {
+    return type_;
+  }
+
+ private:
+  MPI_Datatype type_;
+};
+
+/// `count` elements of `type` spaced `stride` elements apart, resized to the extent of one element so that
+/// consecutive items of the type start at consecutive elements.
+DerivedType StridedColumn(std::size_t count, std::size_t stride, MPI_Datatype type) {
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type, &lower_bound, &extent);
+  MPI_Datatype vector = MPI_DATATYPE_NULL;
+  MPI_Type_vector(static_cast<int>(count), 1, static_cast<int>(stride), type, &vector);
+  MPI_Datatype resized = MPI_DATATYPE_NULL;
+  MPI_Type_create_resized(vector, 0, extent, &resized);
+  MPI_Type_free(&vector);
+  return DerivedType(resized);
+}
+
+/// Per-peer arguments of MPI_Alltoallw; peers without data get a zero count.
+struct ExchangePlan {
+  explicit ExchangePlan(int size, MPI_Datatype type)
+      : counts(static_cast<std::size_t>(size), 0), displs(static_cast<std::size_t>(size), 0),
+        types(static_cast<std::size_t>(size), type) {}
+
+  void Set(int peer, int count, MPI_Datatype type) {
+    counts[static_cast<std::size_t>(peer)] = count;
+    types[static_cast<std::size_t>(peer)] = type;
+  }
+
+  std::vector<int> counts;
+  std::vector<int> displs;
+  std::vector<MPI_Datatype> types;
+};
+
+void Exchange(const void *send, const ExchangePlan &send_plan, void *recv, const ExchangePlan &recv_plan,
+              MPI_Comm comm) {
+  MPI_Alltoallw(send, send_plan.counts.data(), send_plan.displs.data(), send_plan.types.data(), recv,
+                recv_plan.counts.data(), recv_plan.displs.data(), recv_plan.types.data(), comm);
+}
+
+/// Derived datatypes selecting the items of every part from the global buffer; null entries for empty parts.
+std::vector<DerivedType> PartTypes(const ppc::util::BlockCyclicDistribution &dist, MPI_Datatype type) {
+  std::vector<DerivedType> types;
+  for (int part = 0; part < dist.Parts(); part++) {
+    std::vector<int> lengths;
+    std::vector<int> offsets;
+    for (const auto &range : dist.Ranges(part)) {
+      lengths.push_back(static_cast<int>(range.Size()));
+      offsets.push_back(static_cast<int>(range.begin));
+    }
+    MPI_Datatype indexed = MPI_DATATYPE_NULL;
+    if (!lengths.empty()) {
+      MPI_Type_indexed(static_cast<int>(lengths.size()), lengths.data(), offsets.data(), type, &indexed);
+    }
+    types.emplace_back(indexed);
+  }
+  return types;
+}
+
+std::vector<DerivedType> PartTypes(const ppc::util::MatrixDistribution &dist, MPI_Datatype type) {
+  std::vector<DerivedType> types;
+  for (int part = 0; part < dist.Parts(); part++) {
+    MPI_Datatype subarray = MPI_DATATYPE_NULL;
+    if (dist.LocalSize(part) > 0) {
+      const std::array<int, 2> sizes = {static_cast<int>(dist.Rows()), static_cast<int>(dist.Cols())};
+      const std::array<int, 2> subsizes = {static_cast<int>(dist.LocalRows(part)),
+                                           static_cast<int>(dist.LocalCols(part))};
+      const std::array<int, 2> starts = {static_cast<int>(dist.RowRange(part).begin),
+                                         static_cast<int>(dist.ColRange(part).begin)};
+      MPI_Type_create_subarray(2, sizes.data(), subsizes.data(), starts.data(), MPI_ORDER_C, type, &subarray);
+    }
+    types.emplace_back(subarray);
+  }
+  return types;
+}
+
+/// Plan that addresses every part of the global buffer through its derived datatype.
+ExchangePlan GlobalPlan(const std::vector<DerivedType> &types, MPI_Datatype type) {
+  ExchangePlan plan(static_cast<int>(types.size()), type);
+  for (std::size_t part = 0; part < types.size(); part++) {
+    if (types[part].Get() != MPI_DATATYPE_NULL) {
+      plan.Set(static_cast<int>(part), 1, types[part].Get());
+    }
+  }
+  return plan;
+}
+
+// Scatter, gather and allgather through MPI_Alltoallw for parts that are not contiguous in the global buffer.
+// The buffer sizes are checked by the callers; `make_types` builds the datatypes of all parts.
+
+template <typename MakeTypes>
+void ScatterParts(int rank, int parts, MakeTypes &&make_types, const void *global, void *local,
+                  std::size_t local_size, MPI_Datatype type, int root, MPI_Comm comm) {
+  ExchangePlan send_plan(parts, type);
+  std::vector<DerivedType> types;
+  if (rank == root) {
+    types = make_types();
+    send_plan = GlobalPlan(types, type);
+  }
+  ExchangePlan recv_plan(parts, type);
+  recv_plan.Set(root, static_cast<int>(local_size), type);
+  Exchange(global, send_plan, local, recv_plan, comm);
+}
+
+template <typename MakeTypes>
+void GatherParts(int rank, int parts, MakeTypes &&make_types, const void *local, std::size_t local_size,
+                 void *global, MPI_Datatype type, int root, MPI_Comm comm) {
+  ExchangePlan send_plan(parts, type);
+  send_plan.Set(root, static_cast<int>(local_size), type);
+  ExchangePlan recv_plan(parts, type);
+  std::vector<DerivedType> types;
+  if (rank == root) {
+    types = make_types();
+    recv_plan = GlobalPlan(types, type);
+  }
+  Exchange(local, send_plan, global, recv_plan, comm);
+}
+
+template <typename MakeTypes>
+void AllgatherParts(int parts, MakeTypes &&make_types, const void *local, std::size_t local_size, void *global,
+                    MPI_Datatype type, MPI_Comm comm) {
+  ExchangePlan send_plan(parts, type);
+  for (int peer = 0; peer < parts; peer++) {
+    send_plan.Set(peer, static_cast<int>(local_size), type);
+  }
+  const auto types = make_types();
+  Exchange(local, send_plan, global, GlobalPlan(types, type), comm);
+}
+
+/// Counts and displacements of row stripes, in elements.
+struct RowStripes {
+  explicit RowStripes(const ppc::util::MatrixDistribution &dist)
+      : counts(ppc::util::BlockDistribution(dist.Rows(), dist.Parts()).Counts(dist.Cols())),
+        displs(ppc::util::BlockDistribution(dist.Rows(), dist.Parts()).Displacements(dist.Cols())) {}
+
+  std::vector<int> counts;
+  std::vector<int> displs;
+};
+
+/// Column stripes move as counts of single strided columns, so MPI_Scatterv and friends apply: the global buffer is
+/// addressed in columns of the full matrix, the local one in columns of the stripe.
+struct ColumnStripes {
+  ColumnStripes(const ppc::util::MatrixDistribution &dist, int rank, MPI_Datatype type)
+      : counts(ppc::util::BlockDistribution(dist.Cols(), dist.Parts()).Counts()),
+        displs(ppc::util::BlockDistribution(dist.Cols(), dist.Parts()).Displacements()),
+        global_column(StridedColumn(dist.Rows(), dist.Cols(), type)),
+        local_column(StridedColumn(dist.Rows(), std::max<std::size_t>(dist.LocalCols(rank), 1), type)),
+        local_count(static_cast<int>(dist.LocalCols(rank))) {}
+
+  std::vector<int> counts;
+  std::vector<int> displs;
+  DerivedType global_column;
+  DerivedType local_column;
+  int local_count;
+};
+
+}  // namespace
+
+namespace ppc::util {
+
+BlockDistribution::BlockDistribution(std::size_t total, int parts)
+    : total_(total),
+      parts_(CheckParts(parts)),
+      base_(total / static_cast<std::size_t>(parts)),
+      remainder_(total % static_cast<std::size_t>(parts)) {}
+
+std::size_t BlockDistribution::Count(int part) const {
+  return base_ + (std::cmp_less(part, remainder_) ? 1 : 0);
+}
+
+std::size_t BlockDistribution::Offset(int part) const {
+  const auto index = static_cast<std::size_t>(part);
+  return (index * base_) + std::min(index, remainder_);
+}
+
+IndexRange BlockDistribution::Range(int part) const {
+  return {.begin = Offset(part), .end = Offset(part) + Count(part)};
+}
+
+int BlockDistribution::Owner(std::size_t index) const {
+  const std::size_t long_items = remainder_ * (base_ + 1);
+  if (index < long_items) {
+    return static_cast<int>(index / (base_ + 1));
+  }
+  return static_cast<int>(remainder_ + ((index - long_items) / base_));
+}
+
+std::vector<int> BlockDistribution::Counts(std::size_t unit) const {
+  std::vector<int> counts(static_cast<std::size_t>(parts_));
+  for (int part = 0; part < parts_; part++) {
+    counts[static_cast<std::size_t>(part)] = static_cast<int>(Count(part) * unit);
+  }
+  return counts;
+}
+
+std::vector<int> BlockDistribution::Displacements(std::size_t unit) const {
+  std::vector<int> displs(static_cast<std::size_t>(parts_));
+  for (int part = 0; part < parts_; part++) {
+    displs[static_cast<std::size_t>(part)] = static_cast<int>(Offset(part) * unit);
+  }
+  return displs;
+}
+
+BlockCyclicDistribution::BlockCyclicDistribution(std::size_t total, int parts, std::size_t block)
+    : total_(total), parts_(CheckParts(parts)), block_(block) {
+  if (block == 0) {
+    throw std::invalid_argument("A block-cyclic distribution needs a block size of at least one");
+  }
+}
+
+std::size_t BlockCyclicDistribution::Count(int part) const {
+  const std::size_t blocks = (total_ + block_ - 1) / block_;
+  const auto parts = static_cast<std::size_t>(parts_);
+  const auto index = static_cast<std::size_t>(part);
+  std::size_t count = ((blocks / parts) + (index < blocks % parts ? 1 : 0)) * block_;
+  // The last block may be shorter
+  if (blocks > 0 && (blocks - 1) % parts == index) {
+    count -= (blocks * block_) - total_;
+  }
+  return count;
+}
+
+int BlockCyclicDistribution::Owner(std::size_t index) const {
+  return static_cast<int>((index / block_) % static_cast<std::size_t>(parts_));
+}
+
+std::size_t BlockCyclicDistribution::LocalIndex(std::size_t index) const {
+  return ((index / block_ / static_cast<std::size_t>(parts_)) * block_) + (index % block_);
+}
+
+std::size_t BlockCyclicDistribution::GlobalIndex(int part, std::size_t local_index) const {
+  const auto parts = static_cast<std::size_t>(parts_);
+  const std::size_t block = ((local_index / block_) * parts) + static_cast<std::size_t>(part);
+  return (block * block_) + (local_index % block_);
+}
+
+std::vector<IndexRange> BlockCyclicDistribution::Ranges(int part) const {
+  std::vector<IndexRange> ranges;
+  for (auto begin = static_cast<std::size_t>(part) * block_; begin < total_;
+       begin += static_cast<std::size_t>(parts_) * block_) {
+    ranges.push_back({.begin = begin, .end = std::min(begin + block_, total_)});
+  }
+  return ranges;
+}
+
+MatrixDistribution::MatrixDistribution(std::size_t rows, std::size_t cols, int parts, MatrixLayout layout)
+    : rows_(rows),
+      cols_(cols),
+      layout_(layout),
+      grid_rows_(GridRowsOf(CheckParts(parts), layout)),
+      grid_cols_(parts / grid_rows_),
+      row_blocks_(rows, grid_rows_),
+      col_blocks_(cols, grid_cols_) {}
+
+IndexRange MatrixDistribution::RowRange(int part) const {
+  return row_blocks_.Range(part / grid_cols_);
+}
+
+IndexRange MatrixDistribution::ColRange(int part) const {
+  return col_blocks_.Range(part % grid_cols_);
+}
+
+std::size_t MatrixDistribution::LocalRows(int part) const {
+  return row_blocks_.Count(part / grid_cols_);
+}
+
+std::size_t MatrixDistribution::LocalCols(int part) const {
+  return col_blocks_.Count(part % grid_cols_);
+}
+
+std::size_t MatrixDistribution::LocalSize(int part) const {
+  return LocalRows(part) * LocalCols(part);
+}
+
+int MatrixDistribution::Owner(std::size_t row, std::size_t col) const {
+  return (row_blocks_.Owner(row) * grid_cols_) + col_blocks_.Owner(col);
+}
+
+namespace detail {
+
+void Scatter(const BlockDistribution &dist, const void *global, std::size_t global_size, void *local,
+             std::size_t local_size, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.Count(rank), "local");
+  if (rank == root) {
+    sizes.Expect(global_size, dist.Total(), "global");
+  }
+  sizes.Agree(comm);
+  const auto counts = dist.Counts();
+  const auto displs = dist.Displacements();
+  MPI_Scatterv(global, counts.data(), displs.data(), type, local, static_cast<int>(local_size), type, root, comm);
+}
+
+void Gather(const BlockDistribution &dist, const void *local, std::size_t local_size, void *global,
+            std::size_t global_size, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.Count(rank), "local");
+  if (rank == root) {
+    sizes.Expect(global_size, dist.Total(), "global");
+  }
+  sizes.Agree(comm);
+  const auto counts = dist.Counts();
+  const auto displs = dist.Displacements();
+  MPI_Gatherv(local, static_cast<int>(local_size), type, global, counts.data(), displs.data(), type, root, comm);
+}
+
+void Allgather(const BlockDistribution &dist, const void *local, std::size_t local_size, void *global,
+               std::size_t global_size, MPI_Datatype type, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.Count(rank), "local");
+  sizes.Expect(global_size, dist.Total(), "global");
+  sizes.Agree(comm);
+  const auto counts = dist.Counts();
+  const auto displs = dist.Displacements();
+  MPI_Allgatherv(local, static_cast<int>(local_size), type, global, counts.data(), displs.data(), type, comm);
+}
+
+void Scatter(const BlockCyclicDistribution &dist, const void *global, std::size_t global_size, void *local,
+             std::size_t local_size, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.Count(rank), "local");
+  if (rank == root) {
+    sizes.Expect(global_size, dist.Total(), "global");
+  }
+  sizes.Agree(comm);
+  ScatterParts(rank, dist.Parts(), [&] { return PartTypes(dist, type); }, global, local, local_size, type, root, comm);
+}
+
+void Gather(const BlockCyclicDistribution &dist, const void *local, std::size_t local_size, void *global,
+            std::size_t global_size, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.Count(rank), "local");
+  if (rank == root) {
+    sizes.Expect(global_size, dist.Total(), "global");
+  }
+  sizes.Agree(comm);
+  GatherParts(rank, dist.Parts(), [&] { return PartTypes(dist, type); }, local, local_size, global, type, root, comm);
+}
+
+void Allgather(const BlockCyclicDistribution &dist, const void *local, std::size_t local_size, void *global,
+               std::size_t global_size, MPI_Datatype type, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.Count(rank), "local");
+  sizes.Expect(global_size, dist.Total(), "global");
+  sizes.Agree(comm);
+  AllgatherParts(dist.Parts(), [&] { return PartTypes(dist, type); }, local, local_size, global, type, comm);
+}
+
+void Scatter(const MatrixDistribution &dist, const void *global, std::size_t global_size, void *local,
+             std::size_t local_size, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.LocalSize(rank), "local");
+  if (rank == root) {
+    sizes.Expect(global_size, dist.Rows() * dist.Cols(), "global");
+  }
+  sizes.Agree(comm);
+  switch (dist.Layout()) {
+    case MatrixLayout::kRows: {
+      const RowStripes stripes(dist);
+      MPI_Scatterv(global, stripes.counts.data(), stripes.displs.data(), type, local, static_cast<int>(local_size),
+                   type, root, comm);
+      return;
+    }
+    case MatrixLayout::kColumns: {
+      const ColumnStripes stripes(dist, rank, type);
+      MPI_Scatterv(global, stripes.counts.data(), stripes.displs.data(), stripes.global_column.Get(), local,
+                   stripes.local_count, stripes.local_column.Get(), root, comm);
+      return;
+    }
+    case MatrixLayout::kTiles:
+      break;
+  }
+  ScatterParts(rank, dist.Parts(), [&] { return PartTypes(dist, type); }, global, local, local_size, type, root, comm);
+}
+
+void Gather(const MatrixDistribution &dist, const void *local, std::size_t local_size, void *global,
+            std::size_t global_size, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.LocalSize(rank), "local");
+  if (rank == root) {
+    sizes.Expect(global_size, dist.Rows() * dist.Cols(), "global");
+  }
+  sizes.Agree(comm);
+  switch (dist.Layout()) {
+    case MatrixLayout::kRows: {
+      const RowStripes stripes(dist);
+      MPI_Gatherv(local, static_cast<int>(local_size), type, global, stripes.counts.data(), stripes.displs.data(),
+                  type, root, comm);
+      return;
+    }
+    case MatrixLayout::kColumns: {
+      const ColumnStripes stripes(dist, rank, type);
+      MPI_Gatherv(local, stripes.local_count, stripes.local_column.Get(), global, stripes.counts.data(),
+                  stripes.displs.data(), stripes.global_column.Get(), root, comm);
+      return;
+    }
+    case MatrixLayout::kTiles:
+      break;
+  }
+  GatherParts(rank, dist.Parts(), [&] { return PartTypes(dist, type); }, local, local_size, global, type, root, comm);
+}
+
+void Allgather(const MatrixDistribution &dist, const void *local, std::size_t local_size, void *global,
+               std::size_t global_size, MPI_Datatype type, MPI_Comm comm) {
+  const int rank = RankFor(dist.Parts(), comm);
+  SizeCheck sizes;
+  sizes.Expect(local_size, dist.LocalSize(rank), "local");
+  sizes.Expect(global_size, dist.Rows() * dist.Cols(), "global");
+  sizes.Agree(comm);
+  switch (dist.Layout()) {
+    case MatrixLayout::kRows: {
+      const RowStripes stripes(dist);
+      MPI_Allgatherv(local, static_cast<int>(local_size), type, global, stripes.counts.data(),
+                     stripes.displs.data(), type, comm);
+      return;
+    }
+    case MatrixLayout::kColumns: {
+      const ColumnStripes stripes(dist, rank, type);
+      MPI_Allgatherv(local, stripes.local_count, stripes.local_column.Get(), global, stripes.counts.data(),
+                     stripes.displs.data(), stripes.global_column.Get(), comm);
+      return;
+    }
+    case MatrixLayout::kTiles:
+      break;
+  }
+  AllgatherParts(dist.Parts(), [&] { return PartTypes(dist, type); }, local, local_size, global, type, comm);
+}
+
+}  // namespace detail
+
+}  // namespace ppc::util
@@ -1,5 +1,14 @@
 #include <mpi.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_footprint.hpp"
+#include "performance/include/rank_timings.hpp"
 #include "util/include/perf_test_util.hpp"
 
 double ppc::util::GetTimeMPI() {
@@ -11,3 +20,64 @@ int ppc::util::GetMPIRank() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   return rank;
 }
+
+int ppc::util::GetMPISize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+bool ppc::util::SyncPerfDecision(bool keep_running) {
+  int decision = keep_running ? 1 : 0;
+  MPI_Bcast(&decision, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return decision != 0;
+}
+
+void ppc::util::ReducePerfCounters(ppc::performance::CounterTotals &counters) {
+  MPI_Allreduce(MPI_IN_PLACE, counters.values.data(), static_cast<int>(counters.values.size()), MPI_UINT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, counters.valid.data(), static_cast<int>(counters.valid.size()), MPI_UINT8_T, MPI_MIN,
+                MPI_COMM_WORLD);
+}
+
+ppc::performance::RankTimings ppc::util::GatherRankTimings(const std::vector<double> &samples, double mpi_time) {
+  const int size = GetMPISize();
+  const int count = static_cast<int>(samples.size());
+  std::vector<int> counts(size);
+  MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+  std::vector<int> displs(size);
+  int total = 0;
+  for (int rank = 0; rank < size; rank++) {
+    displs[rank] = total;
+    total += counts[rank];
+  }
+  std::vector<double> all_samples(total);
+  MPI_Allgatherv(samples.data(), count, MPI_DOUBLE, all_samples.data(), counts.data(), displs.data(), MPI_DOUBLE,
+                 MPI_COMM_WORLD);
+  std::vector<double> all_mpi_time(size);
+  MPI_Allgather(&mpi_time, 1, MPI_DOUBLE, all_mpi_time.data(), 1, MPI_DOUBLE, MPI_COMM_WORLD);
+
+  std::vector<std::vector<double>> per_rank(size);
+  for (int rank = 0; rank < size; rank++) {
+    const auto begin = all_samples.begin() + displs[rank];
+    per_rank[rank].assign(begin, begin + counts[rank]);
+  }
+  return ppc::performance::MakeRankTimings(std::move(per_rank), std::move(all_mpi_time));
+}
+
+std::vector<ppc::performance::RankMemory> ppc::util::GatherRankMemory(const ppc::performance::RankMemory &memory) {
+  const int size = GetMPISize();
+  const std::array<std::uint64_t, 3> local = {memory.peak_rss, memory.peak_heap, memory.allocated_per_run};
+  std::vector<std::uint64_t> all(local.size() * static_cast<std::size_t>(size));
+  MPI_Allgather(local.data(), static_cast<int>(local.size()), MPI_UINT64_T, all.data(), static_cast<int>(local.size()),
+                MPI_UINT64_T, MPI_COMM_WORLD);
+
+  std::vector<ppc::performance::RankMemory> per_rank(size);
+  for (std::size_t rank = 0; rank < per_rank.size(); rank++) {
+    per_rank[rank] = {.peak_rss = all[(rank * local.size())],
+                      .peak_heap = all[(rank * local.size()) + 1],
+                      .allocated_per_run = all[(rank * local.size()) + 2]};
+  }
+  return per_rank;
+}
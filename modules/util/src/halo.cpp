@@ -0,0 +1,290 @@
+#include "util/include/halo.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/collectives.hpp"
+#include "util/include/distribution.hpp"
+
+namespace {
+
+/// Tag of a message travelling `row_step` blocks down and `col_step` blocks right, so a rank that is a neighbour on
+/// two sides still matches every message with its ghost region.
+int DirectionTag(int row_step, int col_step) {
+  return ((row_step + 1) * 3) + col_step + 1;
+}
+
+constexpr std::uint8_t SideBit(ppc::util::HaloSide side) {
+  return static_cast<std::uint8_t>(1U << static_cast<unsigned>(side));
+}
+
+int RankFor(int parts, MPI_Comm comm) {
+  int size = 0;
+  int rank = 0;
+  MPI_Comm_size(comm, &size);
+  MPI_Comm_rank(comm, &rank);
+  if (size != parts) {
+    throw std::invalid_argument(
+        std::format("The distribution has {} parts but the communicator has {} processes", parts, size));
+  }
+  return rank;
+}
+
+void CheckBufferSize(std::size_t actual, std::size_t expected) {
+  if (actual != expected) {
+    throw std::invalid_argument(std::format("The halo buffer holds {} elements instead of {}", actual, expected));
+  }
+}
+
+/// Checked on every rank for all blocks, so a bad width throws everywhere instead of leaving a neighbour waiting.
+void CheckGhostSource(std::size_t owned, std::size_t ghost, int part) {
+  if (owned < ghost) {
+    throw std::invalid_argument(
+        std::format("Block {} owns {} items but has to fill a ghost region of {}", part, owned, ghost));
+  }
+}
+
+void CheckWidths(const ppc::util::BlockDistribution &dist, ppc::util::HaloWidth width) {
+  for (int part = 0; part + 1 < dist.Parts(); part++) {
+    if (dist.Count(part) > 0 && dist.Count(part + 1) > 0) {
+      CheckGhostSource(dist.Count(part), width.before, part);
+      CheckGhostSource(dist.Count(part + 1), width.after, part + 1);
+    }
+  }
+}
+
+/// Part of the tile `row_step` grid rows down and `col_step` grid columns right of `part`, or -1 if there is no
+/// such tile or either of the two is empty.
+int NeighbourTile(const ppc::util::MatrixDistribution &dist, int part, int row_step, int col_step) {
+  const int grid_row = (part / dist.GridCols()) + row_step;
+  const int grid_col = (part % dist.GridCols()) + col_step;
+  if (grid_row < 0 || grid_row >= dist.GridRows() || grid_col < 0 || grid_col >= dist.GridCols()) {
+    return -1;
+  }
+  const int neighbour = (grid_row * dist.GridCols()) + grid_col;
+  return dist.LocalSize(part) > 0 && dist.LocalSize(neighbour) > 0 ? neighbour : -1;
+}
+
+void CheckWidths(const ppc::util::MatrixDistribution &dist, std::size_t width) {
+  for (int part = 0; part < dist.Parts(); part++) {
+    if (NeighbourTile(dist, part, -1, 0) >= 0 || NeighbourTile(dist, part, 1, 0) >= 0) {
+      CheckGhostSource(dist.LocalRows(part), width, part);
+    }
+    if (NeighbourTile(dist, part, 0, -1) >= 0 || NeighbourTile(dist, part, 0, 1) >= 0) {
+      CheckGhostSource(dist.LocalCols(part), width, part);
+    }
+  }
+}
+
+/// First padded row (or column) of the owned items sent towards `step` and of the ghosts received from there.
+std::size_t SendStart(int step, std::size_t owned, std::size_t width) {
+  return step > 0 ? owned : width;
+}
+
+std::size_t ReceiveStart(int step, std::size_t owned, std::size_t width) {
+  if (step == 0) {
+    return width;
+  }
+  return step < 0 ? 0 : width + owned;
+}
+
+}  // namespace
+
+namespace ppc::util {
+
+HaloExchange::Types::~Types() {
+  for (MPI_Datatype &type : types_) {
+    MPI_Type_free(&type);
+  }
+}
+
+MPI_Datatype HaloExchange::Types::Add(MPI_Datatype type) {
+  MPI_Type_commit(&type);
+  types_.push_back(type);
+  return type;
+}
+
+HaloExchange::HaloExchange(const BlockDistribution &dist, HaloWidth width, std::size_t unit, void *buffer,
+                           std::size_t size, MPI_Datatype type, MPI_Comm comm)
+    : buffer_(static_cast<std::byte *>(buffer)) {
+  // The widths depend on the distribution only, so a bad one throws on every rank before any other check
+  CheckWidths(dist, width);
+  const int rank = RankFor(dist.Parts(), comm);
+  CheckBufferSize(size, PaddedSize(dist, rank, width, unit));
+
+  const std::size_t owned = dist.Count(rank);
+  const int before = detail::CollectiveCount(width.before * unit);
+  const int after = detail::CollectiveCount(width.after * unit);
+
+  MPI_Aint lower_bound = 0;
+  MPI_Type_get_extent(type, &lower_bound, &extent_);
+  MPI_Datatype element = MPI_DATATYPE_NULL;
+  MPI_Type_dup(type, &element);
+  element = types_.Add(element);
+  MPI_Comm_dup(comm, &comm_);
+
+  if (HasNeighbour(dist, rank, HaloSide::kBefore)) {
+    // Our first items fill the ghosts after the previous block, its last ones the ghosts before ours
+    Link(rank - 1, DirectionTag(-1, 0), DirectionTag(1, 0),
+         {.offset = width.before * unit, .count = after, .type = element},
+         {.offset = 0, .count = before, .type = element});
+    sides_ |= SideBit(HaloSide::kBefore);
+  }
+  if (HasNeighbour(dist, rank, HaloSide::kAfter)) {
+    Link(rank + 1, DirectionTag(1, 0), DirectionTag(-1, 0), {.offset = owned * unit, .count = before, .type = element},
+         {.offset = (width.before + owned) * unit, .count = after, .type = element});
+    sides_ |= SideBit(HaloSide::kAfter);
+  }
+}
+
+HaloExchange::HaloExchange(const MatrixDistribution &dist, std::size_t width, HaloShape shape, void *buffer,
+                           std::size_t size, MPI_Datatype type, MPI_Comm comm)
+    : buffer_(static_cast<std::byte *>(buffer)) {
+  CheckWidths(dist, width);
+  const int rank = RankFor(dist.Parts(), comm);
+  CheckBufferSize(size, PaddedSize(dist, rank, width));
+
+  const std::size_t rows = dist.LocalRows(rank);
+  const std::size_t cols = dist.LocalCols(rank);
+  const std::size_t stride = cols + (2 * width);
+  const int int_stride = detail::CollectiveCount(stride);
+  const int int_rows = detail::CollectiveCount(rows);
+  const int int_cols = detail::CollectiveCount(cols);
+  const int int_width = detail::CollectiveCount(width);
+
+  MPI_Aint lower_bound = 0;
+  MPI_Type_get_extent(type, &lower_bound, &extent_);
+  MPI_Comm_dup(comm, &comm_);
+  for (HaloSide side : {HaloSide::kBefore, HaloSide::kAfter, HaloSide::kLeft, HaloSide::kRight}) {
+    if (HasNeighbour(dist, rank, side)) {
+      sides_ |= SideBit(side);
+    }
+  }
+  if (width == 0) {
+    return;
+  }
+
+  for (int row_step = -1; row_step <= 1; row_step++) {
+    for (int col_step = -1; col_step <= 1; col_step++) {
+      const bool corner = row_step != 0 && col_step != 0;
+      const int neighbour = NeighbourTile(dist, rank, row_step, col_step);
+      if ((row_step == 0 && col_step == 0) || (corner && shape == HaloShape::kFaces) || neighbour < 0) {
+        continue;
+      }
+      // The same rows x columns sub-block of the padded block is sent and received
+      MPI_Datatype block = MPI_DATATYPE_NULL;
+      MPI_Type_vector(row_step == 0 ? int_rows : int_width, col_step == 0 ? int_cols : int_width, int_stride, type,
+                      &block);
+      block = types_.Add(block);
+      const std::size_t send = (SendStart(row_step, rows, width) * stride) + SendStart(col_step, cols, width);
+      const std::size_t receive =
+          (ReceiveStart(row_step, rows, width) * stride) + ReceiveStart(col_step, cols, width);
+      Link(neighbour, DirectionTag(row_step, col_step), DirectionTag(-row_step, -col_step),
+           {.offset = send, .count = 1, .type = block}, {.offset = receive, .count = 1, .type = block});
+    }
+  }
+}
+
+HaloExchange::~HaloExchange() {
+  if (in_flight_) {
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+  }
+  for (MPI_Request &request : requests_) {
+    MPI_Request_free(&request);
+  }
+  MPI_Comm_free(&comm_);
+}
+
+std::size_t HaloExchange::PaddedSize(const BlockDistribution &dist, int part, HaloWidth width, std::size_t unit) {
+  return (width.before + dist.Count(part) + width.after) * unit;
+}
+
+std::size_t HaloExchange::PaddedSize(const MatrixDistribution &dist, int part, std::size_t width) {
+  return (dist.LocalRows(part) + (2 * width)) * (dist.LocalCols(part) + (2 * width));
+}
+
+void HaloExchange::Start() {
+  if (in_flight_) {
+    throw std::logic_error("The previous halo exchange has not finished");
+  }
+  if (!requests_.empty()) {
+    MPI_Startall(static_cast<int>(requests_.size()), requests_.data());
+  }
+  in_flight_ = true;
+}
+
+bool HaloExchange::Progress() {
+  if (in_flight_) {
+    int done = 0;
+    MPI_Testall(static_cast<int>(requests_.size()), requests_.data(), &done, MPI_STATUSES_IGNORE);
+    in_flight_ = done == 0;
+  }
+  return !in_flight_;
+}
+
+void HaloExchange::Finish() {
+  if (in_flight_) {
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+    in_flight_ = false;
+  }
+}
+
+void HaloExchange::Exchange() {
+  Start();
+  Finish();
+}
+
+bool HaloExchange::HasNeighbour(HaloSide side) const {
+  return (sides_ & SideBit(side)) != 0;
+}
+
+bool HaloExchange::HasNeighbour(const BlockDistribution &dist, int part, HaloSide side) {
+  if (dist.Count(part) == 0) {
+    return false;
+  }
+  switch (side) {
+    case HaloSide::kBefore:
+      return part > 0 && dist.Count(part - 1) > 0;
+    case HaloSide::kAfter:
+      return part + 1 < dist.Parts() && dist.Count(part + 1) > 0;
+    case HaloSide::kLeft:
+    case HaloSide::kRight:
+      return false;
+  }
+  return false;
+}
+
+bool HaloExchange::HasNeighbour(const MatrixDistribution &dist, int part, HaloSide side) {
+  switch (side) {
+    case HaloSide::kBefore:
+      return NeighbourTile(dist, part, -1, 0) >= 0;
+    case HaloSide::kAfter:
+      return NeighbourTile(dist, part, 1, 0) >= 0;
+    case HaloSide::kLeft:
+      return NeighbourTile(dist, part, 0, -1) >= 0;
+    case HaloSide::kRight:
+      return NeighbourTile(dist, part, 0, 1) >= 0;
+  }
+  return false;
+}
+
+void HaloExchange::Link(int neighbour, int send_tag, int receive_tag, Region send, Region receive) {
+  // Receives first, so an eager message finds its buffer posted
+  if (receive.count > 0) {
+    requests_.push_back(MPI_REQUEST_NULL);
+    MPI_Recv_init(buffer_ + (static_cast<MPI_Aint>(receive.offset) * extent_), receive.count, receive.type,
+                  neighbour, receive_tag, comm_, &requests_.back());
+  }
+  if (send.count > 0) {
+    requests_.push_back(MPI_REQUEST_NULL);
+    MPI_Send_init(buffer_ + (static_cast<MPI_Aint>(send.offset) * extent_), send.count, send.type, neighbour,
+                  send_tag, comm_, &requests_.back());
+  }
+}
+
+}  // namespace ppc::util
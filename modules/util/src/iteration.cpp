@@ -0,0 +1,189 @@
+#include "util/include/iteration.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/distribution.hpp"
+
+namespace {
+
+int RankFor(int parts, MPI_Comm comm) {
+  int size = 0;
+  int rank = 0;
+  MPI_Comm_size(comm, &size);
+  MPI_Comm_rank(comm, &rank);
+  if (size != parts) {
+    throw std::invalid_argument(
+        std::format("The distribution has {} parts but the communicator has {} processes", parts, size));
+  }
+  return rank;
+}
+
+void CheckVector(const ppc::util::BlockDistribution &dist, std::size_t size) {
+  if (size != dist.Total()) {
+    throw std::invalid_argument(std::format("The iterate holds {} elements instead of {}", size, dist.Total()));
+  }
+}
+
+}  // namespace
+
+namespace ppc::util {
+
+namespace detail {
+
+std::vector<int> SourcesWithBlocks(const BlockDistribution &dist, int rank, std::span<const int> candidates) {
+  std::vector<int> peers;
+  for (int peer : candidates) {
+    if (peer < 0 || peer >= dist.Parts()) {
+      throw std::invalid_argument(std::format("Source {} is not a rank of a communicator of {} processes", peer,
+                                              dist.Parts()));
+    }
+    if (peer != rank && dist.Count(peer) > 0) {
+      peers.push_back(peer);
+    }
+  }
+  std::ranges::sort(peers);
+  peers.erase(std::ranges::unique(peers).begin(), peers.end());
+  return peers;
+}
+
+}  // namespace detail
+
+IterationExchange::IterationExchange(const BlockDistribution &dist, void *vector, std::size_t size,
+                                     MPI_Datatype type, MPI_Comm comm, MPI_Op residual_op)
+    : residual_op_(residual_op) {
+  const int rank = RankFor(dist.Parts(), comm);
+  CheckVector(dist, size);
+  // Every rank reads every block that is not empty
+  std::vector<int> destinations;
+  for (int peer = 0; peer < dist.Parts(); peer++) {
+    if (peer != rank) {
+      if (dist.Count(peer) > 0) {
+        sources_.push_back(peer);
+      }
+      if (dist.Count(rank) > 0) {
+        destinations.push_back(peer);
+      }
+    }
+  }
+
+  MPI_Type_dup(type, &type_);
+  MPI_Comm_dup(comm, &comm_);
+  SetUp(dist, rank, destinations, vector);
+}
+
+IterationExchange::IterationExchange(const BlockDistribution &dist, std::span<const int> sources, void *vector,
+                                     std::size_t size, MPI_Datatype type, MPI_Comm comm, MPI_Op residual_op)
+    : residual_op_(residual_op) {
+  const int rank = RankFor(dist.Parts(), comm);
+  CheckVector(dist, size);
+  const std::vector<int> peers = detail::SourcesWithBlocks(dist, rank, sources);
+
+  // Each rank names the edges into itself; MPI works out the ranks that read our block
+  const std::vector<int> degrees(peers.size(), 1);
+  const std::vector<int> targets(peers.size(), rank);
+  MPI_Dist_graph_create(comm, static_cast<int>(peers.size()), peers.data(), degrees.data(), targets.data(),
+                        MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &comm_);
+  int indegree = 0;
+  int outdegree = 0;
+  int weighted = 0;
+  MPI_Dist_graph_neighbors_count(comm_, &indegree, &outdegree, &weighted);
+  sources_.resize(static_cast<std::size_t>(indegree));
+  std::vector<int> destinations(static_cast<std::size_t>(outdegree));
+  MPI_Dist_graph_neighbors(comm_, indegree, sources_.data(), MPI_UNWEIGHTED, outdegree, destinations.data(),
+                           MPI_UNWEIGHTED);
+
+  MPI_Type_dup(type, &type_);
+  SetUpNeighbours(dist, rank, vector);
+}
+
+IterationExchange::~IterationExchange() {
+  if (in_flight_) {
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+  }
+  for (MPI_Request &request : requests_) {
+    if (request != MPI_REQUEST_NULL) {
+      MPI_Request_free(&request);
+    }
+  }
+  MPI_Type_free(&type_);
+  MPI_Comm_free(&comm_);
+}
+
+void IterationExchange::SetUp(const BlockDistribution &dist, int rank, const std::vector<int> &destinations,
+                              void *vector) {
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type_, &lower_bound, &extent);
+  auto *elements = static_cast<std::byte *>(vector);
+  auto *own_block = elements + (static_cast<MPI_Aint>(dist.Offset(rank)) * extent);
+  const auto own_count = static_cast<int>(dist.Count(rank));
+
+  // The residual is reduced by an MPI_Iallreduce started in every Start(). The blocks travel on a private
+  // communicator, one per iteration and peer, so a single tag suffices.
+  constexpr int kTag = 0;
+  requests_.push_back(MPI_REQUEST_NULL);
+  for (int source : sources_) {
+    requests_.push_back(MPI_REQUEST_NULL);
+    MPI_Recv_init(elements + (static_cast<MPI_Aint>(dist.Offset(source)) * extent),
+                  static_cast<int>(dist.Count(source)), type_, source, kTag, comm_, &requests_.back());
+  }
+  for (int destination : destinations) {
+    requests_.push_back(MPI_REQUEST_NULL);
+    MPI_Send_init(own_block, own_count, type_, destination, kTag, comm_, &requests_.back());
+  }
+}
+
+void IterationExchange::SetUpNeighbours(const BlockDistribution &dist, int rank, void *vector) {
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type_, &lower_bound, &extent);
+  vector_ = vector;
+  own_block_ = static_cast<std::byte *>(vector) + (static_cast<MPI_Aint>(dist.Offset(rank)) * extent);
+  own_count_ = static_cast<int>(dist.Count(rank));
+  // Open MPI rejects null count arrays even on ranks without in-neighbours, so the arrays never stay empty
+  counts_.assign(std::max<std::size_t>(sources_.size(), 1), 0);
+  displacements_.assign(counts_.size(), 0);
+  for (std::size_t i = 0; i < sources_.size(); i++) {
+    counts_[i] = static_cast<int>(dist.Count(sources_[i]));
+    displacements_[i] = static_cast<int>(dist.Offset(sources_[i]));
+  }
+  neighbour_collective_ = true;
+  requests_.assign(2, MPI_REQUEST_NULL);
+}
+
+void IterationExchange::Start(double local_residual) {
+  if (in_flight_) {
+    throw std::logic_error("The previous iteration has not finished");
+  }
+  local_residual_ = local_residual;
+  MPI_Iallreduce(&local_residual_, &residual_, 1, MPI_DOUBLE, residual_op_, comm_, requests_.data());
+  if (neighbour_collective_) {
+    MPI_Ineighbor_allgatherv(own_block_, own_count_, type_, vector_, counts_.data(), displacements_.data(), type_,
+                             comm_, &requests_[1]);
+  } else if (requests_.size() > 1) {
+    MPI_Startall(static_cast<int>(requests_.size() - 1), requests_.data() + 1);
+  }
+  in_flight_ = true;
+}
+
+double IterationExchange::Finish() {
+  if (in_flight_) {
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+    in_flight_ = false;
+  }
+  return residual_;
+}
+
+double IterationExchange::Exchange(double local_residual) {
+  Start(local_residual);
+  return Finish();
+}
+
+}  // namespace ppc::util
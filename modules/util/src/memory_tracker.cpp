@@ -0,0 +1,277 @@
+#include "util/include/memory_tracker.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifndef _WIN32
+#  include <sys/resource.h>
+#endif
+
+#if defined(__has_feature)
+#  if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer) || __has_feature(thread_sanitizer)
+#    define PPC_SANITIZED_ALLOCATOR 1
+#  endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#  define PPC_SANITIZED_ALLOCATOR 1
+#endif
+
+// The replacements need the usable size of a block on free, which glibc provides
+#if defined(__GLIBC__) && !defined(PPC_SANITIZED_ALLOCATOR)
+#  define PPC_TRACK_HEAP 1
+#  include <malloc.h>
+#endif
+
+namespace {
+
+// Separate cache lines keep frequently allocating threads from invalidating each other's counters more than needed
+alignas(64) std::atomic<std::uint64_t> heap_allocations{0};
+alignas(64) std::atomic<std::uint64_t> heap_bytes_allocated{0};
+alignas(64) std::atomic<std::uint64_t> heap_bytes_in_use{0};
+alignas(64) std::atomic<std::uint64_t> heap_peak_bytes{0};
+
+// Every active HeapScope owns one slot and its own peak, so overlapping scopes never reset each other's peak
+constexpr int kScopeSlots = 64;
+struct alignas(64) ScopeSlot {
+  std::atomic<std::uint64_t> peak{0};
+};
+std::array<ScopeSlot, kScopeSlots> scope_slots;
+alignas(64) std::atomic<std::uint64_t> active_scopes{0};
+std::atomic<std::uint64_t> scope_overflows{0};
+
+/// Read with getenv because the first call may come from operator new, before main and before anything that
+/// allocates may run. Fixed for the life of the process, so every block is freed the way it was allocated.
+bool IsTrackingRequested() noexcept {
+  static const bool kRequested = [] {
+    const char *value = std::getenv("PPC_HEAP_TRACKING");  // NOLINT(concurrency-mt-unsafe)
+    return value != nullptr && std::atoi(value) != 0;      // NOLINT(cert-err34-c)
+  }();
+  return kRequested;
+}
+
+void RaisePeak(std::atomic<std::uint64_t> &peak_bytes, std::uint64_t bytes) {
+  auto peak = peak_bytes.load(std::memory_order_relaxed);
+  while (peak < bytes && !peak_bytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+  }
+}
+
+void CountAllocation(std::size_t bytes) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  heap_bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+  const auto in_use = heap_bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  RaisePeak(heap_peak_bytes, in_use);
+  for (auto scopes = active_scopes.load(std::memory_order_relaxed); scopes != 0; scopes &= scopes - 1) {
+    RaisePeak(scope_slots[std::countr_zero(scopes)].peak, in_use);
+  }
+}
+
+void CountDeallocation(std::size_t bytes) {
+  heap_bytes_in_use.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+#ifdef PPC_TRACK_HEAP
+// NOLINTBEGIN(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory,hicpp-no-malloc)
+void *TryAllocate(std::size_t size, std::size_t alignment) noexcept {
+  size = size == 0 ? 1 : size;
+  void *ptr = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    ptr = std::malloc(size);
+  } else if (posix_memalign(&ptr, alignment, size) != 0) {
+    ptr = nullptr;
+  }
+  if (ptr != nullptr && IsTrackingRequested()) {
+    CountAllocation(malloc_usable_size(ptr));
+  }
+  return ptr;
+}
+
+void *Allocate(std::size_t size, std::size_t alignment) {
+  while (true) {
+    if (void *ptr = TryAllocate(size, alignment)) {
+      return ptr;
+    }
+    auto *handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void Free(void *ptr) noexcept {
+  if (ptr != nullptr) {
+    if (IsTrackingRequested()) {
+      CountDeallocation(malloc_usable_size(ptr));
+    }
+    std::free(ptr);
+  }
+}
+// NOLINTEND(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory,hicpp-no-malloc)
+#endif
+
+}  // namespace
+
+#ifdef PPC_TRACK_HEAP
+// NOLINTBEGIN(misc-new-delete-overloads,cert-dcl54-cpp,hicpp-new-delete-operators)
+void *operator new(std::size_t size) {
+  return Allocate(size, alignof(std::max_align_t));
+}
+void *operator new[](std::size_t size) {
+  return Allocate(size, alignof(std::max_align_t));
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return TryAllocate(size, alignof(std::max_align_t));
+}
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return TryAllocate(size, alignof(std::max_align_t));
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  return TryAllocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  return TryAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+  Free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+  Free(ptr);
+}
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  Free(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  Free(ptr);
+}
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept {
+  Free(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept {
+  Free(ptr);
+}
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  Free(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  Free(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  Free(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  Free(ptr);
+}
+void operator delete(void *ptr, std::align_val_t /*alignment*/, const std::nothrow_t & /*tag*/) noexcept {
+  Free(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*alignment*/, const std::nothrow_t & /*tag*/) noexcept {
+  Free(ptr);
+}
+// NOLINTEND(misc-new-delete-overloads,cert-dcl54-cpp,hicpp-new-delete-operators)
+#endif
+
+namespace ppc::util {
+
+bool IsHeapTrackingEnabled() {
+  static const bool kEnabled = [] {
+    const auto before = heap_allocations.load();
+    // A direct call cannot be elided like a new-expression
+    void *probe = ::operator new(64);
+    const bool counted = heap_allocations.load() != before;
+    ::operator delete(probe);
+    return counted;
+  }();
+  return kEnabled;
+}
+
+HeapUsage GetHeapUsage() {
+  return {.allocations = heap_allocations.load(std::memory_order_relaxed),
+          .bytes_allocated = heap_bytes_allocated.load(std::memory_order_relaxed),
+          .bytes_in_use = heap_bytes_in_use.load(std::memory_order_relaxed),
+          .peak_bytes = heap_peak_bytes.load(std::memory_order_relaxed)};
+}
+
+void RecordHeapAllocation(std::size_t bytes) {
+  if (IsTrackingRequested()) {
+    CountAllocation(bytes);
+  }
+}
+
+void RecordHeapDeallocation(std::size_t bytes) {
+  if (IsTrackingRequested()) {
+    CountDeallocation(bytes);
+  }
+}
+
+std::uint64_t GetPeakRss() {
+#ifdef _WIN32
+  return 0;
+#else
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#  ifdef __APPLE__
+  return static_cast<std::uint64_t>(usage.ru_maxrss);
+#  else
+  return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#  endif
+#endif
+}
+
+HeapScope::HeapScope() : start_allocated_(heap_bytes_allocated.load(std::memory_order_relaxed)) {
+  if (!IsHeapTrackingEnabled()) {
+    return;
+  }
+  auto scopes = active_scopes.load(std::memory_order_relaxed);
+  int slot = 0;
+  do {
+    if (scopes == ~std::uint64_t{0}) {
+      // Measuring must not fail the code being measured, so the scope stays without a peak instead
+      scope_overflows.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    slot = std::countr_one(scopes);
+  } while (!active_scopes.compare_exchange_weak(scopes, scopes | (std::uint64_t{1} << slot),
+                                                std::memory_order_relaxed));
+  slot_ = slot;
+  // Released slots are zero, so allocations racing with the claim can only raise the peak, never hide one
+  RaisePeak(scope_slots[slot_].peak, heap_bytes_in_use.load(std::memory_order_relaxed));
+}
+
+HeapScope::~HeapScope() {
+  if (slot_ >= 0) {
+    scope_slots[slot_].peak.store(0, std::memory_order_relaxed);
+    active_scopes.fetch_and(~(std::uint64_t{1} << slot_), std::memory_order_relaxed);
+  }
+}
+
+std::uint64_t HeapScope::AllocatedBytes() const {
+  return heap_bytes_allocated.load(std::memory_order_relaxed) - start_allocated_;
+}
+
+std::uint64_t HeapScope::PeakBytes() const {
+  return slot_ >= 0 ? scope_slots[slot_].peak.load(std::memory_order_relaxed) : 0;
+}
+
+bool HeapScope::TracksPeak() const {
+  return slot_ >= 0;
+}
+
+std::uint64_t GetHeapScopeOverflows() {
+  return scope_overflows.load(std::memory_order_relaxed);
+}
+
+}  // namespace ppc::util
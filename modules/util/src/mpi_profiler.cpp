@@ -0,0 +1,754 @@
+#include "util/include/mpi_profiler.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "performance/include/comm_profile.hpp"
+#include "util/include/tracing.hpp"
+#include "util/include/util.hpp"
+
+#ifndef _WIN32
+#  include <cxxabi.h>
+#  include <dlfcn.h>
+
+#  include <cstdlib>
+#  include <filesystem>
+#  include <memory>
+#endif
+
+namespace {
+
+enum class Operation : uint8_t {
+  kSend,
+  kSsend,
+  kRecv,
+  kSendrecv,
+  kProbe,
+  kWait,
+  kWaitall,
+  kWaitany,
+  kWaitsome,
+  kBarrier,
+  kBcast,
+  kReduce,
+  kAllreduce,
+  kScan,
+  kGather,
+  kGatherv,
+  kScatter,
+  kScatterv,
+  kAllgather,
+  kAllgatherv,
+  kAlltoall,
+  kAlltoallv,
+  kAlltoallw,
+  kReduceScatter,
+  kNeighborAllgather,
+  kNeighborAllgatherv,
+  kNeighborAlltoall,
+  // Calls below only post or poll operations and do not count as blocked time
+  kIsend,
+  kIssend,
+  kIrecv,
+  kStart,
+  kStartall,
+  kTest,
+  kTestall,
+  kTestany,
+  kIbarrier,
+  kIbcast,
+  kIreduce,
+  kIallreduce,
+  kIgather,
+  kIgatherv,
+  kIscatter,
+  kIscatterv,
+  kIallgather,
+  kIallgatherv,
+  kIalltoall,
+  kIalltoallv,
+  kIneighborAllgather,
+  kIneighborAllgatherv,
+  kCount
+};
+
+constexpr std::size_t kNumOperations = static_cast<std::size_t>(Operation::kCount);
+
+bool IsBlocking(Operation op) {
+  return op < Operation::kIsend;
+}
+
+constexpr std::array<std::string_view, kNumOperations> kOperationNames = {
+    "Send", "Ssend", "Recv", "Sendrecv", "Probe", "Wait", "Waitall", "Waitany", "Waitsome", "Barrier", "Bcast",
+    "Reduce", "Allreduce", "Scan", "Gather", "Gatherv", "Scatter", "Scatterv", "Allgather", "Allgatherv", "Alltoall",
+    "Alltoallv", "Alltoallw", "Reduce_scatter", "Neighbor_allgather", "Neighbor_allgatherv", "Neighbor_alltoall",
+    "Isend", "Issend", "Irecv", "Start", "Startall", "Test", "Testall", "Testany", "Ibarrier", "Ibcast", "Ireduce",
+    "Iallreduce", "Igather", "Igatherv", "Iscatter", "Iscatterv", "Iallgather", "Iallgatherv", "Ialltoall",
+    "Ialltoallv", "Ineighbor_allgather", "Ineighbor_allgatherv"};
+
+/// Number of call sites kept in a collected profile.
+constexpr std::size_t kMaxCallSites = 10;
+
+struct Totals {
+  uint64_t calls = 0;
+  uint64_t bytes = 0;
+  double time = 0.0;
+
+  void Add(uint64_t call_bytes, double duration) {
+    calls++;
+    bytes += call_bytes;
+    time += duration;
+  }
+};
+
+std::atomic<double> blocked_time{0.0};
+std::atomic<bool> profiling{false};
+std::mutex profile_mutex;
+std::array<Totals, kNumOperations> operation_totals;
+std::map<std::pair<Operation, const void *>, Totals> call_site_totals;
+/// Payload of the persistent requests, counted at every MPI_Start(all) of them.
+std::mutex persistent_mutex;
+std::map<MPI_Request, uint64_t> persistent_bytes;
+
+std::string DescribeCallSite(const void *caller) {
+  std::stringstream site;
+#ifndef _WIN32
+  Dl_info info{};
+  if (dladdr(caller, &info) != 0) {
+    if (info.dli_sname != nullptr) {
+      int status = 0;
+      const std::unique_ptr<char, decltype(&std::free)> demangled(
+          abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free);
+      site << (status == 0 && demangled ? demangled.get() : info.dli_sname) << "+0x" << std::hex
+           << (static_cast<const char *>(caller) - static_cast<const char *>(info.dli_saddr));
+      return site.str();
+    }
+    if (info.dli_fname != nullptr) {
+      // Module-relative offsets are stable across processes and can be resolved with addr2line
+      site << std::filesystem::path(info.dli_fname).filename().string() << "+0x" << std::hex
+           << (static_cast<const char *>(caller) - static_cast<const char *>(info.dli_fbase));
+      return site.str();
+    }
+  }
+#endif
+  site << caller;
+  return site.str();
+}
+
+bool ByTimeDescending(const ppc::performance::CommStats &lhs, const ppc::performance::CommStats &rhs) {
+  return lhs.time > rhs.time;
+}
+
+}  // namespace
+
+double ppc::util::GetMPIBlockedTime() {
+  return blocked_time.load(std::memory_order_relaxed);
+}
+
+bool ppc::util::MeasuresMPIBlockedTime() {
+#ifdef _WIN32
+  return false;
+#else
+  return true;
+#endif
+}
+
+void ppc::util::SetMPIProfiling(bool enabled) {
+  profiling.store(enabled, std::memory_order_relaxed);
+}
+
+ppc::performance::CommProfile ppc::util::CollectMPIProfile() {
+  std::array<uint64_t, kNumOperations> calls{};
+  std::array<uint64_t, kNumOperations> bytes{};
+  std::array<double, kNumOperations> times{};
+  std::vector<ppc::performance::CommStats> call_sites;
+  {
+    const std::scoped_lock lock(profile_mutex);
+    for (std::size_t i = 0; i < kNumOperations; i++) {
+      calls[i] = operation_totals[i].calls;
+      bytes[i] = operation_totals[i].bytes;
+      times[i] = operation_totals[i].time;
+    }
+    for (const auto &[key, totals] : call_site_totals) {
+      call_sites.push_back({.operation = std::string(kOperationNames[static_cast<std::size_t>(key.first)]),
+                            .call_site = DescribeCallSite(key.second),
+                            .calls = totals.calls,
+                            .bytes = totals.bytes,
+                            .time = totals.time});
+    }
+    operation_totals = {};
+    call_site_totals.clear();
+  }
+
+  // PMPI directly, so collecting the profile does not show up in it
+  PMPI_Allreduce(MPI_IN_PLACE, calls.data(), static_cast<int>(kNumOperations), MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+  PMPI_Allreduce(MPI_IN_PLACE, bytes.data(), static_cast<int>(kNumOperations), MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+  PMPI_Allreduce(MPI_IN_PLACE, times.data(), static_cast<int>(kNumOperations), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  ppc::performance::CommProfile profile;
+  for (std::size_t i = 0; i < kNumOperations; i++) {
+    if (calls[i] > 0) {
+      profile.operations.push_back({.operation = std::string(kOperationNames[i]),
+                                    .call_site = {},
+                                    .calls = calls[i],
+                                    .bytes = bytes[i],
+                                    .time = times[i]});
+    }
+  }
+  std::ranges::sort(profile.operations, ByTimeDescending);
+
+  int rank = -1;
+  PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    std::ranges::sort(call_sites, ByTimeDescending);
+    call_sites.resize(std::min(call_sites.size(), kMaxCallSites));
+    profile.call_sites = std::move(call_sites);
+  }
+  return profile;
+}
+
+// MS-MPI exports the MPI entry points with its own calling convention and no weak aliases, so the
+// wrappers are only provided where the profiling interface can be interposed portably.
+#ifndef _WIN32
+
+namespace {
+
+void Record(Operation op, const void *caller, uint64_t bytes, double duration) {
+  const std::scoped_lock lock(profile_mutex);
+  operation_totals[static_cast<std::size_t>(op)].Add(bytes, duration);
+  call_site_totals[{op, caller}].Add(bytes, duration);
+}
+
+/// PPC_PERF_MPI_PROFILE, read on the first intercepted call. Only the per-operation and per-call-site totals depend
+/// on it; the blocked time of the blocking calls is always accumulated.
+bool IsProfiling() {
+  static const bool kEnabled = ppc::util::GetPerfMpiProfile();
+  return kEnabled && profiling.load(std::memory_order_relaxed);
+}
+
+template <typename Bytes, typename Call>
+int Measure(Operation op, const void *caller, Bytes &&bytes, Call &&call) {
+  const bool blocking = IsBlocking(op);
+  const bool tracing = ppc::util::IsTracingEnabled();
+  if (!blocking && !tracing && !IsProfiling()) {
+    return call();
+  }
+  const auto trace_begin = tracing ? ppc::util::TraceClock() : 0;
+  const double begin = PMPI_Wtime();
+  const int result = call();
+  const double duration = PMPI_Wtime() - begin;
+  if (blocking) {
+    blocked_time.fetch_add(duration, std::memory_order_relaxed);
+  }
+  if (tracing) {
+    // The operation names are string literals, so the views are null-terminated
+    ppc::util::RecordTraceEvent(kOperationNames[static_cast<std::size_t>(op)].data(), "mpi", trace_begin,
+                                ppc::util::TraceClock(), bytes());
+  }
+  if (IsProfiling()) {
+    Record(op, caller, bytes(), duration);
+  }
+  return result;
+}
+
+uint64_t PayloadBytes(int count, MPI_Datatype datatype) {
+  if (count <= 0) {
+    return 0;
+  }
+  int type_size = 0;
+  PMPI_Type_size(datatype, &type_size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(std::max(type_size, 0));
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 1;
+  PMPI_Comm_size(comm, &size);
+  return size;
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = -1;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+uint64_t PayloadBytes(const int counts[], int parts, MPI_Datatype datatype) {
+  uint64_t total = 0;
+  for (int i = 0; i < parts; i++) {
+    total += PayloadBytes(counts[i], datatype);
+  }
+  return total;
+}
+
+uint64_t PayloadBytes(const int counts[], MPI_Comm comm, MPI_Datatype datatype) {
+  return PayloadBytes(counts, CommSize(comm), datatype);
+}
+
+/// Number of processes a neighbourhood collective on `comm` receives from and sends to.
+std::pair<int, int> NeighbourCounts(MPI_Comm comm) {
+  int topology = MPI_UNDEFINED;
+  PMPI_Topo_test(comm, &topology);
+  if (topology == MPI_DIST_GRAPH) {
+    int indegree = 0;
+    int outdegree = 0;
+    int weighted = 0;
+    PMPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted);
+    return {indegree, outdegree};
+  }
+  if (topology == MPI_CART) {
+    int dims = 0;
+    PMPI_Cartdim_get(comm, &dims);
+    return {2 * dims, 2 * dims};
+  }
+  if (topology == MPI_GRAPH) {
+    int rank = 0;
+    int neighbours = 0;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Graph_neighbors_count(comm, rank, &neighbours);
+    return {neighbours, neighbours};
+  }
+  return {0, 0};
+}
+
+/// Remembers the payload of a persistent request created by a successful call.
+int RegisterPersistent(int result, const MPI_Request *request, uint64_t bytes) {
+  if (result == MPI_SUCCESS) {
+    const std::scoped_lock lock(persistent_mutex);
+    persistent_bytes[*request] = bytes;
+  }
+  return result;
+}
+
+uint64_t PersistentBytes(int count, const MPI_Request requests[]) {
+  uint64_t total = 0;
+  const std::scoped_lock lock(persistent_mutex);
+  for (int i = 0; i < count; i++) {
+    const auto it = persistent_bytes.find(requests[i]);
+    total += it == persistent_bytes.end() ? 0 : it->second;
+  }
+  return total;
+}
+
+}  // namespace
+
+extern "C" {
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return Measure(Operation::kSend, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Send(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Ssend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return Measure(Operation::kSsend, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Ssend(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  return Measure(Operation::kRecv, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Recv(buf, count, datatype, source, tag, comm, status); });
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  return Measure(
+      Operation::kSendrecv, __builtin_return_address(0),
+      [&] { return PayloadBytes(sendcount, sendtype) + PayloadBytes(recvcount, recvtype); },
+      [&] {
+        return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source,
+                             recvtag, comm, status);
+      });
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  return Measure(Operation::kProbe, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Probe(source, tag, comm, status); });
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  return Measure(Operation::kWait, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Wait(request, status); });
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status *array_of_statuses) {
+  return Measure(Operation::kWaitall, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Waitall(count, array_of_requests, array_of_statuses); });
+}
+
+int MPI_Waitany(int count, MPI_Request array_of_requests[], int *index, MPI_Status *status) {
+  return Measure(Operation::kWaitany, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Waitany(count, array_of_requests, index, status); });
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  return Measure(Operation::kBarrier, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Barrier(comm); });
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  return Measure(Operation::kBcast, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Bcast(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  return Measure(Operation::kReduce, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm); });
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  return Measure(Operation::kAllreduce, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  return Measure(Operation::kScan, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Scan(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  return Measure(
+      Operation::kGather, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm))
+                                  : PayloadBytes(sendcount, sendtype);
+      },
+      [&] { return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm); });
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  return Measure(
+      Operation::kGatherv, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(recvcounts, comm, recvtype) : PayloadBytes(sendcount, sendtype);
+      },
+      [&] { return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm); });
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  return Measure(
+      Operation::kScatter, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(sendcount, sendtype) * static_cast<uint64_t>(CommSize(comm))
+                                  : PayloadBytes(recvcount, recvtype);
+      },
+      [&] { return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm); });
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  return Measure(
+      Operation::kScatterv, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(sendcounts, comm, sendtype) : PayloadBytes(recvcount, recvtype);
+      },
+      [&] {
+        return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+      });
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  return Measure(
+      Operation::kAllgather, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm)); },
+      [&] { return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm); });
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  return Measure(
+      Operation::kAllgatherv, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcounts, comm, recvtype); },
+      [&] { return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm); });
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  return Measure(
+      Operation::kAlltoall, __builtin_return_address(0),
+      [&] { return PayloadBytes(sendcount, sendtype) * static_cast<uint64_t>(CommSize(comm)); },
+      [&] { return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm); });
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  return Measure(
+      Operation::kAlltoallv, __builtin_return_address(0), [&] { return PayloadBytes(sendcounts, comm, sendtype); },
+      [&] {
+        return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+      });
+}
+
+int MPI_Alltoallw(const void *sendbuf, const int sendcounts[], const int sdispls[], const MPI_Datatype sendtypes[],
+                  void *recvbuf, const int recvcounts[], const int rdispls[], const MPI_Datatype recvtypes[],
+                  MPI_Comm comm) {
+  return Measure(
+      Operation::kAlltoallw, __builtin_return_address(0),
+      [&] {
+        uint64_t total = 0;
+        const int size = CommSize(comm);
+        for (int i = 0; i < size; i++) {
+          total += PayloadBytes(sendcounts[i], sendtypes[i]);
+        }
+        return total;
+      },
+      [&] {
+        return PMPI_Alltoallw(sendbuf, sendcounts, sdispls, sendtypes, recvbuf, recvcounts, rdispls, recvtypes, comm);
+      });
+}
+
+int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts[], MPI_Datatype datatype, MPI_Op op,
+                       MPI_Comm comm) {
+  return Measure(
+      Operation::kReduceScatter, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcounts, comm, datatype); },
+      [&] { return PMPI_Reduce_scatter(sendbuf, recvbuf, recvcounts, datatype, op, comm); });
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return Measure(Operation::kIsend, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Isend(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Issend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+               MPI_Request *request) {
+  return Measure(Operation::kIssend, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Issend(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Request *request) {
+  return Measure(Operation::kIrecv, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Irecv(buf, count, datatype, source, tag, comm, request); });
+}
+
+// Creating a persistent request moves no data; its payload is counted whenever it is started
+int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+                  MPI_Request *request) {
+  return RegisterPersistent(PMPI_Send_init(buf, count, datatype, dest, tag, comm, request), request,
+                            PayloadBytes(count, datatype));
+}
+
+int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                  MPI_Request *request) {
+  return RegisterPersistent(PMPI_Recv_init(buf, count, datatype, source, tag, comm, request), request,
+                            PayloadBytes(count, datatype));
+}
+
+int MPI_Start(MPI_Request *request) {
+  return Measure(Operation::kStart, __builtin_return_address(0), [&] { return PersistentBytes(1, request); },
+                 [&] { return PMPI_Start(request); });
+}
+
+int MPI_Startall(int count, MPI_Request array_of_requests[]) {
+  return Measure(Operation::kStartall, __builtin_return_address(0),
+                 [&] { return PersistentBytes(count, array_of_requests); },
+                 [&] { return PMPI_Startall(count, array_of_requests); });
+}
+
+int MPI_Request_free(MPI_Request *request) {
+  {
+    const std::scoped_lock lock(persistent_mutex);
+    persistent_bytes.erase(*request);
+  }
+  return PMPI_Request_free(request);
+}
+
+int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status) {
+  return Measure(Operation::kTest, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Test(request, flag, status); });
+}
+
+int MPI_Testall(int count, MPI_Request array_of_requests[], int *flag, MPI_Status array_of_statuses[]) {
+  return Measure(Operation::kTestall, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Testall(count, array_of_requests, flag, array_of_statuses); });
+}
+
+int MPI_Testany(int count, MPI_Request array_of_requests[], int *index, int *flag, MPI_Status *status) {
+  return Measure(Operation::kTestany, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Testany(count, array_of_requests, index, flag, status); });
+}
+
+int MPI_Waitsome(int incount, MPI_Request array_of_requests[], int *outcount, int array_of_indices[],
+                 MPI_Status array_of_statuses[]) {
+  return Measure(Operation::kWaitsome, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Waitsome(incount, array_of_requests, outcount, array_of_indices, array_of_statuses); });
+}
+
+int MPI_Ibarrier(MPI_Comm comm, MPI_Request *request) {
+  return Measure(Operation::kIbarrier, __builtin_return_address(0), [] { return uint64_t{0}; },
+                 [&] { return PMPI_Ibarrier(comm, request); });
+}
+
+int MPI_Ibcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Request *request) {
+  return Measure(Operation::kIbcast, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Ibcast(buffer, count, datatype, root, comm, request); });
+}
+
+int MPI_Ireduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+                MPI_Comm comm, MPI_Request *request) {
+  return Measure(Operation::kIreduce, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Ireduce(sendbuf, recvbuf, count, datatype, op, root, comm, request); });
+}
+
+int MPI_Iallreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request *request) {
+  return Measure(Operation::kIallreduce, __builtin_return_address(0), [&] { return PayloadBytes(count, datatype); },
+                 [&] { return PMPI_Iallreduce(sendbuf, recvbuf, count, datatype, op, comm, request); });
+}
+
+int MPI_Igather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIgather, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm))
+                                  : PayloadBytes(sendcount, sendtype);
+      },
+      [&] {
+        return PMPI_Igather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm, request);
+      });
+}
+
+int MPI_Igatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                 const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIgatherv, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(recvcounts, comm, recvtype) : PayloadBytes(sendcount, sendtype);
+      },
+      [&] {
+        return PMPI_Igatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm,
+                             request);
+      });
+}
+
+int MPI_Iscatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIscatter, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(sendcount, sendtype) * static_cast<uint64_t>(CommSize(comm))
+                                  : PayloadBytes(recvcount, recvtype);
+      },
+      [&] {
+        return PMPI_Iscatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm, request);
+      });
+}
+
+int MPI_Iscatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                  void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIscatterv, __builtin_return_address(0),
+      [&] {
+        return IsRoot(root, comm) ? PayloadBytes(sendcounts, comm, sendtype) : PayloadBytes(recvcount, recvtype);
+      },
+      [&] {
+        return PMPI_Iscatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm,
+                              request);
+      });
+}
+
+int MPI_Iallgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                   MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIallgather, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm)); },
+      [&] { return PMPI_Iallgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm, request); });
+}
+
+int MPI_Iallgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                    const int displs[], MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIallgatherv, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcounts, comm, recvtype); },
+      [&] {
+        return PMPI_Iallgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm, request);
+      });
+}
+
+int MPI_Ialltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIalltoall, __builtin_return_address(0),
+      [&] { return PayloadBytes(sendcount, sendtype) * static_cast<uint64_t>(CommSize(comm)); },
+      [&] { return PMPI_Ialltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm, request); });
+}
+
+int MPI_Ialltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                   void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm,
+                   MPI_Request *request) {
+  return Measure(
+      Operation::kIalltoallv, __builtin_return_address(0), [&] { return PayloadBytes(sendcounts, comm, sendtype); },
+      [&] {
+        return PMPI_Ialltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm,
+                               request);
+      });
+}
+
+int MPI_Neighbor_allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                           MPI_Datatype recvtype, MPI_Comm comm) {
+  return Measure(
+      Operation::kNeighborAllgather, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcount, recvtype) * static_cast<uint64_t>(NeighbourCounts(comm).first); },
+      [&] { return PMPI_Neighbor_allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm); });
+}
+
+int MPI_Neighbor_allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf,
+                            const int recvcounts[], const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  return Measure(
+      Operation::kNeighborAllgatherv, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcounts, NeighbourCounts(comm).first, recvtype); },
+      [&] {
+        return PMPI_Neighbor_allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+      });
+}
+
+int MPI_Neighbor_alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                          MPI_Datatype recvtype, MPI_Comm comm) {
+  return Measure(
+      Operation::kNeighborAlltoall, __builtin_return_address(0),
+      [&] { return PayloadBytes(sendcount, sendtype) * static_cast<uint64_t>(NeighbourCounts(comm).second); },
+      [&] { return PMPI_Neighbor_alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm); });
+}
+
+int MPI_Ineighbor_allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                            MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  return Measure(
+      Operation::kIneighborAllgather, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcount, recvtype) * static_cast<uint64_t>(NeighbourCounts(comm).first); },
+      [&] {
+        return PMPI_Ineighbor_allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm, request);
+      });
+}
+
+int MPI_Ineighbor_allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf,
+                             const int recvcounts[], const int displs[], MPI_Datatype recvtype, MPI_Comm comm,
+                             MPI_Request *request) {
+  return Measure(
+      Operation::kIneighborAllgatherv, __builtin_return_address(0),
+      [&] { return PayloadBytes(recvcounts, NeighbourCounts(comm).first, recvtype); },
+      [&] {
+        return PMPI_Ineighbor_allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm,
+                                         request);
+      });
+}
+
+}  // extern "C"
+
+#endif  // _WIN32
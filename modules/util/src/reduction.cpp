@@ -0,0 +1,82 @@
+#include "util/include/reduction.hpp"
+
+#include <mpi.h>
+
+#include <cstdint>
+
+namespace {
+
+template <typename Op>
+constexpr Op kOperator{};
+
+/// Sets `reduction` to the compiled kernel for T if `type` is `candidate`.
+template <typename Op, typename T>
+bool Match(MPI_Datatype type, MPI_Datatype candidate, ppc::util::Reduction &reduction) {
+  if (type != candidate) {
+    return false;
+  }
+  reduction = ppc::util::MakeReduction<T>(kOperator<Op>);
+  return true;
+}
+
+template <typename Op>
+ppc::util::Reduction IntegerReduction(MPI_Datatype type) {
+  ppc::util::Reduction reduction;
+  (void)(Match<Op, int>(type, MPI_INT, reduction) || Match<Op, unsigned>(type, MPI_UNSIGNED, reduction) ||
+         Match<Op, long>(type, MPI_LONG, reduction) || Match<Op, unsigned long>(type, MPI_UNSIGNED_LONG, reduction) ||
+         Match<Op, long long>(type, MPI_LONG_LONG, reduction) ||
+         Match<Op, unsigned long long>(type, MPI_UNSIGNED_LONG_LONG, reduction) ||
+         Match<Op, short>(type, MPI_SHORT, reduction) ||
+         Match<Op, unsigned short>(type, MPI_UNSIGNED_SHORT, reduction) ||
+         Match<Op, signed char>(type, MPI_SIGNED_CHAR, reduction) ||
+         Match<Op, unsigned char>(type, MPI_UNSIGNED_CHAR, reduction) ||
+         Match<Op, std::int8_t>(type, MPI_INT8_T, reduction) || Match<Op, std::uint8_t>(type, MPI_UINT8_T, reduction) ||
+         Match<Op, std::int16_t>(type, MPI_INT16_T, reduction) ||
+         Match<Op, std::uint16_t>(type, MPI_UINT16_T, reduction) ||
+         Match<Op, std::int32_t>(type, MPI_INT32_T, reduction) ||
+         Match<Op, std::uint32_t>(type, MPI_UINT32_T, reduction) ||
+         Match<Op, std::int64_t>(type, MPI_INT64_T, reduction) ||
+         Match<Op, std::uint64_t>(type, MPI_UINT64_T, reduction));
+  return reduction;
+}
+
+template <typename Op>
+ppc::util::Reduction ArithmeticReduction(MPI_Datatype type) {
+  ppc::util::Reduction reduction;
+  if (Match<Op, double>(type, MPI_DOUBLE, reduction) || Match<Op, float>(type, MPI_FLOAT, reduction) ||
+      Match<Op, long double>(type, MPI_LONG_DOUBLE, reduction)) {
+    return reduction;
+  }
+  return IntegerReduction<Op>(type);
+}
+
+}  // namespace
+
+namespace ppc::util {
+
+Reduction PredefinedReduction(MPI_Op op, MPI_Datatype type) {
+  if (op == MPI_SUM) {
+    return ArithmeticReduction<Sum>(type);
+  }
+  if (op == MPI_PROD) {
+    return ArithmeticReduction<Prod>(type);
+  }
+  if (op == MPI_MIN) {
+    return ArithmeticReduction<Min>(type);
+  }
+  if (op == MPI_MAX) {
+    return ArithmeticReduction<Max>(type);
+  }
+  if (op == MPI_BAND) {
+    return IntegerReduction<BitAnd>(type);
+  }
+  if (op == MPI_BOR) {
+    return IntegerReduction<BitOr>(type);
+  }
+  if (op == MPI_BXOR) {
+    return IntegerReduction<BitXor>(type);
+  }
+  return {};
+}
+
+}  // namespace ppc::util
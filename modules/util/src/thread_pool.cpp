@@ -0,0 +1,166 @@
+#include "util/include/thread_pool.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "util/include/topology.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+// Lets jobs submitted from a worker land on that worker's own deque
+thread_local const ppc::util::ThreadPool *current_pool = nullptr;
+thread_local std::size_t current_queue = 0;
+
+// Set once ThreadPool::Global() has constructed the framework pool
+std::atomic<bool> global_created{false};
+
+void ReleaseOpenMPThreads() {
+#if _OPENMP >= 201811
+  omp_pause_resource_all(omp_pause_soft);
+#endif
+}
+
+}  // namespace
+
+namespace ppc::util {
+
+ThreadPool::ThreadPool(int num_threads) {
+  const auto count = static_cast<std::size_t>(std::max(num_threads, 1));
+  queues_.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    queues_.push_back(std::make_unique<JobQueue>());
+  }
+  threads_.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    threads_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stop_ = true;
+    paused_ = false;
+  }
+  wake_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+ThreadPool &ThreadPool::Global() {
+  static ThreadPool pool(GetNumThreads());
+  [[maybe_unused]] static const bool kCreated = [] {
+    global_created.store(true, std::memory_order_release);
+    return true;
+  }();
+  return pool;
+}
+
+void ThreadPool::PauseIfCreated() {
+  if (global_created.load(std::memory_order_acquire)) {
+    Global().Pause();
+  } else {
+    ReleaseOpenMPThreads();
+  }
+}
+
+int ThreadPool::DefaultChunks() {
+  return GetNumThreads();
+}
+
+void ThreadPool::Push(Job job) {
+  const std::size_t queue =
+      current_pool == this ? current_queue : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  {
+    std::lock_guard lock(queues_[queue]->mutex);
+    queues_[queue]->jobs.push_back(std::move(job));
+  }
+  {
+    // Taking the lock orders the increment with a worker that is about to sleep, so the wakeup is not lost
+    std::lock_guard lock(sleep_mutex_);
+    pending_.fetch_add(1, std::memory_order_release);
+  }
+  wake_.notify_one();
+}
+
+bool ThreadPool::TryRunOne(std::size_t first_queue) {
+  if (pending_.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  Job job;
+  for (std::size_t k = 0; k < queues_.size() && !job; k++) {
+    auto &queue = *queues_[(first_queue + k) % queues_.size()];
+    std::lock_guard lock(queue.mutex);
+    if (queue.jobs.empty()) {
+      continue;
+    }
+    // The owner works LIFO for locality, thieves take the oldest job
+    if (k == 0 && current_pool == this) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    } else {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+  }
+  if (!job) {
+    return false;
+  }
+  pending_.fetch_sub(1, std::memory_order_acq_rel);
+  job();
+  return true;
+}
+
+void ThreadPool::WorkerLoop(std::size_t index) {
+  current_pool = this;
+  current_queue = index;
+  // Slot 0 belongs to the thread that owns the pool, usually the main thread
+  PinWorkerThread(static_cast<int>(index) + 1);
+  while (true) {
+    if (!paused_.load() && TryRunOne(index)) {
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stop_ || (!paused_.load() && pending_.load() > 0); });
+    if (stop_ && pending_.load() == 0) {
+      return;
+    }
+  }
+}
+
+void ThreadPool::Wait(const std::function<bool()> &done) {
+  const std::size_t first_queue = current_pool == this ? current_queue : 0;
+  while (!done()) {
+    if (!TryRunOne(first_queue)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void ThreadPool::Pause() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    paused_ = true;
+  }
+  ReleaseOpenMPThreads();
+}
+
+void ThreadPool::Resume() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    paused_ = false;
+  }
+  wake_.notify_all();
+}
+
+}  // namespace ppc::util
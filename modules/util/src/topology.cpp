@@ -0,0 +1,376 @@
+#include "util/include/topology.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#  include <sched.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <cstdint>
+#endif
+
+namespace {
+
+std::atomic<int> affinity_slot_offset{0};
+
+std::string ReadFirstLine(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+int ReadInt(const std::filesystem::path &path, int fallback) {
+  const auto line = ReadFirstLine(path);
+  if (line.empty() || std::isdigit(static_cast<unsigned char>(line[0])) == 0) {
+    return fallback;
+  }
+  return std::stoi(line);
+}
+
+/// Parses sysfs CPU lists such as "0-3,8,10-11".
+std::vector<int> ParseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::size_t pos = 0;
+  while (pos < list.size()) {
+    auto end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    const auto range = list.substr(pos, end - pos);
+    const auto dash = range.find('-');
+    if (!range.empty() && std::isdigit(static_cast<unsigned char>(range[0])) != 0) {
+      const int first = std::stoi(range);
+      const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++) {
+        cpus.push_back(cpu);
+      }
+    }
+    pos = end + 1;
+  }
+  return cpus;
+}
+
+/// Parses cache sizes such as "32K" or "16M".
+std::size_t ParseCacheSize(const std::string &text) {
+  if (text.empty() || std::isdigit(static_cast<unsigned char>(text[0])) == 0) {
+    return 0;
+  }
+  std::size_t size = std::stoull(text);
+  switch (text.back()) {
+    case 'K':
+      size *= 1024;
+      break;
+    case 'M':
+      size *= std::size_t{1024} * 1024;
+      break;
+    case 'G':
+      size *= std::size_t{1024} * 1024 * 1024;
+      break;
+    default:
+      break;
+  }
+  return size;
+}
+
+bool IsCpuDirectory(const std::string &name) {
+  return name.size() > 3 && name.starts_with("cpu") &&
+         std::all_of(name.begin() + 3, name.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+}
+
+std::vector<ppc::util::CacheInfo> ReadCaches(const std::filesystem::path &cpu_dir) {
+  std::vector<ppc::util::CacheInfo> caches;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(cpu_dir / "cache", ec)) {
+    if (!entry.path().filename().string().starts_with("index")) {
+      continue;
+    }
+    ppc::util::CacheInfo cache;
+    cache.level = ReadInt(entry.path() / "level", 0);
+    cache.type = ReadFirstLine(entry.path() / "type");
+    cache.size_bytes = ParseCacheSize(ReadFirstLine(entry.path() / "size"));
+    cache.shared_cpus =
+        std::max(1, static_cast<int>(ParseCpuList(ReadFirstLine(entry.path() / "shared_cpu_list")).size()));
+    caches.push_back(cache);
+  }
+  std::ranges::sort(caches,
+                    [](const auto &a, const auto &b) { return std::tie(a.level, a.type) < std::tie(b.level, b.type); });
+  return caches;
+}
+
+ppc::util::CpuTopology FallbackTopology() {
+  ppc::util::CpuTopology topology;
+  const int count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for (int cpu = 0; cpu < count; cpu++) {
+    topology.cpus.push_back({.id = cpu, .core = cpu, .socket = 0, .numa_node = 0});
+  }
+  return topology;
+}
+
+/// Position of every CPU in the placement order of a policy.
+std::vector<ppc::util::LogicalCpu> OrderCpus(const ppc::util::CpuTopology &topology,
+                                             ppc::util::AffinityPolicy policy) {
+  struct Key {
+    int smt = 0;
+    int core_rank = 0;
+  };
+  // Rank cores within their socket and hardware threads within their core
+  std::map<std::pair<int, int>, std::vector<int>> core_threads;
+  for (const auto &cpu : topology.cpus) {
+    core_threads[{cpu.socket, cpu.core}].push_back(cpu.id);
+  }
+  std::map<int, Key> keys;
+  std::map<int, int> cores_in_socket;
+  for (const auto &[core, threads] : core_threads) {
+    const int core_rank = cores_in_socket[core.first]++;
+    for (std::size_t smt = 0; smt < threads.size(); smt++) {
+      keys[threads[smt]] = {.smt = static_cast<int>(smt), .core_rank = core_rank};
+    }
+  }
+
+  auto cpus = topology.cpus;
+  std::ranges::stable_sort(cpus, [&](const auto &a, const auto &b) {
+    const auto &ka = keys[a.id];
+    const auto &kb = keys[b.id];
+    if (policy == ppc::util::AffinityPolicy::kScatter) {
+      return std::tie(ka.smt, ka.core_rank, a.socket) < std::tie(kb.smt, kb.core_rank, b.socket);
+    }
+    return std::tie(a.socket, ka.core_rank, ka.smt) < std::tie(b.socket, kb.core_rank, kb.smt);
+  });
+  return cpus;
+}
+
+}  // namespace
+
+namespace ppc::util {
+
+int CpuTopology::NumSockets() const {
+  std::set<int> sockets;
+  for (const auto &cpu : cpus) {
+    sockets.insert(cpu.socket);
+  }
+  return std::max(1, static_cast<int>(sockets.size()));
+}
+
+int CpuTopology::NumCores() const {
+  std::set<std::pair<int, int>> cores;
+  for (const auto &cpu : cpus) {
+    cores.insert({cpu.socket, cpu.core});
+  }
+  return std::max(1, static_cast<int>(cores.size()));
+}
+
+int CpuTopology::NumNumaNodes() const {
+  std::set<int> nodes;
+  for (const auto &cpu : cpus) {
+    nodes.insert(cpu.numa_node);
+  }
+  return std::max(1, static_cast<int>(nodes.size()));
+}
+
+CpuTopology DiscoverTopology(const std::string &sysfs_root) {
+  const std::filesystem::path root(sysfs_root);
+  std::map<int, int> cpu_nodes;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(root / "node", ec)) {
+    const auto name = entry.path().filename().string();
+    if (!name.starts_with("node") || name.size() <= 4) {
+      continue;
+    }
+    const int node = std::stoi(name.substr(4));
+    for (int cpu : ParseCpuList(ReadFirstLine(entry.path() / "cpulist"))) {
+      cpu_nodes[cpu] = node;
+    }
+  }
+
+  CpuTopology topology;
+  for (const auto &entry : std::filesystem::directory_iterator(root / "cpu", ec)) {
+    const auto name = entry.path().filename().string();
+    if (!IsCpuDirectory(name) || !std::filesystem::exists(entry.path() / "topology", ec)) {
+      continue;
+    }
+    LogicalCpu cpu;
+    cpu.id = std::stoi(name.substr(3));
+    cpu.core = ReadInt(entry.path() / "topology" / "core_id", cpu.id);
+    cpu.socket = std::max(0, ReadInt(entry.path() / "topology" / "physical_package_id", 0));
+    cpu.numa_node = cpu_nodes.contains(cpu.id) ? cpu_nodes[cpu.id] : 0;
+    topology.cpus.push_back(cpu);
+  }
+  if (topology.cpus.empty()) {
+    return FallbackTopology();
+  }
+  std::ranges::sort(topology.cpus, {}, &LogicalCpu::id);
+  topology.caches = ReadCaches(root / "cpu" / ("cpu" + std::to_string(topology.cpus.front().id)));
+  return topology;
+}
+
+const CpuTopology &GetCpuTopology() {
+  static const CpuTopology kTopology = [] {
+    auto topology = DiscoverTopology("/sys/devices/system");
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+      std::erase_if(topology.cpus, [&](const LogicalCpu &cpu) { return CPU_ISSET(cpu.id, &allowed) == 0; });
+    }
+    if (topology.cpus.empty()) {
+      topology = FallbackTopology();
+    }
+#endif
+    return topology;
+  }();
+  return kTopology;
+}
+
+AffinityPolicy GetThreadAffinity() {
+  const auto val = env::get<std::string>("PPC_THREAD_AFFINITY");
+  if (val.has_value()) {
+    if (*val == "compact") {
+      return AffinityPolicy::kCompact;
+    }
+    if (*val == "scatter") {
+      return AffinityPolicy::kScatter;
+    }
+  }
+  return AffinityPolicy::kNone;
+}
+
+NumaPlacement GetNumaPlacement() {
+  const auto val = env::get<std::string>("PPC_NUMA_PLACEMENT");
+  if (val.has_value()) {
+    if (*val == "interleave") {
+      return NumaPlacement::kInterleave;
+    }
+    if (*val == "first_touch") {
+      return NumaPlacement::kFirstTouch;
+    }
+  }
+  return NumaPlacement::kNone;
+}
+
+std::string ToString(AffinityPolicy policy) {
+  switch (policy) {
+    case AffinityPolicy::kCompact:
+      return "compact";
+    case AffinityPolicy::kScatter:
+      return "scatter";
+    case AffinityPolicy::kNone:
+      break;
+  }
+  return "none";
+}
+
+std::string ToString(NumaPlacement placement) {
+  switch (placement) {
+    case NumaPlacement::kInterleave:
+      return "interleave";
+    case NumaPlacement::kFirstTouch:
+      return "first_touch";
+    case NumaPlacement::kNone:
+      break;
+  }
+  return "none";
+}
+
+std::vector<int> PlanThreadPlacement(const CpuTopology &topology, AffinityPolicy policy, int num_threads,
+                                     int first_slot) {
+  if (policy == AffinityPolicy::kNone || topology.cpus.empty() || num_threads <= 0) {
+    return {};
+  }
+  const auto order = OrderCpus(topology, policy);
+  std::vector<int> plan(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    plan[i] = order[static_cast<std::size_t>(std::max(first_slot, 0) + i) % order.size()].id;
+  }
+  return plan;
+}
+
+void SetAffinitySlotOffset(int first_slot) {
+  affinity_slot_offset = first_slot;
+}
+
+bool PinCurrentThread(int cpu) {
+  return PinCurrentThread(std::vector<int>{cpu});
+}
+
+bool PinCurrentThread([[maybe_unused]] const std::vector<int> &cpus) {
+#ifdef __linux__
+  if (cpus.empty() || std::ranges::any_of(cpus, [](int cpu) { return cpu < 0 || cpu >= CPU_SETSIZE; })) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+void PinMainThread(int num_threads) {
+  const auto policy = GetThreadAffinity();
+  if (policy == AffinityPolicy::kNone) {
+    return;
+  }
+  PinCurrentThread(
+      PlanThreadPlacement(GetCpuTopology(), policy, std::max(num_threads, 1), affinity_slot_offset.load()));
+}
+
+void PinWorkerThread(int index) {
+  const auto policy = GetThreadAffinity();
+  if (policy == AffinityPolicy::kNone) {
+    return;
+  }
+  const auto plan = PlanThreadPlacement(GetCpuTopology(), policy, index + 1, affinity_slot_offset.load());
+  PinCurrentThread(plan.back());
+}
+
+bool InterleaveMemory([[maybe_unused]] void *data, [[maybe_unused]] std::size_t bytes,
+                      [[maybe_unused]] const CpuTopology &topology) {
+#if defined(__linux__) && defined(SYS_mbind)
+  if (data == nullptr || bytes == 0) {
+    return true;
+  }
+  // Values of MPOL_INTERLEAVE and MPOL_MF_MOVE from <linux/mempolicy.h>, to avoid a libnuma dependency
+  constexpr int kMpolInterleave = 3;
+  constexpr unsigned kMpolMfMove = 1U << 1U;
+  constexpr std::size_t kMaxNodes = 1024;
+  constexpr std::size_t kBitsPerWord = sizeof(unsigned long) * 8;
+
+  std::vector<unsigned long> mask(kMaxNodes / kBitsPerWord, 0);
+  for (const auto &cpu : topology.cpus) {
+    if (std::cmp_less(cpu.numa_node, kMaxNodes)) {
+      const auto node = static_cast<std::size_t>(cpu.numa_node);
+      mask[node / kBitsPerWord] |= 1UL << (node % kBitsPerWord);
+    }
+  }
+  // Only whole pages of the buffer are moved, so that neighbouring allocations keep their placement
+  const auto page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto begin = (reinterpret_cast<std::uintptr_t>(data) + page - 1) & ~(page - 1);
+  const auto end = (reinterpret_cast<std::uintptr_t>(data) + bytes) & ~(page - 1);
+  if (end <= begin) {
+    return true;
+  }
+  return syscall(SYS_mbind, begin, end - begin, kMpolInterleave, mask.data(), kMaxNodes + 1, kMpolMfMove) == 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,267 @@
+#include "util/include/tracing.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <libenvpp/detail/get.hpp>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <numeric>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+/// Ring buffer of one thread. The owner is the only writer; `written` publishes the slots to the collector.
+struct TraceBuffer {
+  explicit TraceBuffer(std::uint32_t index) : thread(index), events(ppc::util::kTraceBufferCapacity) {}
+
+  std::uint32_t thread;
+  std::vector<ppc::util::TraceEvent> events;
+  alignas(64) std::atomic<std::uint64_t> written{0};
+  // Touched by the collector only, under registry_mutex
+  std::uint64_t collected = 0;
+};
+
+std::atomic<bool> tracing{false};
+std::mutex registry_mutex;
+std::vector<std::shared_ptr<TraceBuffer>> registry;
+std::mutex names_mutex;
+std::set<std::string, std::less<>> names;
+
+TraceBuffer &LocalBuffer() {
+  // The registry keeps the buffer alive after the thread exits, so its events are still collected
+  thread_local TraceBuffer *buffer = [] {
+    const std::scoped_lock lock(registry_mutex);
+    registry.push_back(std::make_shared<TraceBuffer>(static_cast<std::uint32_t>(registry.size())));
+    return registry.back().get();
+  }();
+  return *buffer;
+}
+
+/// Number of ping-pong exchanges per rank; the one with the shortest round trip gives the offset.
+constexpr int kClockSyncRounds = 8;
+
+/// Offset of the trace clock of the calling rank to the one of rank 0 (Cristian's algorithm).
+std::int64_t ClockOffsetToRoot(MPI_Comm comm, int rank, int size) {
+  std::int64_t offset = 0;
+  if (rank == 0) {
+    for (int peer = 1; peer < size; peer++) {
+      auto best_rtt = std::numeric_limits<std::uint64_t>::max();
+      std::int64_t best_offset = 0;
+      for (int round = 0; round < kClockSyncRounds; round++) {
+        const auto send_time = ppc::util::TraceClock();
+        PMPI_Send(nullptr, 0, MPI_BYTE, peer, 0, comm);
+        std::uint64_t peer_time = 0;
+        PMPI_Recv(&peer_time, 1, MPI_UINT64_T, peer, 0, comm, MPI_STATUS_IGNORE);
+        const auto rtt = ppc::util::TraceClock() - send_time;
+        if (rtt < best_rtt) {
+          best_rtt = rtt;
+          best_offset = static_cast<std::int64_t>(peer_time) - static_cast<std::int64_t>(send_time + (rtt / 2));
+        }
+      }
+      PMPI_Send(&best_offset, 1, MPI_INT64_T, peer, 0, comm);
+    }
+  } else {
+    for (int round = 0; round < kClockSyncRounds; round++) {
+      PMPI_Recv(nullptr, 0, MPI_BYTE, 0, 0, comm, MPI_STATUS_IGNORE);
+      const auto now = ppc::util::TraceClock();
+      PMPI_Send(&now, 1, MPI_UINT64_T, 0, 0, comm);
+    }
+    PMPI_Recv(&offset, 1, MPI_INT64_T, 0, 0, comm, MPI_STATUS_IGNORE);
+  }
+  return offset;
+}
+
+void WriteTraceFile(const std::filesystem::path &path, const std::vector<std::string> &chunks) {
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path());
+  }
+  std::ofstream file(path);
+  file << R"({"displayTimeUnit":"ms","traceEvents":[)" << '\n';
+  bool first = true;
+  for (const auto &chunk : chunks) {
+    if (chunk.empty()) {
+      continue;
+    }
+    file << (first ? "" : ",\n") << chunk;
+    first = false;
+  }
+  file << "\n]}\n";
+}
+
+}  // namespace
+
+namespace ppc::util {
+
+std::string GetTraceFile() {
+  return env::get<std::string>("PPC_TRACE_FILE").value_or(std::string{});
+}
+
+void SetTracing(bool enabled) {
+  tracing.store(enabled, std::memory_order_relaxed);
+}
+
+bool IsTracingEnabled() {
+  return tracing.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TraceClock() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+const char *InternTraceName(std::string_view name) {
+  const std::scoped_lock lock(names_mutex);
+  auto it = names.find(name);
+  if (it == names.end()) {
+    it = names.emplace(name).first;
+  }
+  return it->c_str();
+}
+
+void RecordTraceEvent(const char *name, const char *category, std::uint64_t begin_ns, std::uint64_t end_ns,
+                      std::uint64_t bytes) {
+  auto &buffer = LocalBuffer();
+  const auto index = buffer.written.load(std::memory_order_relaxed);
+  buffer.events[index % kTraceBufferCapacity] = {.name = name,
+                                                  .category = category,
+                                                  .begin_ns = begin_ns,
+                                                  .end_ns = end_ns,
+                                                  .bytes = bytes,
+                                                  .thread = buffer.thread};
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category)
+    : name_(name), category_(category), begin_ns_(IsTracingEnabled() ? TraceClock() : 0) {}
+
+TraceSpan::~TraceSpan() {
+  if (begin_ns_ != 0) {
+    RecordTraceEvent(name_, category_, begin_ns_, TraceClock());
+  }
+}
+
+std::vector<TraceEvent> CollectTraceEvents() {
+  std::vector<TraceEvent> events;
+  {
+    const std::scoped_lock lock(registry_mutex);
+    for (const auto &buffer : registry) {
+      const auto written = buffer->written.load(std::memory_order_acquire);
+      const auto first = std::max(buffer->collected, written > kTraceBufferCapacity ? written - kTraceBufferCapacity
+                                                                                     : std::uint64_t{0});
+      for (auto index = first; index < written; index++) {
+        events.push_back(buffer->events[index % kTraceBufferCapacity]);
+      }
+      buffer->collected = written;
+    }
+  }
+  std::ranges::stable_sort(events, {}, &TraceEvent::begin_ns);
+  return events;
+}
+
+std::string FormatTraceEvents(const std::vector<TraceEvent> &events, int pid, std::int64_t origin_ns) {
+  auto to_microseconds = [](std::int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+  std::vector<std::string> lines;
+  lines.push_back(nlohmann::json{
+      {"name", "process_name"}, {"ph", "M"}, {"pid", pid}, {"args", {{"name", "rank " + std::to_string(pid)}}}}
+                      .dump());
+  lines.push_back(
+      nlohmann::json{{"name", "process_sort_index"}, {"ph", "M"}, {"pid", pid}, {"args", {{"sort_index", pid}}}}
+          .dump());
+  std::set<std::uint32_t> threads;
+  for (const auto &event : events) {
+    if (threads.insert(event.thread).second) {
+      lines.push_back(nlohmann::json{{"name", "thread_name"},
+                                     {"ph", "M"},
+                                     {"pid", pid},
+                                     {"tid", event.thread},
+                                     {"args", {{"name", "thread " + std::to_string(event.thread)}}}}
+                          .dump());
+    }
+  }
+  for (const auto &event : events) {
+    nlohmann::json json{{"name", event.name},
+                        {"cat", event.category},
+                        {"ph", "X"},
+                        {"pid", pid},
+                        {"tid", event.thread},
+                        {"ts", to_microseconds(static_cast<std::int64_t>(event.begin_ns) - origin_ns)},
+                        {"dur", to_microseconds(static_cast<std::int64_t>(event.end_ns - event.begin_ns))}};
+    if (event.bytes > 0) {
+      json["args"] = {{"bytes", event.bytes}};
+    }
+    lines.push_back(json.dump());
+  }
+  std::string result;
+  for (const auto &line : lines) {
+    result += result.empty() ? "" : ",\n";
+    result += line;
+  }
+  return result;
+}
+
+void WriteTrace(const std::filesystem::path &path) {
+  const auto events = CollectTraceEvents();
+  const std::int64_t local_start =
+      events.empty() ? std::numeric_limits<std::int64_t>::max() : static_cast<std::int64_t>(events.front().begin_ns);
+
+  int initialized = 0;
+  int finalized = 0;
+  PMPI_Initialized(&initialized);
+  PMPI_Finalized(&finalized);
+  if (initialized == 0 || finalized != 0) {
+    WriteTraceFile(path, {FormatTraceEvents(events, 0, events.empty() ? 0 : local_start)});
+    return;
+  }
+
+  // A private communicator keeps the clock synchronization apart from the messages of the tasks
+  MPI_Comm comm = MPI_COMM_NULL;
+  PMPI_Comm_dup(MPI_COMM_WORLD, &comm);
+  int rank = 0;
+  int size = 1;
+  PMPI_Comm_rank(comm, &rank);
+  PMPI_Comm_size(comm, &size);
+
+  const auto offset = ClockOffsetToRoot(comm, rank, size);
+  // The earliest event of the job becomes timestamp 0, expressed in the clock of rank 0
+  std::int64_t start = events.empty() ? local_start : local_start - offset;
+  PMPI_Allreduce(MPI_IN_PLACE, &start, 1, MPI_INT64_T, MPI_MIN, comm);
+  if (start == std::numeric_limits<std::int64_t>::max()) {
+    start = 0;
+  }
+  const auto chunk = FormatTraceEvents(events, rank, start + offset);
+
+  int length = static_cast<int>(chunk.size());
+  std::vector<int> lengths(rank == 0 ? size : 0);
+  PMPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, comm);
+  std::vector<int> displs(lengths.size());
+  if (rank == 0) {
+    std::exclusive_scan(lengths.begin(), lengths.end(), displs.begin(), 0);
+  }
+  std::string gathered(rank == 0 ? static_cast<std::size_t>(displs.back() + lengths.back()) : 0, '\0');
+  PMPI_Gatherv(chunk.data(), length, MPI_CHAR, gathered.data(), lengths.data(), displs.data(), MPI_CHAR, 0, comm);
+  PMPI_Comm_free(&comm);
+
+  if (rank == 0) {
+    std::vector<std::string> chunks;
+    for (int i = 0; i < size; i++) {
+      chunks.push_back(gathered.substr(static_cast<std::size_t>(displs[i]), static_cast<std::size_t>(lengths[i])));
+    }
+    WriteTraceFile(path, chunks);
+  }
+}
+
+}  // namespace ppc::util
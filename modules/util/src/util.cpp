@@ -8,6 +8,8 @@
 
 namespace {
 
+thread_local int num_threads_override = 0;
+
 std::string GetAbsolutePath(const std::string &relative_path) {
   std::filesystem::path path = std::filesystem::path(PPC_PATH_TO_PROJECT) / "tasks" / relative_path;
   return path.string();
@@ -21,6 +23,9 @@ std::string ppc::util::GetAbsoluteTaskPath(const std::string &id_path, const std
 }
 
 int ppc::util::GetNumThreads() {
+  if (num_threads_override > 0) {
+    return num_threads_override;
+  }
   const auto num_threads = env::get<int>("PPC_NUM_THREADS");
   if (num_threads.has_value()) {
     return num_threads.value();
@@ -28,6 +33,16 @@ int ppc::util::GetNumThreads() {
   return 1;
 }
 
+ppc::util::ScopedNumThreads::ScopedNumThreads(int num_threads) : previous_(num_threads_override) {
+  if (num_threads > 0) {
+    num_threads_override = num_threads;
+  }
+}
+
+ppc::util::ScopedNumThreads::~ScopedNumThreads() {
+  num_threads_override = previous_;
+}
+
 int ppc::util::GetNumProc() {
   const auto num_proc = env::get<int>("PPC_NUM_PROC");
   if (num_proc.has_value()) {
@@ -36,6 +51,14 @@ int ppc::util::GetNumProc() {
   return 1;
 }
 
+std::string ppc::util::GetMpiThreadLevel() {
+  const auto val = env::get<std::string>("PPC_MPI_THREAD_LEVEL");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return "funneled";
+}
+
 double ppc::util::GetTaskMaxTime() {
   const auto val = env::get<double>("PPC_TASK_MAX_TIME");
   if (val.has_value()) {
@@ -52,6 +75,86 @@ double ppc::util::GetPerfMaxTime() {
   return 10.0;
 }
 
+int ppc::util::GetPerfWarmupRuns() {
+  const auto val = env::get<int>("PPC_PERF_WARMUP_RUNS");
+  if (val.has_value()) {
+    return std::max(val.value(), 0);
+  }
+  return 0;
+}
+
+bool ppc::util::GetPerfAdaptive() {
+  const auto val = env::get<int>("PPC_PERF_ADAPTIVE");
+  if (val.has_value()) {
+    return val.value() != 0;
+  }
+  return false;
+}
+
+double ppc::util::GetPerfTargetRse() {
+  const auto val = env::get<double>("PPC_PERF_TARGET_RSE");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0.01;
+}
+
+bool ppc::util::GetPerfHardwareCounters() {
+  const auto val = env::get<int>("PPC_PERF_COUNTERS");
+  if (val.has_value()) {
+    return val.value() != 0;
+  }
+  return false;
+}
+
+bool ppc::util::GetPerfMpiProfile() {
+  const auto val = env::get<int>("PPC_PERF_MPI_PROFILE");
+  if (val.has_value()) {
+    return val.value() != 0;
+  }
+  return false;
+}
+
+std::string ppc::util::GetPerfResultsFile() {
+  const auto val = env::get<std::string>("PPC_PERF_RESULTS_FILE");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return {};
+}
+
+double ppc::util::GetPerfProblemScale() {
+  const auto val = env::get<double>("PPC_PERF_PROBLEM_SCALE");
+  if (val.has_value() && val.value() > 0.0) {
+    return val.value();
+  }
+  return 1.0;
+}
+
+std::string ppc::util::GetPerfBaselineDir() {
+  const auto val = env::get<std::string>("PPC_PERF_BASELINE_DIR");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return {};
+}
+
+bool ppc::util::GetPerfBaselineUpdate() {
+  const auto val = env::get<int>("PPC_PERF_BASELINE_UPDATE");
+  if (val.has_value()) {
+    return val.value() != 0;
+  }
+  return false;
+}
+
+double ppc::util::GetPerfRegressionThreshold() {
+  const auto val = env::get<double>("PPC_PERF_REGRESSION_THRESHOLD");
+  if (val.has_value() && val.value() >= 0.0) {
+    return val.value();
+  }
+  return 0.05;
+}
+
 // List of environment variables that signal the application is running under
 // an MPI launcher. The array size must match the number of entries to avoid
 // looking up empty environment variable names.
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "util/include/collectives.hpp"
+
+namespace {
+
+// The collectives of the library against the vendor MPI, at every root and at message sizes that leave the blocks
+// uneven, span several pipeline segments or hold fewer elements than there are ranks
+constexpr std::array<std::size_t, 6> kCollectiveCounts = {
+    0, 1, 3, 1001, (2 * ppc::util::kPipelineSegmentBytes / sizeof(int)) + 13,
+    (ppc::util::kScatterAllgatherBroadcastMaxBytes / sizeof(int)) + 7};
+
+std::vector<int> RankValues(std::size_t count, int rank) {
+  std::vector<int> values(count);
+  for (std::size_t i = 0; i < count; i++) {
+    values[i] = static_cast<int>((i * 7) % 1009) - (rank * 3) + 1;
+  }
+  return values;
+}
+
+TEST(Collectives, BroadcastMatchesRootBuffer) {
+  constexpr std::array<ppc::util::BroadcastAlgorithm, 5> kAlgorithms = {
+      ppc::util::BroadcastAlgorithm::kAuto, ppc::util::BroadcastAlgorithm::kBinomial,
+      ppc::util::BroadcastAlgorithm::kScatterAllgather, ppc::util::BroadcastAlgorithm::kPipelinedChain,
+      ppc::util::BroadcastAlgorithm::kHierarchical};
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  for (const auto count : kCollectiveCounts) {
+    for (int root = 0; root < size; root++) {
+      const std::vector<int> expected = RankValues(count, root);
+      for (const auto algorithm : kAlgorithms) {
+        std::vector<int> buffer = rank == root ? expected : std::vector<int>(count, -1);
+        ppc::util::Broadcast(buffer, root, MPI_COMM_WORLD, algorithm);
+        EXPECT_EQ(buffer, expected) << ppc::util::GetAlgorithmName(algorithm) << ", " << count
+                                    << " elements, root " << root;
+      }
+    }
+  }
+}
+
+TEST(Collectives, ReduceMatchesVendorReduce) {
+  constexpr std::array<ppc::util::ReduceAlgorithm, 3> kAlgorithms = {
+      ppc::util::ReduceAlgorithm::kAuto, ppc::util::ReduceAlgorithm::kBinomial,
+      ppc::util::ReduceAlgorithm::kPipelinedChain};
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  for (const auto count : kCollectiveCounts) {
+    const std::vector<int> send = RankValues(count, rank);
+    for (int root = 0; root < size; root++) {
+      for (MPI_Op op : {MPI_SUM, MPI_MAX}) {
+        std::vector<int> expected(rank == root ? count : 0);
+        MPI_Reduce(send.data(), expected.data(), static_cast<int>(count), MPI_INT, op, root, MPI_COMM_WORLD);
+        for (const auto algorithm : kAlgorithms) {
+          std::vector<int> result(rank == root ? count : 0);
+          ppc::util::Reduce(send, result, op, root, MPI_COMM_WORLD, algorithm);
+          EXPECT_EQ(result, expected) << ppc::util::GetAlgorithmName(algorithm) << ", " << count
+                                      << " elements, root " << root;
+        }
+      }
+    }
+  }
+}
+
+TEST(Collectives, AllreduceMatchesVendorAllreduce) {
+  constexpr std::array<ppc::util::AllreduceAlgorithm, 5> kAlgorithms = {
+      ppc::util::AllreduceAlgorithm::kAuto, ppc::util::AllreduceAlgorithm::kRecursiveDoubling,
+      ppc::util::AllreduceAlgorithm::kRabenseifner, ppc::util::AllreduceAlgorithm::kRing,
+      ppc::util::AllreduceAlgorithm::kHierarchical};
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  for (const auto count : kCollectiveCounts) {
+    const std::vector<int> send = RankValues(count, rank);
+    for (MPI_Op op : {MPI_SUM, MPI_MAX}) {
+      std::vector<int> expected(count);
+      MPI_Allreduce(send.data(), expected.data(), static_cast<int>(count), MPI_INT, op, MPI_COMM_WORLD);
+      for (const auto algorithm : kAlgorithms) {
+        std::vector<int> result(count);
+        ppc::util::Allreduce(send, result, op, MPI_COMM_WORLD, algorithm);
+        EXPECT_EQ(result, expected) << ppc::util::GetAlgorithmName(algorithm) << ", " << count << " elements";
+      }
+    }
+  }
+}
+
+}  // namespace
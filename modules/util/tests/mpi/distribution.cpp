@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/distribution.hpp"
+
+namespace {
+
+TEST(Distribution, WrongSizeOnOneRankThrowsOnEveryRank) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const ppc::util::BlockDistribution dist(static_cast<std::size_t>(size) * 3, size);
+  const int faulty = size - 1;
+
+  std::vector<int> global(rank == 0 ? dist.Total() : 0, 1);
+  std::vector<int> local(dist.Count(rank) + (rank == faulty ? 1 : 0));
+  EXPECT_THROW(ppc::util::Scatter(dist, global, local), std::invalid_argument);
+  EXPECT_THROW(ppc::util::Gather(dist, local, global), std::invalid_argument);
+
+  // The root's global buffer is only checked on the root
+  local.resize(dist.Count(rank));
+  global.resize(rank == 0 ? dist.Total() - 1 : 0);
+  EXPECT_THROW(ppc::util::Scatter(dist, global, local), std::invalid_argument);
+
+  global.assign(rank == 0 ? dist.Total() : 0, 1);
+  ppc::util::Scatter(dist, global, local);
+  EXPECT_EQ(local, std::vector<int>(dist.Count(rank), 1));
+}
+
+}  // namespace
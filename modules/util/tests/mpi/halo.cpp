@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "util/include/distribution.hpp"
+#include "util/include/halo.hpp"
+
+namespace {
+
+constexpr int kUnset = -1;
+
+/// Value of a matrix element in the given exchange round; never kUnset.
+int Value(std::ptrdiff_t row, std::ptrdiff_t col, std::ptrdiff_t cols, int round) {
+  return static_cast<int>((2 * ((row * cols) + col)) + round);
+}
+
+/// The first `parts` processes of MPI_COMM_WORLD; MPI_COMM_NULL on the others. Sweeping `parts` up to the world size
+/// covers process counts whose grids are not square, whatever the test was launched with.
+MPI_Comm FirstProcesses(int parts) {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPI_Comm_split(MPI_COMM_WORLD, rank < parts ? 0 : MPI_UNDEFINED, rank, &comm);
+  return comm;
+}
+
+TEST(HaloExchange, FillsGhostRowsOfStripes) {
+  constexpr std::size_t kCols = 5;
+  constexpr std::array<ppc::util::HaloWidth, 3> kWidths = {
+      {{.before = 1, .after = 1}, {.before = 2, .after = 2}, {.before = 1, .after = 2}}};
+  int world = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &world);
+  for (int parts = 1; parts <= world; parts++) {
+    MPI_Comm comm = FirstProcesses(parts);
+    if (comm == MPI_COMM_NULL) {
+      continue;
+    }
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    // Every block owns three or four rows, enough for either ghost region
+    const ppc::util::BlockDistribution dist((3 * static_cast<std::size_t>(parts)) + 1, parts);
+    const auto rows = static_cast<std::ptrdiff_t>(dist.Total());
+    const auto first = static_cast<std::ptrdiff_t>(dist.Offset(rank));
+    const auto owned = static_cast<std::ptrdiff_t>(dist.Count(rank));
+    for (const auto width : kWidths) {
+      const auto before = static_cast<std::ptrdiff_t>(width.before);
+      std::vector<int> buffer(ppc::util::HaloExchange::PaddedSize(dist, rank, width, kCols), kUnset);
+      ppc::util::HaloExchange halo(dist, width, buffer, comm, kCols);
+      // The second round checks that the persistent requests pick up the new contents of the buffer
+      for (int round = 0; round < 2; round++) {
+        std::vector<int> expected(buffer.size(), kUnset);
+        for (std::ptrdiff_t local = 0; local < static_cast<std::ptrdiff_t>(buffer.size() / kCols); local++) {
+          const auto row = first + local - before;
+          for (std::ptrdiff_t col = 0; col < static_cast<std::ptrdiff_t>(kCols); col++) {
+            const auto index = static_cast<std::size_t>((local * static_cast<std::ptrdiff_t>(kCols)) + col);
+            if (local >= before && local < before + owned) {
+              buffer[index] = Value(row, col, kCols, round);
+            }
+            if (row >= 0 && row < rows) {
+              expected[index] = Value(row, col, kCols, round);
+            }
+          }
+        }
+        halo.Start();
+        halo.Finish();
+        EXPECT_EQ(buffer, expected) << "processes " << parts << ", rank " << rank << ", ghosts " << width.before
+                                    << "/" << width.after << ", round " << round;
+      }
+    }
+    MPI_Comm_free(&comm);
+  }
+}
+
+TEST(HaloExchange, FillsGhostFacesAndCornersOfTiles) {
+  constexpr std::array<std::size_t, 2> kWidths = {1, 2};
+  constexpr std::array<ppc::util::HaloShape, 2> kShapes = {ppc::util::HaloShape::kFaces,
+                                                           ppc::util::HaloShape::kFacesAndCorners};
+  int world = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &world);
+  for (int parts = 1; parts <= world; parts++) {
+    MPI_Comm comm = FirstProcesses(parts);
+    if (comm == MPI_COMM_NULL) {
+      continue;
+    }
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    // A non-square matrix whose tiles own at least two rows and columns each
+    const auto size = static_cast<std::size_t>(parts);
+    const ppc::util::MatrixDistribution dist((2 * size) + 5, (3 * size) + 4, parts, ppc::util::MatrixLayout::kTiles);
+    const auto rows = static_cast<std::ptrdiff_t>(dist.Rows());
+    const auto cols = static_cast<std::ptrdiff_t>(dist.Cols());
+    const auto first_row = static_cast<std::ptrdiff_t>(dist.RowRange(rank).begin);
+    const auto first_col = static_cast<std::ptrdiff_t>(dist.ColRange(rank).begin);
+    const auto owned_rows = static_cast<std::ptrdiff_t>(dist.LocalRows(rank));
+    const auto owned_cols = static_cast<std::ptrdiff_t>(dist.LocalCols(rank));
+    for (const auto width : kWidths) {
+      for (const auto shape : kShapes) {
+        const auto ghosts = static_cast<std::ptrdiff_t>(width);
+        const auto padded_cols = owned_cols + (2 * ghosts);
+        std::vector<int> buffer(ppc::util::HaloExchange::PaddedSize(dist, rank, width), kUnset);
+        ppc::util::HaloExchange halo(dist, width, shape, buffer, comm);
+        for (int round = 0; round < 2; round++) {
+          std::vector<int> expected(buffer.size(), kUnset);
+          for (std::ptrdiff_t i = 0; i < owned_rows + (2 * ghosts); i++) {
+            for (std::ptrdiff_t j = 0; j < padded_cols; j++) {
+              const auto row = first_row + i - ghosts;
+              const auto col = first_col + j - ghosts;
+              const bool in_owned_rows = i >= ghosts && i < ghosts + owned_rows;
+              const bool in_owned_cols = j >= ghosts && j < ghosts + owned_cols;
+              const auto index = static_cast<std::size_t>((i * padded_cols) + j);
+              if (in_owned_rows && in_owned_cols) {
+                buffer[index] = Value(row, col, cols, round);
+              }
+              const bool corner = !in_owned_rows && !in_owned_cols;
+              if (row >= 0 && row < rows && col >= 0 && col < cols &&
+                  (!corner || shape == ppc::util::HaloShape::kFacesAndCorners)) {
+                expected[index] = Value(row, col, cols, round);
+              }
+            }
+          }
+          halo.Start();
+          halo.Finish();
+          EXPECT_EQ(buffer, expected) << "processes " << parts << " (" << dist.GridRows() << " x " << dist.GridCols()
+                                      << " tiles), rank " << rank << ", width " << width << ", corners "
+                                      << (shape == ppc::util::HaloShape::kFacesAndCorners) << ", round " << round;
+        }
+      }
+    }
+    MPI_Comm_free(&comm);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "util/include/distribution.hpp"
+#include "util/include/iteration.hpp"
+
+namespace {
+
+constexpr int kIterations = 3;
+
+/// Distributions with uneven blocks and, from two processes on, one whose last block is empty.
+std::vector<ppc::util::BlockDistribution> IterateDistributions(int size) {
+  std::vector<ppc::util::BlockDistribution> dists = {
+      ppc::util::BlockDistribution((3 * static_cast<std::size_t>(size)) + 2, size)};
+  if (size > 1) {
+    dists.emplace_back(static_cast<std::size_t>(size) - 1, size);
+  }
+  return dists;
+}
+
+double Value(std::size_t index, int iteration) {
+  return static_cast<double>((index * kIterations) + static_cast<std::size_t>(iteration));
+}
+
+/// Writes the own block of the iterate for the given iteration.
+void ComputeOwnBlock(const ppc::util::BlockDistribution &dist, int rank, int iteration, std::vector<double> &x) {
+  const auto own = dist.Range(rank);
+  for (auto i = own.begin; i < own.end; i++) {
+    x[i] = Value(i, iteration);
+  }
+}
+
+TEST(IterationExchange, DenseExchangeGathersEveryBlock) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  for (const auto &dist : IterateDistributions(size)) {
+    std::vector<double> x(dist.Total(), -1.0);
+    ppc::util::IterationExchange exchange(dist, x, MPI_COMM_WORLD);
+    for (int iteration = 0; iteration < kIterations; iteration++) {
+      ComputeOwnBlock(dist, rank, iteration, x);
+      EXPECT_DOUBLE_EQ(exchange.Exchange(rank + 1.0), size * (size + 1) / 2.0);
+      for (std::size_t i = 0; i < x.size(); i++) {
+        ASSERT_EQ(x[i], Value(i, iteration)) << "element " << i << " of " << x.size() << ", iteration " << iteration;
+      }
+    }
+  }
+}
+
+TEST(IterationExchange, SparseExchangeReceivesOnlyListedBlocks) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  // The previous rank and the one after the next; the own rank is skipped
+  const std::vector<int> sources = {(rank + size - 1) % size, (rank + 2) % size, rank};
+  for (const auto &dist : IterateDistributions(size)) {
+    std::vector<double> x(dist.Total(), -1.0);
+    ppc::util::IterationExchange exchange(dist, sources, x, MPI_COMM_WORLD, MPI_MAX);
+    EXPECT_EQ(exchange.Sources(), ppc::util::detail::SourcesWithBlocks(dist, rank, sources));
+    for (int iteration = 0; iteration < kIterations; iteration++) {
+      ComputeOwnBlock(dist, rank, iteration, x);
+      exchange.Start(static_cast<double>(rank + iteration));
+      EXPECT_TRUE(exchange.InFlight());
+      EXPECT_DOUBLE_EQ(exchange.Finish(), static_cast<double>(size - 1 + iteration));
+      for (std::size_t i = 0; i < x.size(); i++) {
+        const int owner = dist.Owner(i);
+        const bool received = owner == rank || std::ranges::find(sources, owner) != sources.end();
+        ASSERT_EQ(x[i], received ? Value(i, iteration) : -1.0)
+            << "element " << i << " of " << x.size() << ", iteration " << iteration;
+      }
+    }
+  }
+}
+
+}  // namespace
@@ -1,12 +1,41 @@
 #include "util/include/util.hpp"
 
 #include <gtest/gtest.h>
+#include <mpi.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <libenvpp/detail/environment.hpp>
 #include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "omp.h"
+#include "util/include/aligned_allocator.hpp"
+#include "util/include/collectives.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/halo.hpp"
+#include "util/include/iteration.hpp"
+#include "util/include/memory_tracker.hpp"
+#include "util/include/mpi_profiler.hpp"
+#include "util/include/reduction.hpp"
+#include "util/include/thread_pool.hpp"
+#include "util/include/topology.hpp"
+#include "util/include/tracing.hpp"
 
 namespace my::nested {
 struct Type {};
@@ -124,3 +153,911 @@ TEST(GetNumProc, ReadsFromEnvironment) {
   env::detail::set_scoped_environment_variable scoped("PPC_NUM_PROC", "4");
   EXPECT_EQ(ppc::util::GetNumProc(), 4);
 }
+
+TEST(GetPerfWarmupRuns, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<int>("PPC_PERF_WARMUP_RUNS");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_WARMUP_RUNS");
+  }
+  EXPECT_EQ(ppc::util::GetPerfWarmupRuns(), 0);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_WARMUP_RUNS", std::to_string(*old));
+  }
+}
+
+TEST(GetPerfWarmupRuns, ClampsNegativeValues) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_WARMUP_RUNS", "-3");
+  EXPECT_EQ(ppc::util::GetPerfWarmupRuns(), 0);
+}
+
+TEST(GetPerfAdaptive, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_ADAPTIVE", "1");
+  EXPECT_TRUE(ppc::util::GetPerfAdaptive());
+}
+
+TEST(GetPerfTargetRse, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_TARGET_RSE", "0.05");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfTargetRse(), 0.05);
+}
+
+TEST(GetPerfResultsFile, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<std::string>("PPC_PERF_RESULTS_FILE");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_RESULTS_FILE");
+  }
+  EXPECT_TRUE(ppc::util::GetPerfResultsFile().empty());
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_RESULTS_FILE", *old);
+  }
+}
+
+TEST(GetPerfResultsFile, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_RESULTS_FILE", "results.jsonl");
+  EXPECT_EQ(ppc::util::GetPerfResultsFile(), "results.jsonl");
+}
+
+TEST(GetPerfMpiProfile, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_MPI_PROFILE", "1");
+  EXPECT_TRUE(ppc::util::GetPerfMpiProfile());
+}
+
+TEST(GetPerfProblemScale, IgnoresNonPositiveValues) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_PROBLEM_SCALE", "-2");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfProblemScale(), 1.0);
+}
+
+TEST(ScalePerfSize, ScalesAndRoundsBaseSize) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_PROBLEM_SCALE", "2.5");
+  EXPECT_EQ(ppc::util::ScalePerfSize(100), 250);
+  EXPECT_EQ(ppc::util::ScalePerfSize(std::size_t{3}), std::size_t{8});
+}
+
+TEST(ScalePerfSize, NeverReturnsZero) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_PROBLEM_SCALE", "0.01");
+  EXPECT_EQ(ppc::util::ScalePerfSize(10), 1);
+}
+
+TEST(GetPerfBaselineDir, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<std::string>("PPC_PERF_BASELINE_DIR");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_BASELINE_DIR");
+  }
+  EXPECT_TRUE(ppc::util::GetPerfBaselineDir().empty());
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_BASELINE_DIR", *old);
+  }
+}
+
+TEST(GetPerfBaselineUpdate, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_BASELINE_UPDATE", "1");
+  EXPECT_TRUE(ppc::util::GetPerfBaselineUpdate());
+}
+
+TEST(GetPerfRegressionThreshold, ReadsValueAndIgnoresNegative) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_REGRESSION_THRESHOLD", "0.1");
+    EXPECT_DOUBLE_EQ(ppc::util::GetPerfRegressionThreshold(), 0.1);
+  }
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_REGRESSION_THRESHOLD", "-1");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfRegressionThreshold(), 0.05);
+}
+
+TEST(ScopedNumThreads, OverridesOnlyTheCallingThread) {
+  env::detail::set_scoped_environment_variable scoped("PPC_NUM_THREADS", "2");
+  {
+    ppc::util::ScopedNumThreads threads(5);
+    EXPECT_EQ(ppc::util::GetNumThreads(), 5);
+    int other_thread = 0;
+    std::thread([&] { other_thread = ppc::util::GetNumThreads(); }).join();
+    EXPECT_EQ(other_thread, 2);
+    {
+      ppc::util::ScopedNumThreads keep(0);
+      EXPECT_EQ(ppc::util::GetNumThreads(), 5);
+    }
+  }
+  EXPECT_EQ(ppc::util::GetNumThreads(), 2);
+}
+
+TEST(GetMpiThreadLevel, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<std::string>("PPC_MPI_THREAD_LEVEL");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_MPI_THREAD_LEVEL");
+  }
+  EXPECT_EQ(ppc::util::GetMpiThreadLevel(), "funneled");
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_MPI_THREAD_LEVEL", *old);
+  }
+}
+
+TEST(GetMpiThreadLevel, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_MPI_THREAD_LEVEL", "multiple");
+  EXPECT_EQ(ppc::util::GetMpiThreadLevel(), "multiple");
+}
+
+TEST(ThreadPool, SubmitReturnsResult) {
+  ppc::util::ThreadPool pool(2);
+  auto result = pool.Submit([] { return 6 * 7; });
+  EXPECT_EQ(result.get(), 42);
+}
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+  ppc::util::ThreadPool pool(3);
+  std::vector<std::atomic<int>> visits(1000);
+  pool.ParallelFor(0, 1000, [&](int i) { visits[i]++; }, 7);
+  for (const auto &visit : visits) {
+    EXPECT_EQ(visit.load(), 1);
+  }
+}
+
+TEST(ThreadPool, NestedParallelForCompletes) {
+  ppc::util::ThreadPool pool(2);
+  std::atomic<int> sum(0);
+  pool.ParallelFor(0, 4, [&](int) { pool.ParallelFor(0, 100, [&](int i) { sum += i; }, 4); }, 4);
+  EXPECT_EQ(sum.load(), 4 * 4950);
+}
+
+TEST(ThreadPool, ParallelForRethrowsException) {
+  ppc::util::ThreadPool pool(2);
+  auto body = [](int i) {
+    if (i == 17) {
+      throw std::runtime_error("body failed");
+    }
+  };
+  EXPECT_THROW(pool.ParallelFor(0, 64, body, 4), std::runtime_error);
+}
+
+TEST(ThreadPool, PausedPoolKeepsJobsUntilResume) {
+  ppc::util::ThreadPool pool(2);
+  pool.Pause();
+  auto result = pool.Submit([] { return 1; });
+  EXPECT_EQ(result.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+  pool.Resume();
+  EXPECT_EQ(result.get(), 1);
+}
+
+TEST(ThreadPool, GlobalPoolPersistsAcrossCalls) {
+  auto &pool = ppc::util::ThreadPool::Global();
+  EXPECT_EQ(&pool, &ppc::util::ThreadPool::Global());
+  EXPECT_GE(pool.NumThreads(), 1);
+}
+
+TEST(ThreadPool, PauseIfCreatedPausesGlobalPool) {
+  auto &pool = ppc::util::ThreadPool::Global();
+  ppc::util::ThreadPool::PauseIfCreated();
+  EXPECT_TRUE(pool.IsPaused());
+  pool.Resume();
+  EXPECT_EQ(pool.Submit([] { return 2; }).get(), 2);
+}
+
+namespace {
+
+void WriteSysfsFile(const std::filesystem::path &path, const std::string &value) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream(path) << value << '\n';
+}
+
+/// Two sockets with two 2-way SMT cores each; siblings are numbered like on Linux (cpu0 and cpu4 share a core).
+std::filesystem::path MakeFakeSysfs() {
+  const auto root = std::filesystem::temp_directory_path() / "ppc_fake_sysfs";
+  std::filesystem::remove_all(root);
+  for (int cpu = 0; cpu < 8; cpu++) {
+    const auto topology = root / "cpu" / ("cpu" + std::to_string(cpu)) / "topology";
+    WriteSysfsFile(topology / "physical_package_id", std::to_string((cpu / 2) % 2));
+    WriteSysfsFile(topology / "core_id", std::to_string(cpu % 2));
+  }
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index0" / "level", "1");
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index0" / "type", "Data");
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index0" / "size", "32K");
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index0" / "shared_cpu_list", "0,4");
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index3" / "level", "3");
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index3" / "type", "Unified");
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index3" / "size", "16M");
+  WriteSysfsFile(root / "cpu" / "cpu0" / "cache" / "index3" / "shared_cpu_list", "0-1,4-5");
+  WriteSysfsFile(root / "node" / "node0" / "cpulist", "0-1,4-5");
+  WriteSysfsFile(root / "node" / "node1" / "cpulist", "2-3,6-7");
+  return root;
+}
+
+}  // namespace
+
+TEST(Topology, DiscoversSocketsCoresAndCaches) {
+  const auto root = MakeFakeSysfs();
+  const auto topology = ppc::util::DiscoverTopology(root.string());
+  std::filesystem::remove_all(root);
+
+  ASSERT_EQ(topology.cpus.size(), 8U);
+  EXPECT_EQ(topology.NumSockets(), 2);
+  EXPECT_EQ(topology.NumCores(), 4);
+  EXPECT_EQ(topology.NumNumaNodes(), 2);
+  EXPECT_EQ(topology.cpus[6].socket, 1);
+  EXPECT_EQ(topology.cpus[6].numa_node, 1);
+  ASSERT_EQ(topology.caches.size(), 2U);
+  EXPECT_EQ(topology.caches[0].size_bytes, 32U * 1024U);
+  EXPECT_EQ(topology.caches[1].size_bytes, 16U * 1024U * 1024U);
+  EXPECT_EQ(topology.caches[1].shared_cpus, 4);
+}
+
+TEST(Topology, FallsBackWithoutSysfs) {
+  const auto topology = ppc::util::DiscoverTopology("/nonexistent/ppc_sysfs");
+  EXPECT_FALSE(topology.cpus.empty());
+  EXPECT_EQ(topology.NumSockets(), 1);
+}
+
+TEST(Topology, PlansCompactAndScatterPlacement) {
+  const auto root = MakeFakeSysfs();
+  const auto topology = ppc::util::DiscoverTopology(root.string());
+  std::filesystem::remove_all(root);
+
+  using ppc::util::AffinityPolicy;
+  EXPECT_EQ(ppc::util::PlanThreadPlacement(topology, AffinityPolicy::kCompact, 8),
+            (std::vector<int>{0, 4, 1, 5, 2, 6, 3, 7}));
+  EXPECT_EQ(ppc::util::PlanThreadPlacement(topology, AffinityPolicy::kScatter, 8),
+            (std::vector<int>{0, 2, 1, 3, 4, 6, 5, 7}));
+  EXPECT_EQ(ppc::util::PlanThreadPlacement(topology, AffinityPolicy::kCompact, 3, 2), (std::vector<int>{1, 5, 2}));
+  EXPECT_EQ(ppc::util::PlanThreadPlacement(topology, AffinityPolicy::kScatter, 2, 8), (std::vector<int>{0, 2}));
+  EXPECT_TRUE(ppc::util::PlanThreadPlacement(topology, AffinityPolicy::kNone, 4).empty());
+}
+
+TEST(GetThreadAffinity, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<std::string>("PPC_THREAD_AFFINITY");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_THREAD_AFFINITY");
+  }
+  EXPECT_EQ(ppc::util::GetThreadAffinity(), ppc::util::AffinityPolicy::kNone);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_THREAD_AFFINITY", *old);
+  }
+}
+
+TEST(GetThreadAffinity, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_THREAD_AFFINITY", "scatter");
+  EXPECT_EQ(ppc::util::GetThreadAffinity(), ppc::util::AffinityPolicy::kScatter);
+  EXPECT_EQ(ppc::util::ToString(ppc::util::GetThreadAffinity()), "scatter");
+}
+
+TEST(GetNumaPlacement, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_NUMA_PLACEMENT", "first_touch");
+  EXPECT_EQ(ppc::util::GetNumaPlacement(), ppc::util::NumaPlacement::kFirstTouch);
+  EXPECT_EQ(ppc::util::ToString(ppc::util::GetNumaPlacement()), "first_touch");
+}
+
+TEST(Topology, PinsThreadToAllowedCpu) {
+  const int cpu = ppc::util::GetCpuTopology().cpus.back().id;
+  bool pinned = false;
+  std::thread([&] { pinned = ppc::util::PinCurrentThread(cpu); }).join();
+#ifdef __linux__
+  EXPECT_TRUE(pinned);
+#endif
+}
+
+TEST(Topology, FirstTouchZeroFillsBuffer) {
+  std::vector<int> data(1000, 7);
+  ppc::util::FirstTouchParallel(std::span<int>(data), 2);
+  for (int value : data) {
+    EXPECT_EQ(value, 0);
+  }
+}
+
+TEST(AlignedAllocator, PlacesLargeBuffersAccordingToEnvironment) {
+  for (const char *placement : {"none", "interleave", "first_touch"}) {
+    env::detail::set_scoped_environment_variable scoped("PPC_NUMA_PLACEMENT", placement);
+    ppc::util::AlignedVector<int> data(ppc::util::kHugePageSize, 7);
+    EXPECT_EQ(std::ranges::count(data, 7), static_cast<std::ptrdiff_t>(data.size())) << placement;
+  }
+}
+
+TEST(AlignedAllocator, VectorDataIsCacheLineAligned) {
+  for (std::size_t size : {1U, 3U, 100U, 4097U}) {
+    ppc::util::AlignedVector<char> data(size);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data.data()) % ppc::util::kCacheLineSize, 0U);
+  }
+}
+
+TEST(AlignedAllocator, LargeBufferIsHugePageAligned) {
+  const std::size_t bytes = (2 * ppc::util::kHugePageSize) + 5;
+  auto *buffer = static_cast<char *>(ppc::util::AllocateBuffer(bytes));
+  buffer[0] = 1;
+  buffer[bytes - 1] = 2;
+#ifdef __linux__
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % ppc::util::kHugePageSize, 0U);
+#endif
+  EXPECT_EQ(buffer[bytes - 1], 2);
+  ppc::util::DeallocateBuffer(buffer, bytes);
+}
+
+TEST(AlignedAllocator, ExplicitHugePagesFallBackWhenPoolIsEmpty) {
+  env::detail::set_scoped_environment_variable scoped("PPC_HUGE_PAGES", "explicit");
+  ppc::util::AlignedVector<double> data(ppc::util::kHugePageSize / sizeof(double), 1.0);
+  EXPECT_EQ(data.back(), 1.0);
+}
+
+TEST(AllocationStats, TracksBytesAndPeak) {
+  ppc::util::ResetAllocationStats();
+  const auto in_use = ppc::util::GetAllocationStats().bytes_in_use;
+  {
+    ppc::util::AlignedVector<double> data(1000);
+    const auto stats = ppc::util::GetAllocationStats();
+    EXPECT_EQ(stats.allocations, 1U);
+    EXPECT_EQ(stats.bytes_allocated, 1000U * sizeof(double));
+    EXPECT_EQ(stats.bytes_in_use, in_use + (1000U * sizeof(double)));
+  }
+  const auto stats = ppc::util::GetAllocationStats();
+  EXPECT_EQ(stats.bytes_in_use, in_use);
+  EXPECT_EQ(stats.peak_bytes, in_use + (1000U * sizeof(double)));
+}
+
+TEST(GetHugePagePolicy, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<std::string>("PPC_HUGE_PAGES");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_HUGE_PAGES");
+  }
+  EXPECT_EQ(ppc::util::GetHugePagePolicy(), ppc::util::HugePagePolicy::kTransparent);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_HUGE_PAGES", *old);
+  }
+}
+
+TEST(GetHugePagePolicy, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_HUGE_PAGES", "none");
+  EXPECT_EQ(ppc::util::GetHugePagePolicy(), ppc::util::HugePagePolicy::kNone);
+  EXPECT_EQ(ppc::util::ToString(ppc::util::GetHugePagePolicy()), "none");
+}
+
+TEST(HeapScope, MeasuresAllocatedBytesAndPeak) {
+  if (!ppc::util::IsHeapTrackingEnabled()) {
+    GTEST_SKIP() << "Heap tracking is unavailable in this build";
+  }
+  constexpr std::size_t kBytes = std::size_t{1} << 20;
+  const ppc::util::HeapScope outer;
+  const auto in_use = ppc::util::GetHeapUsage().bytes_in_use;
+  {
+    const ppc::util::HeapScope inner;
+    std::vector<char> data(kBytes, 1);
+    EXPECT_GE(inner.AllocatedBytes(), kBytes);
+    EXPECT_GE(inner.PeakBytes(), in_use + kBytes);
+  }
+  // The peak of the inner scope stays visible to the enclosing one
+  EXPECT_GE(outer.PeakBytes(), in_use + kBytes);
+  EXPECT_GE(outer.AllocatedBytes(), kBytes);
+}
+
+TEST(HeapScope, KeepsPeaksOfOverlappingScopesApart) {
+  if (!ppc::util::IsHeapTrackingEnabled()) {
+    GTEST_SKIP() << "Heap tracking is unavailable in this build";
+  }
+  constexpr std::size_t kBytes = std::size_t{1} << 20;
+  const ppc::util::HeapScope first;
+  const auto in_use = ppc::util::GetHeapUsage().bytes_in_use;
+  {
+    std::vector<char> data(kBytes, 1);
+  }
+  // A scope opened on another thread after the allocation neither sees it nor hides it from the first scope
+  std::uint64_t first_peak = 0;
+  std::uint64_t second_peak = 0;
+  std::thread([&] {
+    const ppc::util::HeapScope second;
+    second_peak = second.PeakBytes();
+    first_peak = first.PeakBytes();
+  }).join();
+  EXPECT_GE(first_peak, in_use + kBytes);
+  EXPECT_LT(second_peak, in_use + kBytes);
+}
+
+TEST(HeapScope, CountsMappedBuffers) {
+  if (!ppc::util::IsHeapTrackingEnabled()) {
+    GTEST_SKIP() << "Heap tracking is unavailable in this build";
+  }
+  const ppc::util::HeapScope scope;
+  ppc::util::AlignedVector<char> data(ppc::util::kHugePageSize);
+  EXPECT_GE(scope.AllocatedBytes(), ppc::util::kHugePageSize);
+}
+
+TEST(HeapScope, CountsScopesBeyondTheSlotLimitInsteadOfThrowing) {
+  if (!ppc::util::IsHeapTrackingEnabled()) {
+    GTEST_SKIP() << "Heap tracking is unavailable in this build";
+  }
+  constexpr std::size_t kBytes = 1024;
+  const auto overflows = ppc::util::GetHeapScopeOverflows();
+  std::vector<std::unique_ptr<ppc::util::HeapScope>> scopes;
+  while (ppc::util::GetHeapScopeOverflows() == overflows) {
+    ASSERT_NO_THROW(scopes.push_back(std::make_unique<ppc::util::HeapScope>()));
+  }
+  const auto &inert = *scopes.back();
+  EXPECT_FALSE(inert.TracksPeak());
+  EXPECT_TRUE(scopes.front()->TracksPeak());
+  {
+    std::vector<char> data(kBytes, 1);
+  }
+  EXPECT_GE(inert.AllocatedBytes(), kBytes);
+  EXPECT_EQ(inert.PeakBytes(), 0U);
+  scopes.clear();
+  const ppc::util::HeapScope reused;
+  EXPECT_TRUE(reused.TracksPeak());
+}
+
+TEST(GetPeakRss, ReportsResidentMemory) {
+#ifdef __linux__
+  EXPECT_GT(ppc::util::GetPeakRss(), 0U);
+#else
+  GTEST_SKIP();
+#endif
+}
+
+namespace {
+
+std::vector<ppc::util::TraceEvent> EventsNamed(const std::vector<ppc::util::TraceEvent> &events,
+                                               std::string_view name) {
+  std::vector<ppc::util::TraceEvent> matching;
+  std::ranges::copy_if(events, std::back_inserter(matching),
+                       [name](const ppc::util::TraceEvent &event) { return std::string_view(event.name) == name; });
+  return matching;
+}
+
+/// Enables tracing for the lifetime of the object and restores the previous state afterwards.
+class ScopedTracing {
+ public:
+  ScopedTracing() : previous_(ppc::util::IsTracingEnabled()) {
+    ppc::util::SetTracing(true);
+  }
+  ScopedTracing(const ScopedTracing &) = delete;
+  ScopedTracing &operator=(const ScopedTracing &) = delete;
+  ScopedTracing(ScopedTracing &&) = delete;
+  ScopedTracing &operator=(ScopedTracing &&) = delete;
+  ~ScopedTracing() {
+    ppc::util::SetTracing(previous_);
+  }
+
+ private:
+  bool previous_;
+};
+
+}  // namespace
+
+TEST(Tracing, SpanIsRecordedOnlyWhileEnabled) {
+  ppc::util::CollectTraceEvents();
+  const bool previous = ppc::util::IsTracingEnabled();
+  ppc::util::SetTracing(false);
+  { const ppc::util::TraceSpan span("untraced_span"); }
+  ppc::util::SetTracing(previous);
+  {
+    const ScopedTracing tracing;
+    const ppc::util::TraceSpan span("traced_span", "test");
+  }
+  const auto events = ppc::util::CollectTraceEvents();
+  EXPECT_TRUE(EventsNamed(events, "untraced_span").empty());
+  const auto traced = EventsNamed(events, "traced_span");
+  ASSERT_EQ(traced.size(), 1U);
+  EXPECT_STREQ(traced.front().category, "test");
+  EXPECT_LE(traced.front().begin_ns, traced.front().end_ns);
+}
+
+TEST(Tracing, ThreadsRecordIntoSeparateBuffers) {
+  ppc::util::CollectTraceEvents();
+  {
+    const ScopedTracing tracing;
+    { const ppc::util::TraceSpan span("main_thread_span"); }
+    std::thread([] { const ppc::util::TraceSpan span("worker_thread_span"); }).join();
+  }
+  const auto events = ppc::util::CollectTraceEvents();
+  const auto main_span = EventsNamed(events, "main_thread_span");
+  const auto worker_span = EventsNamed(events, "worker_thread_span");
+  ASSERT_EQ(main_span.size(), 1U);
+  ASSERT_EQ(worker_span.size(), 1U);
+  EXPECT_NE(main_span.front().thread, worker_span.front().thread);
+}
+
+TEST(Tracing, FullBufferKeepsLatestEvents) {
+  ppc::util::CollectTraceEvents();
+  std::thread([] {
+    for (std::uint64_t i = 0; i < ppc::util::kTraceBufferCapacity + 10; i++) {
+      ppc::util::RecordTraceEvent("ring_event", "test", i + 1, i + 2);
+    }
+  }).join();
+  const auto events = EventsNamed(ppc::util::CollectTraceEvents(), "ring_event");
+  ASSERT_EQ(events.size(), ppc::util::kTraceBufferCapacity);
+  EXPECT_EQ(events.front().begin_ns, 11U);
+  // Collected events are removed from the buffers
+  EXPECT_TRUE(EventsNamed(ppc::util::CollectTraceEvents(), "ring_event").empty());
+}
+
+TEST(Tracing, InternedNamesAreShared) {
+  const std::string name = "interned_span";
+  const char *interned = ppc::util::InternTraceName(name);
+  EXPECT_STREQ(interned, "interned_span");
+  EXPECT_EQ(ppc::util::InternTraceName("interned_span"), interned);
+}
+
+TEST(Tracing, FormatsChromeTraceEvents) {
+  const std::vector<ppc::util::TraceEvent> events = {
+      {.name = "Run", .category = "stage", .begin_ns = 3000, .end_ns = 5500, .bytes = 0, .thread = 0},
+      {.name = "Send", .category = "mpi", .begin_ns = 4000, .end_ns = 4500, .bytes = 64, .thread = 1}};
+  const auto json = nlohmann::json::parse("[" + ppc::util::FormatTraceEvents(events, 2, 1000) + "]");
+  std::vector<nlohmann::json> spans;
+  std::ranges::copy_if(json, std::back_inserter(spans), [](const nlohmann::json &e) { return e["ph"] == "X"; });
+  ASSERT_EQ(spans.size(), 2U);
+  EXPECT_EQ(spans[0]["name"], "Run");
+  EXPECT_EQ(spans[0]["pid"].get<int>(), 2);
+  EXPECT_DOUBLE_EQ(spans[0]["ts"].get<double>(), 2.0);
+  EXPECT_DOUBLE_EQ(spans[0]["dur"].get<double>(), 2.5);
+  EXPECT_FALSE(spans[0].contains("args"));
+  EXPECT_EQ(spans[1]["tid"].get<int>(), 1);
+  EXPECT_EQ(spans[1]["args"]["bytes"].get<std::uint64_t>(), 64U);
+  // Process name plus one name per thread
+  EXPECT_EQ(std::ranges::count_if(json, [](const nlohmann::json &e) { return e["name"] == "thread_name"; }), 2);
+}
+
+TEST(Tracing, WritesTraceFileWithoutMpi) {
+  ppc::util::CollectTraceEvents();
+  {
+    const ScopedTracing tracing;
+    const ppc::util::TraceSpan span("written_span");
+  }
+  const auto path = std::filesystem::temp_directory_path() / "ppc_trace_test" / "trace.json";
+  ppc::util::WriteTrace(path);
+  std::ifstream file(path);
+  const auto json = nlohmann::json::parse(file);
+  std::filesystem::remove_all(path.parent_path());
+  ASSERT_TRUE(json.contains("traceEvents"));
+  const auto &trace_events = json["traceEvents"];
+  auto is_written_span = [](const nlohmann::json &event) { return event["name"] == "written_span"; };
+  EXPECT_EQ(std::ranges::count_if(trace_events, is_written_span), 1);
+}
+
+TEST(GetTraceFile, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<std::string>("PPC_TRACE_FILE");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_TRACE_FILE");
+  }
+  EXPECT_TRUE(ppc::util::GetTraceFile().empty());
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_TRACE_FILE", *old);
+  }
+}
+
+TEST(GetTraceFile, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_TRACE_FILE", "trace.json");
+  EXPECT_EQ(ppc::util::GetTraceFile(), "trace.json");
+}
+
+TEST(BlockDistribution, SpreadsRemainderOverFirstParts) {
+  const ppc::util::BlockDistribution dist(10, 4);
+  EXPECT_EQ(dist.Counts(), (std::vector<int>{3, 3, 2, 2}));
+  EXPECT_EQ(dist.Displacements(), (std::vector<int>{0, 3, 6, 8}));
+  EXPECT_EQ(dist.Counts(5), (std::vector<int>{15, 15, 10, 10}));
+  EXPECT_EQ(dist.Range(2), (ppc::util::IndexRange{.begin = 6, .end = 8}));
+  for (int part = 0; part < dist.Parts(); part++) {
+    const auto range = dist.Range(part);
+    for (auto index = range.begin; index < range.end; index++) {
+      EXPECT_EQ(dist.Owner(index), part);
+    }
+  }
+}
+
+TEST(BlockDistribution, HandlesFewerItemsThanParts) {
+  const ppc::util::BlockDistribution dist(2, 4);
+  EXPECT_EQ(dist.Counts(), (std::vector<int>{1, 1, 0, 0}));
+  EXPECT_EQ(dist.Offset(3), 2U);
+  EXPECT_EQ(dist.Owner(1), 1);
+  EXPECT_THROW(ppc::util::BlockDistribution(2, 0), std::invalid_argument);
+}
+
+TEST(BlockCyclicDistribution, DealsBlocksInTurn) {
+  // Blocks of 3 over 2 parts: [0,3) [6,9) to part 0, [3,6) [9,10) to part 1
+  const ppc::util::BlockCyclicDistribution dist(10, 2, 3);
+  EXPECT_EQ(dist.Count(0), 6U);
+  EXPECT_EQ(dist.Count(1), 4U);
+  EXPECT_EQ(dist.Ranges(1), (std::vector<ppc::util::IndexRange>{{.begin = 3, .end = 6}, {.begin = 9, .end = 10}}));
+  for (std::size_t index = 0; index < dist.Total(); index++) {
+    const int owner = dist.Owner(index);
+    EXPECT_LT(dist.LocalIndex(index), dist.Count(owner));
+    EXPECT_EQ(dist.GlobalIndex(owner, dist.LocalIndex(index)), index);
+  }
+  EXPECT_THROW(ppc::util::BlockCyclicDistribution(10, 2, 0), std::invalid_argument);
+}
+
+TEST(MatrixDistribution, SplitsRowsColumnsAndTiles) {
+  const ppc::util::MatrixDistribution rows(5, 4, 2, ppc::util::MatrixLayout::kRows);
+  EXPECT_EQ(rows.LocalRows(0), 3U);
+  EXPECT_EQ(rows.LocalCols(0), 4U);
+  EXPECT_EQ(rows.RowRange(1), (ppc::util::IndexRange{.begin = 3, .end = 5}));
+
+  const ppc::util::MatrixDistribution columns(5, 4, 3, ppc::util::MatrixLayout::kColumns);
+  EXPECT_EQ(columns.LocalRows(2), 5U);
+  EXPECT_EQ(columns.LocalCols(0), 2U);
+  EXPECT_EQ(columns.ColRange(2), (ppc::util::IndexRange{.begin = 3, .end = 4}));
+
+  const ppc::util::MatrixDistribution tiles(5, 7, 6, ppc::util::MatrixLayout::kTiles);
+  EXPECT_EQ(tiles.GridRows(), 2);
+  EXPECT_EQ(tiles.GridCols(), 3);
+  std::size_t covered = 0;
+  for (int part = 0; part < tiles.Parts(); part++) {
+    covered += tiles.LocalSize(part);
+    EXPECT_EQ(tiles.Owner(tiles.RowRange(part).begin, tiles.ColRange(part).begin), part);
+  }
+  EXPECT_EQ(covered, 35U);
+}
+
+TEST(MpiDatatype, MapsArithmeticTypes) {
+  EXPECT_EQ(ppc::util::MpiDatatype<double>(), MPI_DOUBLE);
+  EXPECT_EQ(ppc::util::MpiDatatype<const int>(), MPI_INT);
+  EXPECT_EQ(ppc::util::MpiDatatype<char>(), MPI_CHAR);
+}
+
+TEST(HaloExchange, PadsBlocksWithGhostRegions) {
+  const ppc::util::BlockDistribution vector(10, 4);
+  EXPECT_EQ(ppc::util::HaloExchange::PaddedSize(vector, 0, {.before = 0, .after = 1}), 4U);
+  EXPECT_EQ(ppc::util::HaloExchange::PaddedSize(vector, 3, {.before = 2, .after = 1}, 5), 25U);
+
+  const ppc::util::MatrixDistribution tiles(5, 7, 6, ppc::util::MatrixLayout::kTiles);
+  EXPECT_EQ(ppc::util::HaloExchange::PaddedSize(tiles, 0, 1), 5U * 5U);
+  EXPECT_EQ(ppc::util::HaloExchange::PaddedSize(tiles, 5, 2), 6U * 6U);
+}
+
+namespace {
+
+/// core_func_tests runs without mpirun, so the tests that need a communicator start MPI as a singleton process.
+void EnsureMpiInitialized() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized != 0) {
+    return;
+  }
+  int provided = 0;
+  MPI_Init_thread(nullptr, nullptr, MPI_THREAD_FUNNELED, &provided);
+  std::atexit([] {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (finalized == 0) {
+      MPI_Finalize();
+    }
+  });
+}
+
+}  // namespace
+
+TEST(IterationExchange, SkipsSelfEmptyBlocksAndDuplicateSources) {
+  // Parts 3 and 4 own no items
+  const ppc::util::BlockDistribution dist(3, 5);
+  const std::vector<int> candidates = {4, 2, 1, 0, 2, 3, 0};
+  EXPECT_EQ(ppc::util::detail::SourcesWithBlocks(dist, 1, candidates), (std::vector<int>{0, 2}));
+  EXPECT_TRUE(ppc::util::detail::SourcesWithBlocks(dist, 0, std::vector<int>{0, 3, 4}).empty());
+}
+
+TEST(IterationExchange, RejectsSourcesOutsideTheCommunicator) {
+  const ppc::util::BlockDistribution dist(3, 5);
+  EXPECT_THROW((void)ppc::util::detail::SourcesWithBlocks(dist, 0, std::vector<int>{1, 5}), std::invalid_argument);
+  EXPECT_THROW((void)ppc::util::detail::SourcesWithBlocks(dist, 0, std::vector<int>{-1}), std::invalid_argument);
+}
+
+TEST(IterationExchange, RejectsMismatchedDistributionDisabledValgrind) {
+  EnsureMpiInitialized();
+  std::vector<double> x(4);
+  const std::vector<int> sources = {1};
+  EXPECT_THROW(ppc::util::IterationExchange exchange(ppc::util::BlockDistribution(4, 2), x, MPI_COMM_SELF),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::util::IterationExchange exchange(ppc::util::BlockDistribution(5, 1), x, MPI_COMM_SELF),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::util::IterationExchange exchange(ppc::util::BlockDistribution(5, 1), sources, x, MPI_COMM_SELF),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::util::IterationExchange exchange(ppc::util::BlockDistribution(4, 1), sources, x, MPI_COMM_SELF),
+               std::invalid_argument);
+}
+
+TEST(IterationExchange, SingleProcessReturnsLocalResidualDisabledValgrind) {
+  EnsureMpiInitialized();
+  const ppc::util::BlockDistribution dist(4, 1);
+  std::vector<double> x = {1.0, 2.0, 3.0, 4.0};
+
+  ppc::util::IterationExchange dense(dist, x, MPI_COMM_WORLD);
+  EXPECT_TRUE(dense.Sources().empty());
+  EXPECT_DOUBLE_EQ(dense.Exchange(2.5), 2.5);
+  dense.Start(0.5);
+  EXPECT_TRUE(dense.InFlight());
+  EXPECT_THROW(dense.Start(0.5), std::logic_error);
+  EXPECT_DOUBLE_EQ(dense.Finish(), 0.5);
+  EXPECT_FALSE(dense.InFlight());
+
+  const std::vector<int> sources = {0, 0};
+  ppc::util::IterationExchange sparse(dist, sources, x, MPI_COMM_WORLD, MPI_MAX);
+  EXPECT_TRUE(sparse.Sources().empty());
+  EXPECT_DOUBLE_EQ(sparse.Exchange(-1.5), -1.5);
+  EXPECT_EQ(x, (std::vector<double>{1.0, 2.0, 3.0, 4.0}));
+}
+
+TEST(MpiProfiler, AccumulatesBlockedTimeWithoutProfileDisabledValgrind) {
+  EnsureMpiInitialized();
+  if (!ppc::util::MeasuresMPIBlockedTime()) {
+    GTEST_SKIP() << "The MPI wrappers are not built on this platform";
+  }
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_MPI_PROFILE", "0");
+  const double before = ppc::util::GetMPIBlockedTime();
+  for (int i = 0; i < 1000; i++) {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+  EXPECT_GT(ppc::util::GetMPIBlockedTime(), before);
+}
+
+TEST(MpiProfiler, LeavesNonblockingCallsOutOfBlockedTime) {
+  EnsureMpiInitialized();
+  if (!ppc::util::MeasuresMPIBlockedTime()) {
+    GTEST_SKIP() << "The MPI wrappers are not built on this platform";
+  }
+  const double before = ppc::util::GetMPIBlockedTime();
+  int sent = 42;
+  int received = 0;
+  std::array<MPI_Request, 2> requests{};
+  MPI_Irecv(&received, 1, MPI_INT, 0, 0, MPI_COMM_SELF, requests.data());
+  MPI_Isend(&sent, 1, MPI_INT, 0, 0, MPI_COMM_SELF, &requests[1]);
+  int done = 0;
+  while (done == 0) {
+    MPI_Testall(static_cast<int>(requests.size()), requests.data(), &done, MPI_STATUSES_IGNORE);
+  }
+  EXPECT_EQ(received, sent);
+  EXPECT_DOUBLE_EQ(ppc::util::GetMPIBlockedTime(), before);
+}
+
+TEST(HaloExchange, FindsNeighboursWithItems) {
+  using ppc::util::HaloExchange;
+  using ppc::util::HaloSide;
+  // Parts 2 and 3 own no items
+  const ppc::util::BlockDistribution vector(2, 4);
+  EXPECT_FALSE(HaloExchange::HasNeighbour(vector, 0, HaloSide::kBefore));
+  EXPECT_TRUE(HaloExchange::HasNeighbour(vector, 0, HaloSide::kAfter));
+  EXPECT_TRUE(HaloExchange::HasNeighbour(vector, 1, HaloSide::kBefore));
+  EXPECT_FALSE(HaloExchange::HasNeighbour(vector, 1, HaloSide::kAfter));
+  EXPECT_FALSE(HaloExchange::HasNeighbour(vector, 2, HaloSide::kBefore));
+  EXPECT_FALSE(HaloExchange::HasNeighbour(vector, 2, HaloSide::kAfter));
+  EXPECT_FALSE(HaloExchange::HasNeighbour(vector, 0, HaloSide::kRight));
+
+  // A 2 x 2 grid of tiles whose lower row holds no matrix rows
+  const ppc::util::MatrixDistribution tiles(1, 6, 4, ppc::util::MatrixLayout::kTiles);
+  ASSERT_EQ(tiles.GridRows(), 2);
+  EXPECT_TRUE(HaloExchange::HasNeighbour(tiles, 0, HaloSide::kRight));
+  EXPECT_FALSE(HaloExchange::HasNeighbour(tiles, 0, HaloSide::kAfter));
+  EXPECT_TRUE(HaloExchange::HasNeighbour(tiles, 1, HaloSide::kLeft));
+  for (HaloSide side : {HaloSide::kBefore, HaloSide::kAfter, HaloSide::kLeft, HaloSide::kRight}) {
+    EXPECT_FALSE(HaloExchange::HasNeighbour(tiles, 2, side));
+    EXPECT_FALSE(HaloExchange::HasNeighbour(ppc::util::BlockDistribution(5, 1), 0, side));
+  }
+}
+
+TEST(HaloExchange, RejectsWideGhostRegionsOnEveryRankDisabledValgrind) {
+  EnsureMpiInitialized();
+  // The second part owns one item but has to fill two ghosts after the first one. The width is checked before the
+  // communicator, so even a process outside the distribution throws this error.
+  std::vector<int> buffer(4);
+  try {
+    ppc::util::HaloExchange halo(ppc::util::BlockDistribution(3, 2), {.after = 2}, buffer, MPI_COMM_SELF);
+    ADD_FAILURE() << "The halo exchange accepted a ghost region wider than its source block";
+  } catch (const std::invalid_argument &error) {
+    EXPECT_NE(std::string_view(error.what()).find("ghost region"), std::string_view::npos) << error.what();
+  }
+
+  std::vector<int> tile(9);
+  EXPECT_THROW(ppc::util::HaloExchange halo(ppc::util::MatrixDistribution(3, 4, 2, ppc::util::MatrixLayout::kRows),
+                                            2, ppc::util::HaloShape::kFaces, tile, MPI_COMM_SELF),
+               std::invalid_argument);
+  // Empty blocks fill no ghosts, so only the communicator mismatch remains
+  try {
+    ppc::util::HaloExchange halo(ppc::util::BlockDistribution(1, 3), {.before = 5, .after = 5}, buffer, MPI_COMM_SELF);
+    ADD_FAILURE() << "The halo exchange accepted a distribution of three parts on one process";
+  } catch (const std::invalid_argument &error) {
+    EXPECT_EQ(std::string_view(error.what()).find("ghost region"), std::string_view::npos) << error.what();
+  }
+}
+
+TEST(HaloExchange, RejectsMismatchedBufferDisabledValgrind) {
+  EnsureMpiInitialized();
+  const ppc::util::BlockDistribution vector(4, 1);
+  std::vector<double> buffer(5);
+  EXPECT_THROW(ppc::util::HaloExchange halo(vector, {.before = 1, .after = 1}, buffer, MPI_COMM_WORLD),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::util::HaloExchange halo(vector, {.before = 1}, buffer, MPI_COMM_WORLD, 2), std::invalid_argument);
+  std::vector<double> tile(35);
+  EXPECT_THROW(ppc::util::HaloExchange halo(ppc::util::MatrixDistribution(5, 7, 1, ppc::util::MatrixLayout::kTiles), 1,
+                                            ppc::util::HaloShape::kFaces, tile, MPI_COMM_WORLD),
+               std::invalid_argument);
+}
+
+TEST(HaloExchange, SingleProcessHasNoNeighboursDisabledValgrind) {
+  EnsureMpiInitialized();
+  using ppc::util::HaloSide;
+  const std::vector<HaloSide> sides = {HaloSide::kBefore, HaloSide::kAfter, HaloSide::kLeft, HaloSide::kRight};
+
+  std::vector<int> buffer = {-1, 1, 2, 3, -1};
+  ppc::util::HaloExchange vector(ppc::util::BlockDistribution(3, 1), {.before = 1, .after = 1}, buffer);
+  vector.Exchange();
+  for (HaloSide side : sides) {
+    EXPECT_FALSE(vector.HasNeighbour(side));
+  }
+  EXPECT_EQ(buffer, (std::vector<int>{-1, 1, 2, 3, -1}));
+
+  std::vector<int> empty(2, -1);
+  ppc::util::HaloExchange empty_block(ppc::util::BlockDistribution(0, 1), {.before = 1, .after = 1}, empty);
+  empty_block.Exchange();
+  std::vector<double> tile(ppc::util::HaloExchange::PaddedSize(
+      ppc::util::MatrixDistribution(2, 3, 1, ppc::util::MatrixLayout::kTiles), 0, 1));
+  ppc::util::HaloExchange matrix(ppc::util::MatrixDistribution(2, 3, 1, ppc::util::MatrixLayout::kTiles), 1,
+                                 ppc::util::HaloShape::kFacesAndCorners, tile);
+  matrix.Exchange();
+  for (HaloSide side : sides) {
+    EXPECT_FALSE(empty_block.HasNeighbour(side));
+    EXPECT_FALSE(matrix.HasNeighbour(side));
+  }
+  EXPECT_EQ(empty, (std::vector<int>{-1, -1}));
+}
+
+TEST(Collectives, SelectsBroadcastAlgorithmByMessageAndCommunicatorSize) {
+  using ppc::util::BroadcastAlgorithm;
+  using ppc::util::SelectBroadcastAlgorithm;
+  EXPECT_EQ(SelectBroadcastAlgorithm(16, 64, 64), BroadcastAlgorithm::kBinomial);
+  EXPECT_EQ(SelectBroadcastAlgorithm(1 << 16, 1 << 18, 4), BroadcastAlgorithm::kBinomial);
+  EXPECT_EQ(SelectBroadcastAlgorithm(1 << 16, 1 << 18, 16), BroadcastAlgorithm::kScatterAllgather);
+  EXPECT_EQ(SelectBroadcastAlgorithm(1 << 20, 1 << 23, 16), BroadcastAlgorithm::kPipelinedChain);
+  EXPECT_EQ(SelectBroadcastAlgorithm(16, 64, 16, 4), BroadcastAlgorithm::kHierarchical);
+  EXPECT_EQ(SelectBroadcastAlgorithm(16, 64, 4, 4), BroadcastAlgorithm::kBinomial);
+}
+
+TEST(Collectives, SelectsReductionAlgorithmByMessageAndCommunicatorSize) {
+  using ppc::util::AllreduceAlgorithm;
+  using ppc::util::SelectAllreduceAlgorithm;
+  EXPECT_EQ(SelectAllreduceAlgorithm(4, 32, 8), AllreduceAlgorithm::kRecursiveDoubling);
+  EXPECT_EQ(SelectAllreduceAlgorithm(3, 1 << 16, 8), AllreduceAlgorithm::kRecursiveDoubling);
+  EXPECT_EQ(SelectAllreduceAlgorithm(1 << 16, 1 << 19, 6), AllreduceAlgorithm::kRabenseifner);
+  EXPECT_EQ(SelectAllreduceAlgorithm(1 << 20, 1 << 23, 8), AllreduceAlgorithm::kRabenseifner);
+  EXPECT_EQ(SelectAllreduceAlgorithm(1 << 20, 1 << 23, 6), AllreduceAlgorithm::kRing);
+  EXPECT_EQ(SelectAllreduceAlgorithm(1 << 20, 1 << 23, 8, 2), AllreduceAlgorithm::kHierarchical);
+  EXPECT_EQ(ppc::util::SelectReduceAlgorithm(16, 64, 8), ppc::util::ReduceAlgorithm::kBinomial);
+  EXPECT_EQ(ppc::util::SelectReduceAlgorithm(1 << 20, 1 << 23, 8), ppc::util::ReduceAlgorithm::kPipelinedChain);
+}
+
+TEST(Collectives, NamesAlgorithms) {
+  EXPECT_EQ(ppc::util::GetAlgorithmName(ppc::util::AllreduceAlgorithm::kRabenseifner), "rabenseifner");
+  EXPECT_EQ(ppc::util::GetAlgorithmName(ppc::util::BroadcastAlgorithm::kPipelinedChain), "pipelined_chain");
+  EXPECT_EQ(ppc::util::GetAlgorithmName(ppc::util::ReduceAlgorithm::kBinomial), "binomial");
+}
+
+TEST(Reduction, CombinesElementsWithOperators) {
+  const std::vector<int> in = {1, 8, -3, 6};
+  std::vector<int> inout = {4, 2, -5, 6};
+  ppc::util::CombineElements(in.data(), inout.data(), in.size(), ppc::util::Max{});
+  EXPECT_EQ(inout, (std::vector<int>{4, 8, -3, 6}));
+  ppc::util::CombineElements(in.data(), inout.data(), in.size(), ppc::util::BitXor{});
+  EXPECT_EQ(inout, (std::vector<int>{5, 0, 0, 0}));
+
+  const std::vector<double> values = {0.5, 2.0};
+  std::vector<double> product = {4.0, 0.25};
+  ppc::util::MakeReduction<double>(ppc::util::Prod{})(values.data(), product.data(), values.size());
+  EXPECT_EQ(product, (std::vector<double>{2.0, 0.5}));
+}
+
+TEST(Reduction, CombinesStructsThroughLambdas) {
+  struct Extent {
+    double low;
+    double high;
+  };
+  auto merge = [](const Extent &lhs, const Extent &rhs) {
+    return Extent{.low = std::min(lhs.low, rhs.low), .high = std::max(lhs.high, rhs.high)};
+  };
+  const std::vector<Extent> in = {{.low = -1.0, .high = 1.0}, {.low = 3.0, .high = 4.0}};
+  std::vector<Extent> inout = {{.low = 0.0, .high = 2.0}, {.low = 1.0, .high = 3.5}};
+  const auto reduction = ppc::util::MakeReduction<Extent>(merge);
+  reduction(in.data(), inout.data(), in.size());
+  EXPECT_EQ(inout[0].low, -1.0);
+  EXPECT_EQ(inout[0].high, 2.0);
+  EXPECT_EQ(inout[1].low, 1.0);
+  EXPECT_EQ(inout[1].high, 4.0);
+}
+
+TEST(Reduction, CompilesPredefinedOperations) {
+  const std::vector<float> in = {1.5F, -2.0F};
+  std::vector<float> inout = {1.0F, -3.0F};
+  const auto reduction = ppc::util::PredefinedReduction(MPI_MIN, MPI_FLOAT);
+  ASSERT_NE(reduction.combine, nullptr);
+  reduction(in.data(), inout.data(), in.size());
+  EXPECT_EQ(inout, (std::vector<float>{1.0F, -3.0F}));
+
+  EXPECT_NE(ppc::util::PredefinedReduction(MPI_BOR, MPI_UINT64_T).combine, nullptr);
+  EXPECT_EQ(ppc::util::PredefinedReduction(MPI_BAND, MPI_DOUBLE).combine, nullptr);
+  EXPECT_EQ(ppc::util::PredefinedReduction(MPI_MAXLOC, MPI_DOUBLE_INT).combine, nullptr);
+}
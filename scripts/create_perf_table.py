@@ -19,9 +19,10 @@ NEW_PATTERN = re.compile(
 # Example formats:
 #   example_threads_omp_enabled:task_run:0.4749
 #   example_processes_2_mpi_enabled:pipeline:0.0507
-# Accept optional suffix after `_enabled` (e.g., `_enabled_size1000000`) before the colon
+# Accept optional suffix after `_enabled` (e.g., `_enabled_size1000000`) before the colon;
+# the suffix is kept in the task name so every size of a ladder gets its own row
 SIMPLE_PATTERN = re.compile(
-    r"(.+?)_(omp|seq|tbb|stl|all|mpi)_enabled[^:]*:(task_run|pipeline):(-*\d*\.\d*)"
+    r"(.+?)_(omp|seq|tbb|stl|all|mpi)_enabled([^:]*):(task_run|pipeline):(-*\d*\.\d*)"
 )
 
 
@@ -177,10 +178,10 @@ for line in logs_lines:
         tasks_by_category[task_category].add(task_name)
     elif len(simple_result):
         # Extract task name in the current format (prefix already includes category suffix)
-        task_name = simple_result[0][0]
+        task_name = simple_result[0][0] + simple_result[0][2]
         # Infer category by substring
         task_category = "threads" if "threads" in task_name else "processes"
-        perf_type = simple_result[0][2]
+        perf_type = simple_result[0][3]
 
         # no set tracking needed; category mapping below
 
@@ -227,12 +228,12 @@ for line in logs_lines:
         tasks_by_category[task_category].add(task_name)
     elif len(simple_result):
         # Extract details from the simplified pattern (current logs)
-        task_name = simple_result[0][0]
+        task_name = simple_result[0][0] + simple_result[0][2]
         # Infer category by substring present in task_name
         task_category = "threads" if "threads" in task_name else "processes"
         task_type = simple_result[0][1]
-        perf_type = simple_result[0][2]
-        perf_time = float(simple_result[0][3])
+        perf_type = simple_result[0][3]
+        perf_time = float(simple_result[0][4])
 
         if perf_type not in result_tables:
             result_tables[perf_type] = {}
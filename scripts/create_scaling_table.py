@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Build strong/weak scaling tables from perf result records.
+
+Input is the JSON Lines file written by ``scripts/run_tests.py --running-type scaling``
+(one record per perf test run, see ``PPC_PERF_RESULTS_FILE``). For every task, technology
+and perf mode the script reports speedup, parallel efficiency and the Karp-Flatt metric
+(experimentally determined serial fraction) for each worker count.
+"""
+
+import argparse
+import csv
+import json
+import os
+import sys
+
+PROCESS_TECHNOLOGIES = {"mpi", "all"}
+THREAD_TECHNOLOGIES = {"omp", "tbb", "stl"}
+
+COLUMNS = [
+    "task",
+    "mode",
+    "technology",
+    "problem_scale",
+    "workers",
+    "time_sec",
+    "baseline",
+    "speedup",
+    "efficiency",
+    "karp_flatt",
+]
+# Weak-scaling rows are grouped by the input each worker gets instead of the problem scale
+WEAK_COLUMNS = [
+    "input_per_worker" if column == "problem_scale" else column for column in COLUMNS
+]
+
+
+def load_records(path: str) -> list[dict]:
+    records = []
+    with open(path, "r") as results_file:
+        for line in results_file:
+            if line.strip():
+                records.append(json.loads(line))
+    return records
+
+
+def task_name(record: dict) -> str:
+    # "<task>_<technology>_enabled<suffix>" -> "<task><suffix>", keeping size-ladder tags such as "_size1000"
+    task_id = record["task_id"]
+    token = f"_{record['technology']}_"
+    pos = task_id.rfind(token)
+    if pos < 0:
+        return task_id
+    rest = task_id[pos + len(token) :]
+    suffix = rest[rest.find("_") :] if "_" in rest else ""
+    return task_id[:pos] + suffix
+
+
+def worker_count(record: dict) -> int:
+    technology = record["technology"]
+    if technology in PROCESS_TECHNOLOGIES:
+        return int(record.get("num_proc", 1))
+    if technology in THREAD_TECHNOLOGIES:
+        return int(record.get("num_threads", 1))
+    return 1
+
+
+def group_size(record: dict, scaling_mode: str) -> float:
+    if scaling_mode == "strong":
+        return round(float(record.get("problem_scale", 1.0)), 6)
+    # Weak-scaling runs multiply the problem scale by the worker count, but only tasks that size their input with
+    # ScalePerfSize follow it, so group by the recorded input per worker rather than by the scale
+    return round(int(record.get("input_size", 0)) / worker_count(record), 6)
+
+
+def drop_unscaled(records: list[dict]) -> list[dict]:
+    """Drops weak-scaling records whose input size is unknown or does not follow the problem scale."""
+    sizes = {}
+    for record in records:
+        config = (task_name(record), record["mode"], record["technology"])
+        sizes.setdefault(config, {}).setdefault(int(record.get("input_size", 0)), set()).add(
+            round(float(record.get("problem_scale", 1.0)), 6)
+        )
+    unscaled = {
+        config
+        for config, scales_by_size in sizes.items()
+        if 0 in scales_by_size
+        or any(len(scales) > 1 for scales in scales_by_size.values())
+    }
+    for task, mode, technology in sorted(unscaled):
+        print(
+            f"Skipping {task} ({technology}, {mode}): its recorded input size is unknown or does not grow with "
+            "PPC_PERF_PROBLEM_SCALE, so it cannot be weak-scaled",
+            file=sys.stderr,
+        )
+    return [
+        record
+        for record in records
+        if (task_name(record), record["mode"], record["technology"]) not in unscaled
+    ]
+
+
+def karp_flatt(speedup: float, workers: int):
+    if workers <= 1 or speedup <= 0.0:
+        return None
+    return (1.0 / speedup - 1.0 / workers) / (1.0 - 1.0 / workers)
+
+
+def build_rows(records: list[dict], scaling_mode: str) -> list[dict]:
+    if scaling_mode == "weak":
+        records = drop_unscaled(records)
+    # Later records of the same configuration replace earlier ones
+    times = {}
+    for record in records:
+        key = (
+            task_name(record),
+            record["mode"],
+            record["technology"],
+            group_size(record, scaling_mode),
+            worker_count(record),
+        )
+        times[key] = float(record["time_sec"])
+
+    rows = []
+    size_column = "problem_scale" if scaling_mode == "strong" else "input_per_worker"
+    for (task, mode, technology, size, workers), time_sec in sorted(times.items()):
+        if technology == "seq":
+            continue
+        # Prefer the same technology on one worker, fall back to the sequential version
+        baseline = "self"
+        reference = times.get((task, mode, technology, size, 1))
+        if reference is None:
+            baseline = "seq"
+            reference = times.get((task, mode, "seq", size, 1))
+
+        speedup = efficiency = None
+        if reference is not None and reference > 0.0 and time_sec > 0.0:
+            if scaling_mode == "strong":
+                speedup = reference / time_sec
+                efficiency = speedup / workers
+            else:
+                # Scaled (Gustafson) speedup: the work grows with the worker count
+                efficiency = reference / time_sec
+                speedup = efficiency * workers
+        rows.append(
+            {
+                "task": task,
+                "mode": mode,
+                "technology": technology,
+                size_column: size,
+                "workers": workers,
+                "time_sec": time_sec,
+                "baseline": baseline if reference is not None else "",
+                "speedup": speedup,
+                "efficiency": efficiency,
+                "karp_flatt": karp_flatt(speedup, workers) if speedup else None,
+            }
+        )
+    return rows
+
+
+def _format(value) -> str:
+    if value is None:
+        return "—"
+    if isinstance(value, float):
+        return f"{value:.4f}"
+    return str(value)
+
+
+def write_csv(path: str, rows: list[dict], columns: list[str]):
+    with open(path, "w", newline="") as csvfile:
+        writer = csv.writer(csvfile)
+        writer.writerow(columns)
+        for row in rows:
+            writer.writerow(
+                ["" if row[col] is None else row[col] for col in columns]
+            )
+
+
+def print_table(rows: list[dict], columns: list[str]):
+    widths = {
+        col: max([len(col)] + [len(_format(row[col])) for row in rows])
+        for col in columns
+    }
+    print(" | ".join(col.ljust(widths[col]) for col in columns))
+    print("-+-".join("-" * widths[col] for col in columns))
+    for row in rows:
+        print(" | ".join(_format(row[col]).ljust(widths[col]) for col in columns))
+
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "-i",
+    "--input",
+    help="Input file path (perf result records, .jsonl)",
+    required=True,
+)
+parser.add_argument(
+    "-o", "--output", help="Output directory for scaling tables (.csv)", required=True
+)
+parser.add_argument(
+    "--scaling-mode",
+    choices=["strong", "weak"],
+    default="strong",
+    help="Scaling type the records were collected with",
+)
+args = parser.parse_args()
+
+scaling_rows = build_rows(load_records(os.path.abspath(args.input)), args.scaling_mode)
+table_columns = COLUMNS if args.scaling_mode == "strong" else WEAK_COLUMNS
+os.makedirs(os.path.abspath(args.output), exist_ok=True)
+write_csv(
+    os.path.join(os.path.abspath(args.output), f"{args.scaling_mode}_scaling.csv"),
+    scaling_rows,
+    table_columns,
+)
+print_table(scaling_rows, table_columns)
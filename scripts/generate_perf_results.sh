@@ -2,5 +2,7 @@
 set -euo pipefail
 
 mkdir -p build/perf_stat_dir
+rm -f build/perf_stat_dir/perf_results.jsonl
+export PPC_PERF_RESULTS_FILE="${PPC_PERF_RESULTS_FILE:-build/perf_stat_dir/perf_results.jsonl}"
 scripts/run_tests.py --running-type="performance" | tee build/perf_stat_dir/perf_log.txt
 python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_log.txt --output build/perf_stat_dir
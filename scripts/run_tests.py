@@ -14,7 +14,7 @@ def init_cmd_args():
     parser.add_argument(
         "--running-type",
         required=True,
-        choices=["threads", "processes", "performance"],
+        choices=["threads", "processes", "performance", "scaling"],
         help="Specify the execution mode. Choose 'threads' for multithreading or 'processes' for multiprocessing.",
     )
     parser.add_argument(
@@ -29,6 +29,54 @@ def init_cmd_args():
         type=int,
         help="List of process/thread counts to run sequentially",
     )
+    parser.add_argument(
+        "--scaling-mode",
+        choices=["strong", "weak"],
+        default="strong",
+        help="Scaling sweep type: fixed problem size (strong) or problem size grown with the worker count (weak).",
+    )
+    parser.add_argument(
+        "--procs",
+        nargs="+",
+        type=int,
+        default=[1, 2, 4],
+        help="Process counts of the MPI part of a scaling sweep",
+    )
+    parser.add_argument(
+        "--threads",
+        nargs="+",
+        type=int,
+        default=[1, 2, 4],
+        help="Thread counts of the threading part of a scaling sweep",
+    )
+    parser.add_argument(
+        "--problem-scales",
+        nargs="+",
+        type=float,
+        default=[1.0],
+        help="Base problem-size multipliers (PPC_PERF_PROBLEM_SCALE) of a scaling sweep",
+    )
+    parser.add_argument(
+        "--results-file",
+        default=None,
+        help="JSON Lines file receiving scaling sweep records (default: build/perf_stat_dir/scaling_results.jsonl)",
+    )
+    parser.add_argument(
+        "--baseline-dir",
+        default=None,
+        help="Directory of stored perf baselines (PPC_PERF_BASELINE_DIR); perf runs fail on significant slowdowns",
+    )
+    parser.add_argument(
+        "--update-baseline",
+        action="store_true",
+        help="Store the results of this perf run as the new baselines instead of comparing against them",
+    )
+    parser.add_argument(
+        "--regression-threshold",
+        type=float,
+        default=None,
+        help="Relative median slowdown tolerated by the baseline comparison (PPC_PERF_REGRESSION_THRESHOLD)",
+    )
     parser.add_argument(
         "--verbose", action="store_true", help="Print commands executed by the script"
     )
@@ -131,41 +179,33 @@ class PPCRunner:
             return "mpich", "-n"
         return "unknown", "-np"
 
+    def __forwarded_env_vars(self):
+        # Thread counts plus every perf knob (PPC_PERF_*) must reach all ranks
+        perf_vars = sorted(k for k in self.__ppc_env if k.startswith("PPC_PERF_"))
+        return ["PPC_NUM_THREADS", "OMP_NUM_THREADS"] + perf_vars
+
     def __build_mpi_cmd(self, ppc_num_proc, additional_mpi_args):
         base = [self.mpi_exec] + shlex.split(additional_mpi_args)
 
         if self.platform == "Windows":
             # MS-MPI style
-            env_args = [
-                "-env",
-                "PPC_NUM_THREADS",
-                self.__ppc_env["PPC_NUM_THREADS"],
-                "-env",
-                "OMP_NUM_THREADS",
-                self.__ppc_env["OMP_NUM_THREADS"],
-            ]
+            env_args = []
+            for name in self.__forwarded_env_vars():
+                env_args += ["-env", name, self.__ppc_env[name]]
             np_args = ["-n", ppc_num_proc]
             return base + env_args + np_args
 
         # Non-Windows
         if self.mpi_env_mode == "openmpi":
-            env_args = [
-                "-x",
-                "PPC_NUM_THREADS",
-                "-x",
-                "OMP_NUM_THREADS",
-            ]
+            env_args = []
+            for name in self.__forwarded_env_vars():
+                env_args += ["-x", name]
             np_flag = "-np"
         elif self.mpi_env_mode == "mpich":
             # Explicitly set env variables for all ranks
-            env_args = [
-                "-env",
-                "PPC_NUM_THREADS",
-                self.__ppc_env["PPC_NUM_THREADS"],
-                "-env",
-                "OMP_NUM_THREADS",
-                self.__ppc_env["OMP_NUM_THREADS"],
-            ]
+            env_args = []
+            for name in self.__forwarded_env_vars():
+                env_args += ["-env", name, self.__ppc_env[name]]
             np_flag = "-n"
         else:
             # Unknown MPI flavor: rely on environment inheritance and default to -np
@@ -221,6 +261,11 @@ class PPCRunner:
             )
         mpi_running = self.__build_mpi_cmd(ppc_num_proc, additional_mpi_args)
         if not self.__ppc_env.get("PPC_ASAN_RUN"):
+            self.__run_exec(
+                mpi_running
+                + [str(self.work_dir / "core_mpi_tests")]
+                + self.__get_gtest_settings(1, "*")
+            )
             for task_type in ["all", "mpi"]:
                 self.__run_exec(
                     mpi_running
@@ -245,8 +290,66 @@ class PPCRunner:
                 + self.__get_gtest_settings(1, "_" + task_type + "_")
             )
 
+    def run_scaling(
+        self, scaling_mode, proc_counts, thread_counts, problem_scales, results_file
+    ):
+        """Run perf tests over worker counts and problem scales, collecting records in results_file.
+
+        For weak scaling the problem scale is multiplied by the number of workers of each run.
+        """
+        base_env = self.__ppc_env
+        results_file = Path(results_file).resolve()
+        results_file.parent.mkdir(parents=True, exist_ok=True)
+        results_file.unlink(missing_ok=True)
+
+        def configure(num_proc, num_threads, scale):
+            workers = max(num_proc, num_threads)
+            env = dict(base_env)
+            env["PPC_NUM_PROC"] = str(num_proc)
+            env["PPC_NUM_THREADS"] = str(num_threads)
+            env["OMP_NUM_THREADS"] = str(num_threads)
+            env["PPC_PERF_PROBLEM_SCALE"] = str(
+                scale * workers if scaling_mode == "weak" else scale
+            )
+            env["PPC_PERF_RESULTS_FILE"] = str(results_file)
+            self.__ppc_env = env
+
+        try:
+            for scale in problem_scales:
+                # Sequential baseline for speedups of every technology
+                configure(1, 1, scale)
+                self.__run_exec(
+                    [str(self.work_dir / "ppc_perf_tests")]
+                    + self.__get_gtest_settings(1, "_seq_")
+                )
+                for num_proc in proc_counts:
+                    configure(num_proc, 1, scale)
+                    mpi_running = self.__build_mpi_cmd(str(num_proc), "")
+                    for task_type in ["all", "mpi"]:
+                        self.__run_exec(
+                            mpi_running
+                            + [str(self.work_dir / "ppc_perf_tests")]
+                            + self.__get_gtest_settings(1, "_" + task_type + "_")
+                        )
+                for num_threads in thread_counts:
+                    configure(1, num_threads, scale)
+                    for task_type in ["omp", "stl", "tbb"]:
+                        self.__run_exec(
+                            [str(self.work_dir / "ppc_perf_tests")]
+                            + self.__get_gtest_settings(1, "_" + task_type + "_")
+                        )
+        finally:
+            self.__ppc_env = base_env
+
 
 def _execute(args_dict, env):
+    if args_dict.get("baseline_dir"):
+        env["PPC_PERF_BASELINE_DIR"] = str(Path(args_dict["baseline_dir"]).resolve())
+        if args_dict.get("update_baseline"):
+            env["PPC_PERF_BASELINE_UPDATE"] = "1"
+    if args_dict.get("regression_threshold") is not None:
+        env["PPC_PERF_REGRESSION_THRESHOLD"] = str(args_dict["regression_threshold"])
+
     runner = PPCRunner(verbose=args_dict.get("verbose", False))
     runner.setup_env(env)
 
@@ -259,6 +362,20 @@ def _execute(args_dict, env):
         runner.run_processes(args_dict["additional_mpi_args"])
     elif args_dict["running_type"] == "performance":
         runner.run_performance()
+    elif args_dict["running_type"] == "scaling":
+        results_file = args_dict["results_file"] or str(
+            Path(__file__).resolve().parent.parent
+            / "build"
+            / "perf_stat_dir"
+            / "scaling_results.jsonl"
+        )
+        runner.run_scaling(
+            args_dict["scaling_mode"],
+            args_dict["procs"],
+            args_dict["threads"],
+            args_dict["problem_scales"],
+            results_file,
+        )
     else:
         raise Exception("running-type is wrong!")
 
@@ -267,7 +384,12 @@ if __name__ == "__main__":
     args_dict = init_cmd_args()
     counts = args_dict.get("counts")
 
-    if counts:
+    if args_dict["running_type"] == "scaling":
+        env_copy = os.environ.copy()
+        env_copy.setdefault("PPC_NUM_THREADS", "1")
+        env_copy.setdefault("PPC_NUM_PROC", "1")
+        _execute(args_dict, env_copy)
+    elif counts:
         for count in counts:
             env_copy = os.environ.copy()
 
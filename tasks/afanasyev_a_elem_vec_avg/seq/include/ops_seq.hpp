@@ -10,7 +10,7 @@ class AfanasyevAElemVecAvgSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit AfanasyevAElemVecAvgSEQ(const InType &in);
+  explicit AfanasyevAElemVecAvgSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
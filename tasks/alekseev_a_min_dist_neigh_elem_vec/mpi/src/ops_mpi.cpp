@@ -2,18 +2,23 @@
 
 #include <mpi.h>
 
+#include <cstddef>
 #include <cstdlib>
 #include <limits>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "alekseev_a_min_dist_neigh_elem_vec/common/include/common.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/halo.hpp"
 
 namespace alekseev_a_min_dist_neigh_elem_vec {
 
-AlekseevAMinDistNeighElemVecMPI::AlekseevAMinDistNeighElemVecMPI(const InType &in) {
+AlekseevAMinDistNeighElemVecMPI::AlekseevAMinDistNeighElemVecMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(-1, -1);
 }
 
@@ -26,51 +31,17 @@ bool AlekseevAMinDistNeighElemVecMPI::PreProcessingImpl() {
 }
 
 namespace {
-std::vector<int> CalculateSendCountsAndDisplacements(int total_size, int comm_size, std::vector<int> &displacements) {
-  int base_chunk = total_size / comm_size;
-  int remainder = total_size % comm_size;
-
-  std::vector<int> send_counts(comm_size);
-  displacements.resize(comm_size);
-  int displacement = 0;
-  for (int i = 0; i < comm_size; i++) {
-    send_counts[i] = base_chunk + (i < remainder ? 1 : 0);
-    displacements[i] = displacement;
-    displacement += send_counts[i];
-  }
-  return send_counts;
-}
-
-std::vector<int> CalculatePrevElements(int rank, int comm_size, const std::vector<int> &vec,
-                                       const std::vector<int> &displacements) {
-  std::vector<int> prev_elements(comm_size, 0);
-  if (rank == 0) {
-    for (int i = 1; i < comm_size; i++) {
-      int prev_block_end = displacements[i] - 1;
-      prev_elements[i] = vec[prev_block_end];
-    }
-  }
-  return prev_elements;
-}
-
-std::tuple<int, int> FindLocalMinDistance(const std::vector<int> &local_data, int my_chunk_size, int rank,
-                                          int my_prev_element, const std::vector<int> &displacements) {
+/// Pairs (i - 1, i) inside the block, identified by the global index i of their right element.
+std::tuple<int, int> FindLocalMinDistance(std::span<const int> local_data, int my_offset) {
   int local_min_dist = std::numeric_limits<int>::max();
   int local_min_index = -1;
 
-  if (rank > 0 && my_chunk_size > 0) {
-    int dist = std::abs(my_prev_element - local_data[0]);
-    if (dist < local_min_dist) {
-      local_min_dist = dist;
-      local_min_index = displacements[rank];
-    }
-  }
-
+  const int my_chunk_size = static_cast<int>(local_data.size());
   for (int i = 0; i < my_chunk_size - 1; i++) {
     int dist = std::abs(local_data[i] - local_data[i + 1]);
     if (dist < local_min_dist) {
       local_min_dist = dist;
-      local_min_index = displacements[rank] + i + 1;
+      local_min_index = my_offset + i + 1;
     }
   }
 
@@ -92,22 +63,28 @@ bool AlekseevAMinDistNeighElemVecMPI::RunImpl() {
     return true;
   }
 
-  std::vector<int> displacements;
-  std::vector<int> send_counts = CalculateSendCountsAndDisplacements(total_size, comm_size, displacements);
-
-  int my_chunk_size = send_counts[rank];
-  std::vector<int> local_data(my_chunk_size);
+  const ppc::util::BlockDistribution distribution(vec.size(), comm_size);
+  const std::size_t my_chunk_size = distribution.Count(rank);
+  const int my_offset = static_cast<int>(distribution.Offset(rank));
 
-  MPI_Scatterv(vec.data(), send_counts.data(), displacements.data(), MPI_INT, local_data.data(), my_chunk_size, MPI_INT,
-               0, MPI_COMM_WORLD);
+  // One ghost, the last element of the previous block, followed by the own elements
+  std::vector<int> local_data(ppc::util::HaloExchange::PaddedSize(distribution, rank, {.before = 1}));
+  const std::span<int> own = std::span(local_data).subspan(1, my_chunk_size);
+  ppc::util::Scatter(distribution, vec, own);
 
-  std::vector<int> prev_elements = CalculatePrevElements(rank, comm_size, vec, displacements);
+  ppc::util::HaloExchange halo(distribution, {.before = 1}, local_data);
+  halo.Start();
+  auto [local_min_dist, local_min_index] = FindLocalMinDistance(own, my_offset);
+  halo.Finish();
 
-  int my_prev_element = 0;
-  MPI_Scatter(prev_elements.data(), 1, MPI_INT, &my_prev_element, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  auto [local_min_dist, local_min_index] =
-      FindLocalMinDistance(local_data, my_chunk_size, rank, my_prev_element, displacements);
+  // The pair crossing the block boundary has the smallest index of the block, so it also wins ties
+  if (halo.HasNeighbour(ppc::util::HaloSide::kBefore)) {
+    int dist = std::abs(local_data[0] - own[0]);
+    if (dist <= local_min_dist) {
+      local_min_dist = dist;
+      local_min_index = my_offset;
+    }
+  }
 
   int global_min_dist = std::numeric_limits<int>::max();
   MPI_Allreduce(&local_min_dist, &global_min_dist, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
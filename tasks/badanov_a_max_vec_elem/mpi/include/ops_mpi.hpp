@@ -10,7 +10,7 @@ class BadanovAMaxVecElemMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BadanovAMaxVecElemMPI(const InType &in);
+  explicit BadanovAMaxVecElemMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -4,19 +4,20 @@
 
 #include <algorithm>
 #include <climits>
+#include <utility>
 #include <vector>
 
 #include "badanov_a_max_vec_elem/common/include/common.hpp"
 
 namespace badanov_a_max_vec_elem {
 
-BadanovAMaxVecElemMPI::BadanovAMaxVecElemMPI(const InType &in) {
+BadanovAMaxVecElemMPI::BadanovAMaxVecElemMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   int rank = 0;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   if (rank == 0) {
-    GetInput() = in;
+    GetInput() = std::move(in);
   } else {
     GetInput() = InType();
   }
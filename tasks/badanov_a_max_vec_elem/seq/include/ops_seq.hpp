@@ -10,7 +10,7 @@ class BadanovAMaxVecElemSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit BadanovAMaxVecElemSEQ(const InType &in);
+  explicit BadanovAMaxVecElemSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -3,15 +3,16 @@
 #include <algorithm>
 #include <climits>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "badanov_a_max_vec_elem/common/include/common.hpp"
 
 namespace badanov_a_max_vec_elem {
 
-BadanovAMaxVecElemSEQ::BadanovAMaxVecElemSEQ(const InType &in) {
+BadanovAMaxVecElemSEQ::BadanovAMaxVecElemSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
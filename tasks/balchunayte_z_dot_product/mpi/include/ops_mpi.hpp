@@ -1,5 +1,6 @@
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "balchunayte_z_dot_product/common/include/common.hpp"
@@ -13,9 +14,9 @@ class BalchunayteZDotProductMPI : public BaseTask {
     return ppc::task::TypeOfTask::kMPI;
   }
 
-  explicit BalchunayteZDotProductMPI(const InType &in) {
+  explicit BalchunayteZDotProductMPI(InType in) {
     SetTypeOfTask(GetStaticTypeOfTask());
-    GetInput() = in;
+    GetInput() = std::move(in);
     GetOutput() = 0.0;
   }
 
@@ -11,7 +11,7 @@ class BalchunayteZDotProductSEQ : public BaseTask {
     return ppc::task::TypeOfTask::kSEQ;
   }
 
-  explicit BalchunayteZDotProductSEQ(const InType &in);
+  explicit BalchunayteZDotProductSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -14,11 +14,12 @@ class BaranovACustomAllreduceMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BaranovACustomAllreduceMPI(const InType &in);
+  explicit BaranovACustomAllreduceMPI(InType in);
 
-  static void CustomAllreduce(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
-                              int root = 0);
-  static void PerformOperation(void *inbuf, void *inoutbuf, int count, MPI_Datatype datatype, MPI_Op op);
+  /// @brief Allreduce over point-to-point messages; the tree or ring algorithm is chosen by message and
+  /// communicator size (see util/include/collectives.hpp).
+  static void CustomAllreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                              MPI_Comm comm);
 
  private:
   bool ValidationImpl() override;
@@ -26,10 +27,6 @@ class BaranovACustomAllreduceMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  static void TreeReduce(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
-                         int root);
-  static void TreeBroadcast(void *buffer, int count, MPI_Datatype datatype, MPI_Comm comm, int root);
-
   template <typename T>
   static std::vector<T> GetVectorFromVariant(const InTypeVariant &variant);
 };
@@ -10,7 +10,7 @@ class BaranovACustomAllreduceSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit BaranovACustomAllreduceSEQ(const InType &in);
+  explicit BaranovACustomAllreduceSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -1,19 +1,105 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <algorithm>
 #include <cmath>
 #include <exception>
+#include <optional>
 #include <random>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include "baranov_a_custom_allreduce/common/include/common.hpp"
 #include "baranov_a_custom_allreduce/mpi/include/ops_mpi.hpp"
 #include "baranov_a_custom_allreduce/seq/include/ops_seq.hpp"
+#include "task/include/task.hpp"
+#include "util/include/collectives.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace baranov_a_custom_allreduce {
 
+/// @brief Sums the input over all processes with one fixed allreduce, so that every algorithm of the library and
+/// the vendor MPI_Allreduce get their own perf case on the same input.
+class AllreduceBenchmarkTask : public BaseTask {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+ protected:
+  /// @param algorithm Algorithm of ppc::util::Allreduce(); std::nullopt runs the vendor MPI_Allreduce.
+  AllreduceBenchmarkTask(InType in, std::optional<ppc::util::AllreduceAlgorithm> algorithm) : algorithm_(algorithm) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = std::move(in);
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return std::holds_alternative<std::vector<double>>(GetInput());
+  }
+
+  bool PreProcessingImpl() override {
+    GetOutput() = std::vector<double>(std::get<std::vector<double>>(GetInput()).size());
+    return true;
+  }
+
+  bool RunImpl() override {
+    const auto &data = std::get<std::vector<double>>(GetInput());
+    auto &result = std::get<std::vector<double>>(GetOutput());
+    const auto count = static_cast<int>(data.size());
+    if (algorithm_.has_value()) {
+      ppc::util::Allreduce(data.data(), result.data(), count, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, *algorithm_);
+    } else {
+      MPI_Allreduce(data.data(), result.data(), count, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+
+  std::optional<ppc::util::AllreduceAlgorithm> algorithm_;
+};
+
+// The perf case names come from the namespace of the task type, so the variants are plain classes rather than
+// instances of a template
+class AutoAllreduceTask : public AllreduceBenchmarkTask {
+ public:
+  explicit AutoAllreduceTask(InType in) : AllreduceBenchmarkTask(std::move(in), ppc::util::AllreduceAlgorithm::kAuto) {}
+};
+
+class RecursiveDoublingAllreduceTask : public AllreduceBenchmarkTask {
+ public:
+  explicit RecursiveDoublingAllreduceTask(InType in)
+      : AllreduceBenchmarkTask(std::move(in), ppc::util::AllreduceAlgorithm::kRecursiveDoubling) {}
+};
+
+class RabenseifnerAllreduceTask : public AllreduceBenchmarkTask {
+ public:
+  explicit RabenseifnerAllreduceTask(InType in)
+      : AllreduceBenchmarkTask(std::move(in), ppc::util::AllreduceAlgorithm::kRabenseifner) {}
+};
+
+class RingAllreduceTask : public AllreduceBenchmarkTask {
+ public:
+  explicit RingAllreduceTask(InType in) : AllreduceBenchmarkTask(std::move(in), ppc::util::AllreduceAlgorithm::kRing) {}
+};
+
+class HierarchicalAllreduceTask : public AllreduceBenchmarkTask {
+ public:
+  explicit HierarchicalAllreduceTask(InType in)
+      : AllreduceBenchmarkTask(std::move(in), ppc::util::AllreduceAlgorithm::kHierarchical) {}
+};
+
+class VendorAllreduceTask : public AllreduceBenchmarkTask {
+ public:
+  explicit VendorAllreduceTask(InType in) : AllreduceBenchmarkTask(std::move(in), std::nullopt) {}
+};
+
 class BaranovACustomAllreducePerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
  protected:
   void SetUp() override {
@@ -63,8 +149,25 @@ TEST_P(BaranovACustomAllreducePerfTests, RunPerfModes) {
   ExecuteTest(GetParam());
 }
 
-const auto kAllPerfTasks = ppc::util::MakeAllPerfTasks<InType, BaranovACustomAllreduceMPI, BaranovACustomAllreduceSEQ>(
-    PPC_SETTINGS_baranov_a_custom_allreduce);
+std::string AlgorithmSuffix(ppc::util::AllreduceAlgorithm algorithm) {
+  return "_" + std::string(ppc::util::GetAlgorithmName(algorithm));
+}
+
+const auto kAllPerfTasks = std::tuple_cat(
+    ppc::util::MakeAllPerfTasks<InType, BaranovACustomAllreduceMPI, BaranovACustomAllreduceSEQ>(
+        PPC_SETTINGS_baranov_a_custom_allreduce),
+    ppc::util::MakePerfTaskTuples<AutoAllreduceTask, InType>(PPC_SETTINGS_baranov_a_custom_allreduce,
+                                                             AlgorithmSuffix(ppc::util::AllreduceAlgorithm::kAuto)),
+    ppc::util::MakePerfTaskTuples<RecursiveDoublingAllreduceTask, InType>(
+        PPC_SETTINGS_baranov_a_custom_allreduce, AlgorithmSuffix(ppc::util::AllreduceAlgorithm::kRecursiveDoubling)),
+    ppc::util::MakePerfTaskTuples<RabenseifnerAllreduceTask, InType>(
+        PPC_SETTINGS_baranov_a_custom_allreduce, AlgorithmSuffix(ppc::util::AllreduceAlgorithm::kRabenseifner)),
+    ppc::util::MakePerfTaskTuples<RingAllreduceTask, InType>(PPC_SETTINGS_baranov_a_custom_allreduce,
+                                                             AlgorithmSuffix(ppc::util::AllreduceAlgorithm::kRing)),
+    ppc::util::MakePerfTaskTuples<HierarchicalAllreduceTask, InType>(
+        PPC_SETTINGS_baranov_a_custom_allreduce, AlgorithmSuffix(ppc::util::AllreduceAlgorithm::kHierarchical)),
+    ppc::util::MakePerfTaskTuples<VendorAllreduceTask, InType>(PPC_SETTINGS_baranov_a_custom_allreduce,
+                                                               "_vendor"));
 
 const auto kGtestValues = ppc::util::TupleToGTestValues(kAllPerfTasks);
 
@@ -10,7 +10,7 @@ class BaranovASignAlternationsMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BaranovASignAlternationsMPI(const InType &in);
+  explicit BaranovASignAlternationsMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -2,6 +2,7 @@
 
 #include <mpi.h>
 
+#include <utility>
 #include <vector>
 
 #include "baranov_a_sign_alternations/common/include/common.hpp"
@@ -37,9 +38,9 @@ void CalculateChunkBounds(int world_rank, int world_size, int pairs_count, int &
 }
 }  // namespace
 
-BaranovASignAlternationsMPI::BaranovASignAlternationsMPI(const InType &in) {
+BaranovASignAlternationsMPI::BaranovASignAlternationsMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
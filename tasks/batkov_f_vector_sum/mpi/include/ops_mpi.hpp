@@ -12,7 +12,7 @@ class BatkovFVectorSumMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BatkovFVectorSumMPI(const InType &in);
+  explicit BatkovFVectorSumMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -1,12 +1,14 @@
 #include "batkov_f_vector_sum/seq/include/ops_seq.hpp"
 
+#include <utility>
+
 #include "batkov_f_vector_sum/common/include/common.hpp"
 
 namespace batkov_f_vector_sum {
 
-BatkovFVectorSumSEQ::BatkovFVectorSumSEQ(const InType &in) {
+BatkovFVectorSumSEQ::BatkovFVectorSumSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
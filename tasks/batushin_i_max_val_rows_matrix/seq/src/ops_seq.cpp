@@ -2,15 +2,16 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "batushin_i_max_val_rows_matrix/common/include/common.hpp"
 
 namespace batushin_i_max_val_rows_matrix {
 
-BatushinIMaxValRowsMatrixSEQ::BatushinIMaxValRowsMatrixSEQ(const InType &in) {
+BatushinIMaxValRowsMatrixSEQ::BatushinIMaxValRowsMatrixSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool BatushinIMaxValRowsMatrixSEQ::ValidationImpl() {
@@ -20,7 +20,7 @@ class BelovELexicoOrderTwoStringsMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BelovELexicoOrderTwoStringsMPI(const InType &in);
+  explicit BelovELexicoOrderTwoStringsMPI(InType in);
 
  private:
   std::tuple<std::vector<std::string>, std::vector<std::string>> proccesed_input_;
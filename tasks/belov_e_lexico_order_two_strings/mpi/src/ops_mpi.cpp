@@ -5,14 +5,15 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "belov_e_lexico_order_two_strings/common/include/common.hpp"
 
 namespace belov_e_lexico_order_two_strings {
-BelovELexicoOrderTwoStringsMPI::BelovELexicoOrderTwoStringsMPI(const InType &in) {
+BelovELexicoOrderTwoStringsMPI::BelovELexicoOrderTwoStringsMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = false;
 }
 
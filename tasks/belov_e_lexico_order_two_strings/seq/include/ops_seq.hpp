@@ -13,7 +13,7 @@ class BelovELexicoOrderTwoStringsSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit BelovELexicoOrderTwoStringsSEQ(const InType &in);
+  explicit BelovELexicoOrderTwoStringsSEQ(InType in);
 
  private:
   std::tuple<std::vector<std::string>, std::vector<std::string>> proccesed_input_;
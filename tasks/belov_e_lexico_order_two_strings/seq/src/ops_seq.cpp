@@ -1,15 +1,16 @@
 #include "belov_e_lexico_order_two_strings/seq/include/ops_seq.hpp"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "belov_e_lexico_order_two_strings/common/include/common.hpp"
 
 namespace belov_e_lexico_order_two_strings {
 
-BelovELexicoOrderTwoStringsSEQ::BelovELexicoOrderTwoStringsSEQ(const InType &in) {
+BelovELexicoOrderTwoStringsSEQ::BelovELexicoOrderTwoStringsSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = false;
 }
 
@@ -10,7 +10,7 @@ class BortsovaAMaxElemVectorSeq : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit BortsovaAMaxElemVectorSeq(const InType &in);
+  explicit BortsovaAMaxElemVectorSeq(InType in);
 
  private:
   bool ValidationImpl() override;
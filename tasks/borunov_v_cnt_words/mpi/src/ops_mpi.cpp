@@ -3,17 +3,20 @@
 #include <mpi.h>
 
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "borunov_v_cnt_words/common/include/common.hpp"
+#include "util/include/distribution.hpp"
 
 namespace borunov_v_cnt_words {
 
-BorunovVCntWordsMPI::BorunovVCntWordsMPI(const InType &in) {
+BorunovVCntWordsMPI::BorunovVCntWordsMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -25,26 +28,6 @@ bool BorunovVCntWordsMPI::PreProcessingImpl() {
   return true;
 }
 
-void BorunovVCntWordsMPI::CalculateDistribution(int text_len, int world_size, std::vector<int> &counts,
-                                                std::vector<int> &displs) {
-  counts.resize(world_size);
-  displs.resize(world_size);
-
-  if (world_size == 0) {
-    return;
-  }
-
-  int base_count = text_len / world_size;
-  int remainder = text_len % world_size;
-  int current_displ = 0;
-
-  for (int i = 0; i < world_size; ++i) {
-    counts[i] = base_count + (i < remainder ? 1 : 0);
-    displs[i] = current_displ;
-    current_displ += counts[i];
-  }
-}
-
 uint64_t BorunovVCntWordsMPI::CountWordsLocal(const char *data, int count, char prev_char) {
   if (count == 0) {
     return 0;
@@ -96,17 +79,10 @@ bool BorunovVCntWordsMPI::RunImpl() {
     return true;
   }
 
-  std::vector<int> send_counts;
-  std::vector<int> displs;
-  CalculateDistribution(text_len, world_size, send_counts, displs);
-
-  int local_count = send_counts[rank];
-  std::vector<char> local_data(local_count);
-
-  const char *send_buf = (rank == 0) ? GetInput().data() : nullptr;
-
-  MPI_Scatterv(send_buf, send_counts.data(), displs.data(), MPI_CHAR, local_data.data(), local_count, MPI_CHAR, 0,
-               MPI_COMM_WORLD);
+  const ppc::util::BlockDistribution blocks(static_cast<std::size_t>(text_len), world_size);
+  const int local_count = static_cast<int>(blocks.Count(rank));
+  std::vector<char> local_data(blocks.Count(rank));
+  ppc::util::Scatter(blocks, GetInput(), local_data);
 
   int left_neighbor = (rank == 0) ? MPI_PROC_NULL : rank - 1;
   int right_neighbor = (rank == world_size - 1) ? MPI_PROC_NULL : rank + 1;
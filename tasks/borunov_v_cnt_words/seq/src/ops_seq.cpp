@@ -1,4 +1,6 @@
 #include <cctype>  // Для std::isspace
+
+#include <utility>
 #include <string>  // Включаем, чтобы гарантировать, что std::string доступен
 
 // ИСПРАВЛЕНИЕ ОШИБКИ C1083: Используем полный путь к заголовочному файлу
@@ -7,9 +9,9 @@
 
 namespace borunov_v_cnt_words {
 
-BorunovVCntWordsSEQ::BorunovVCntWordsSEQ(const InType &in) {
+BorunovVCntWordsSEQ::BorunovVCntWordsSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -12,7 +12,7 @@ class DergachevAMultistep2dParallelMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit DergachevAMultistep2dParallelMPI(const InType &in);
+  explicit DergachevAMultistep2dParallelMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -89,9 +89,9 @@ void GatherResultsToRoot(const std::vector<double> &local_chars, const std::vect
 
 }  // namespace
 
-DergachevAMultistep2dParallelMPI::DergachevAMultistep2dParallelMPI(const InType &in) {
+DergachevAMultistep2dParallelMPI::DergachevAMultistep2dParallelMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = OutType();
 
   MPI_Comm_rank(MPI_COMM_WORLD, &world_rank_);
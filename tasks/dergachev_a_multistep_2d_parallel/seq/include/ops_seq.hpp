@@ -12,7 +12,7 @@ class DergachevAMultistep2dParallelSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit DergachevAMultistep2dParallelSEQ(const InType &in);
+  explicit DergachevAMultistep2dParallelSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -6,16 +6,16 @@
 #include <array>
 #include <cstddef>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "dilshodov_a_max_val_rows_matrix/common/include/common.hpp"
 
 namespace dilshodov_a_max_val_rows_matrix {
 
-MaxValRowsMatrixTaskMPI::MaxValRowsMatrixTaskMPI(const InType &in) {
+MaxValRowsMatrixTaskMPI::MaxValRowsMatrixTaskMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType copy = in;
-  GetInput().swap(copy);
+  GetInput() = std::move(in);
 }
 
 bool MaxValRowsMatrixTaskMPI::ValidationImpl() {
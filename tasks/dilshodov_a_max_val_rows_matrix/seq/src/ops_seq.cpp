@@ -3,15 +3,15 @@
 #include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <utility>
 
 #include "dilshodov_a_max_val_rows_matrix/common/include/common.hpp"
 
 namespace dilshodov_a_max_val_rows_matrix {
 
-MaxValRowsMatrixTaskSequential::MaxValRowsMatrixTaskSequential(const InType &in) {
+MaxValRowsMatrixTaskSequential::MaxValRowsMatrixTaskSequential(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType copy = in;
-  GetInput().swap(copy);
+  GetInput() = std::move(in);
 }
 
 bool MaxValRowsMatrixTaskSequential::ValidationImpl() {
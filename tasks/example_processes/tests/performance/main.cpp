@@ -4,6 +4,7 @@
 #include "example_processes/mpi/include/ops_mpi.hpp"
 #include "example_processes/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/util.hpp"
 
 namespace nesterov_a_test_task_processes {
 
@@ -12,7 +13,7 @@ class ExampleRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, O
   InType input_data_{};
 
   void SetUp() override {
-    input_data_ = kCount_;
+    input_data_ = ppc::util::ScalePerfSize(kCount_);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -12,9 +12,9 @@
 
 namespace gaivoronskiy_m_average_vector_sum {
 
-GaivoronskiyMAverageVecSumMPI::GaivoronskiyMAverageVecSumMPI(const InType &in) {
+GaivoronskiyMAverageVecSumMPI::GaivoronskiyMAverageVecSumMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0.0;
 }
 
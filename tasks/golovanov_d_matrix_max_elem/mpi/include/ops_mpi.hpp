@@ -10,7 +10,7 @@ class GolovanovDMatrixMaxElemMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit GolovanovDMatrixMaxElemMPI(const InType &in);
+  explicit GolovanovDMatrixMaxElemMPI(InType in);
 
  private:
   bool ValidationImpl() override;
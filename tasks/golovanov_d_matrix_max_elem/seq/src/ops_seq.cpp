@@ -1,15 +1,16 @@
 #include "golovanov_d_matrix_max_elem//seq/include/ops_seq.hpp"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "golovanov_d_matrix_max_elem//common/include/common.hpp"
 
 namespace golovanov_d_matrix_max_elem {
 
-GolovanovDMatrixMaxElemSEQ::GolovanovDMatrixMaxElemSEQ(const InType &in) {
+GolovanovDMatrixMaxElemSEQ::GolovanovDMatrixMaxElemSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -10,7 +10,7 @@ class IskhakovDTrapezoidalIntegrationMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit IskhakovDTrapezoidalIntegrationMPI(const InType &in);
+  explicit IskhakovDTrapezoidalIntegrationMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -10,7 +10,7 @@ class IskhakovDTrapezoidalIntegrationSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit IskhakovDTrapezoidalIntegrationSEQ(const InType &in);
+  explicit IskhakovDTrapezoidalIntegrationSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
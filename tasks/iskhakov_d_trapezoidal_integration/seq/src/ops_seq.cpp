@@ -1,14 +1,15 @@
 #include "iskhakov_d_trapezoidal_integration/seq/include/ops_seq.hpp"
 
 #include <cmath>
+#include <utility>
 
 #include "iskhakov_d_trapezoidal_integration/common/include/common.hpp"
 
 namespace iskhakov_d_trapezoidal_integration {
 
-IskhakovDTrapezoidalIntegrationSEQ::IskhakovDTrapezoidalIntegrationSEQ(const InType &in) {
+IskhakovDTrapezoidalIntegrationSEQ::IskhakovDTrapezoidalIntegrationSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -10,7 +10,7 @@ class IvanovaPMaxMatrixMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit IvanovaPMaxMatrixMPI(const InType &in);
+  explicit IvanovaPMaxMatrixMPI(InType in);
 
  private:
   bool ValidationImpl() override;
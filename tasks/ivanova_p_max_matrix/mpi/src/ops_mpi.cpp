@@ -5,13 +5,14 @@
 #include <algorithm>
 #include <cstring>  // memcpy
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "ivanova_p_max_matrix/common/include/common.hpp"
 
 namespace ivanova_p_max_matrix {
 
-IvanovaPMaxMatrixMPI::IvanovaPMaxMatrixMPI(const InType &in) {
+IvanovaPMaxMatrixMPI::IvanovaPMaxMatrixMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetOutput() = std::numeric_limits<int>::min();
 
@@ -19,7 +20,7 @@ IvanovaPMaxMatrixMPI::IvanovaPMaxMatrixMPI(const InType &in) {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   if (rank == 0) {
-    GetInput() = in;  // Только root хранит входную матрицу
+    GetInput() = std::move(in);  // Только root хранит входную матрицу
   } else {
     GetInput().clear();  // Остальные — пустая матрица
   }
@@ -3,19 +3,20 @@
 #include <algorithm>  // для std::max
 #include <cstddef>    // для size_t
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "ivanova_p_max_matrix/common/include/common.hpp"
 
 namespace ivanova_p_max_matrix {
 
-IvanovaPMaxMatrixSEQ::IvanovaPMaxMatrixSEQ(const InType &in) {
+IvanovaPMaxMatrixSEQ::IvanovaPMaxMatrixSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
 
   // Безопасная инициализация
   GetInput().clear();
   if (!in.empty()) {
-    GetInput() = in;
+    GetInput() = std::move(in);
   }
 
   GetOutput() = std::numeric_limits<int>::min();
@@ -4,14 +4,15 @@
 
 #include <algorithm>
 #include <climits>
+#include <utility>
 
 #include "klimenko_v_max_matrix_elems_val/common/include/common.hpp"
 
 namespace klimenko_v_max_matrix_elems_val {
 
-KlimenkoVMaxMatrixElemsValMPI::KlimenkoVMaxMatrixElemsValMPI(const InType &in) {
+KlimenkoVMaxMatrixElemsValMPI::KlimenkoVMaxMatrixElemsValMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in);
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -10,7 +10,7 @@ class KlimenkoVMaxMatrixElemsValSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit KlimenkoVMaxMatrixElemsValSEQ(const InType &in);
+  explicit KlimenkoVMaxMatrixElemsValSEQ(InType in);
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
   bool RunImpl() override;
@@ -9,9 +9,17 @@
 #include <vector>
 
 #include "klimenko_v_seidel_method/common/include/common.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/iteration.hpp"
+#include "util/include/util.hpp"
 
 namespace klimenko_v_seidel_method {
 
+namespace {
+// Shorter loops are cheaper than waking up the OpenMP team
+constexpr int kMinParallelRowLength = 4096;
+}  // namespace
+
 KlimenkoVSeidelMethodMPI::KlimenkoVSeidelMethodMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
@@ -51,14 +59,11 @@ bool KlimenkoVSeidelMethodMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  std::vector<int> row_counts(size);
-  std::vector<int> row_displs(size);
-  std::vector<int> matrix_counts(size);
-  std::vector<int> matrix_displs(size);
-  ComputeRowDistribution(n, size, row_counts, row_displs, matrix_counts, matrix_displs);
-
-  int local_rows = row_counts[rank];
-  int start_row = row_displs[rank];
+  const ppc::util::BlockDistribution rows(static_cast<std::size_t>(n), size);
+  const ppc::util::MatrixDistribution stripes(static_cast<std::size_t>(n), static_cast<std::size_t>(n), size,
+                                              ppc::util::MatrixLayout::kRows);
+  int local_rows = static_cast<int>(rows.Count(rank));
+  int start_row = static_cast<int>(rows.Offset(rank));
 
   std::vector<double> flat_matrix;
   std::vector<double> b;
@@ -66,33 +71,27 @@ bool KlimenkoVSeidelMethodMPI::RunImpl() {
     InitializeMatrixAndVector(flat_matrix, b, n);
   }
 
-  std::vector<double> local_matrix(static_cast<size_t>(local_rows) * n, 0.0);
-  MPI_Scatterv(flat_matrix.data(), matrix_counts.data(), matrix_displs.data(), MPI_DOUBLE, local_matrix.data(),
-               local_rows * n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  std::vector<double> local_matrix(stripes.LocalSize(rank), 0.0);
+  ppc::util::Scatter(stripes, flat_matrix, local_matrix);
 
-  std::vector<double> local_b(local_rows, 0.0);
-  MPI_Scatterv(b.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE, local_b.data(), local_rows, MPI_DOUBLE, 0,
-               MPI_COMM_WORLD);
+  std::vector<double> local_b(rows.Count(rank), 0.0);
+  ppc::util::Scatter(rows, b, local_b);
 
   std::vector<double> x(n, 0.0);
+  std::vector<double> x_old(n, 0.0);
   const double epsilon = 1e-6;
   const int max_iterations = 1000;
 
+  // Set up once: every iteration restarts the exchange of the own rows of x together with the residual reduction
+  ppc::util::IterationExchange exchange(rows, x);
+
   for (int iteration = 0; iteration < max_iterations; iteration++) {
-    std::vector<double> x_old = x;
+    x_old = x;
 
     PerformSeidelIteration(local_rows, start_row, n, local_matrix, local_b, x);
 
-    std::vector<double> local_x_updated(local_rows);
-    UpdateLocalXVector(local_rows, start_row, x, local_x_updated);
-
-    MPI_Allgatherv(local_x_updated.data(), local_rows, MPI_DOUBLE, x.data(), row_counts.data(), row_displs.data(),
-                   MPI_DOUBLE, MPI_COMM_WORLD);
-
     double local_diff = ComputeLocalDifference(local_rows, start_row, x, x_old);
-    double global_diff = 0.0;
-    MPI_Allreduce(&local_diff, &global_diff, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    global_diff = std::sqrt(global_diff);
+    double global_diff = std::sqrt(exchange.Exchange(local_diff));
 
     if (global_diff < epsilon) {
       break;
@@ -111,26 +110,6 @@ bool KlimenkoVSeidelMethodMPI::PostProcessingImpl() {
   return GetOutput() > 0;
 }
 
-void KlimenkoVSeidelMethodMPI::ComputeRowDistribution(int n, int size, std::vector<int> &row_counts,
-                                                      std::vector<int> &row_displs, std::vector<int> &matrix_counts,
-                                                      std::vector<int> &matrix_displs) {
-  int row_offset = 0;
-  int matrix_offset = 0;
-  for (int proc = 0; proc < size; proc++) {
-    int base_rows = n / size;
-    int extra = (proc < (n % size)) ? 1 : 0;
-    int proc_rows = base_rows + extra;
-
-    row_counts[proc] = proc_rows;
-    row_displs[proc] = row_offset;
-    matrix_counts[proc] = proc_rows * n;
-    matrix_displs[proc] = matrix_offset;
-
-    row_offset += proc_rows;
-    matrix_offset += proc_rows * n;
-  }
-}
-
 int KlimenkoVSeidelMethodMPI::ComputeFinalResult(const std::vector<double> &x, int n) {
   double sum = 0.0;
   for (int i = 0; i < n; i++) {
@@ -185,6 +164,9 @@ void KlimenkoVSeidelMethodMPI::PerformSeidelIteration(int local_rows, int start_
     int global_i = start_row + i;
     double sum_off_diag = 0.0;
 
+    // Rows depend on each other in a Seidel sweep, so only the dot product of a long row is split between threads
+#pragma omp parallel for default(none) shared(local_matrix, x, n, i, global_i) reduction(+ : sum_off_diag) \
+    num_threads(ppc::util::GetNumThreads()) if (n >= kMinParallelRowLength)
     for (int j = 0; j < n; j++) {
       if (j != global_i) {
         sum_off_diag += local_matrix[(static_cast<size_t>(i) * n) + j] * x[j];
@@ -195,16 +177,11 @@ void KlimenkoVSeidelMethodMPI::PerformSeidelIteration(int local_rows, int start_
   }
 }
 
-void KlimenkoVSeidelMethodMPI::UpdateLocalXVector(int local_rows, int start_row, const std::vector<double> &x,
-                                                  std::vector<double> &local_x_updated) {
-  for (int i = 0; i < local_rows; ++i) {
-    local_x_updated[i] = x[start_row + i];
-  }
-}
-
 double KlimenkoVSeidelMethodMPI::ComputeLocalDifference(int local_rows, int start_row, const std::vector<double> &x,
                                                         const std::vector<double> &x_old) {
   double local_diff = 0.0;
+#pragma omp parallel for default(none) shared(local_rows, start_row, x, x_old) reduction(+ : local_diff) \
+    num_threads(ppc::util::GetNumThreads()) if (local_rows >= kMinParallelRowLength)
   for (int i = 0; i < local_rows; i++) {
     int gi = start_row + i;
     double d = x[gi] - x_old[gi];
@@ -10,7 +10,7 @@ class KondrashovaVSumColMatSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit KondrashovaVSumColMatSEQ(const InType &in);
+  explicit KondrashovaVSumColMatSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -10,9 +10,9 @@
 
 namespace kopilov_d_sum_val_col_mat {
 
-KopilovDSumValColMatMPI::KopilovDSumValColMatMPI(const InType &in) {
+KopilovDSumValColMatMPI::KopilovDSumValColMatMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = OutType{};
 }
 
@@ -10,7 +10,7 @@ class KorolevKRingTopologySEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit KorolevKRingTopologySEQ(const InType &in);
+  explicit KorolevKRingTopologySEQ(InType in);
 
  private:
   bool ValidationImpl() override;
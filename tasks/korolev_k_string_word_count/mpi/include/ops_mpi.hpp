@@ -10,7 +10,7 @@ class KorolevKStringWordCountMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit KorolevKStringWordCountMPI(const InType &in);
+  explicit KorolevKStringWordCountMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <utility>
 
 #include "korolev_k_string_word_count/common/include/common.hpp"
 
@@ -45,9 +46,9 @@ int CountWordsChunk(const std::string &s, std::size_t begin, std::size_t end, bo
 
 }  // namespace
 
-KorolevKStringWordCountMPI::KorolevKStringWordCountMPI(const InType &in) {
+KorolevKStringWordCountMPI::KorolevKStringWordCountMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
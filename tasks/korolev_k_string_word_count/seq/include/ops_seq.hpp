@@ -10,7 +10,7 @@ class KorolevKStringWordCountSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit KorolevKStringWordCountSEQ(const InType &in);
+  explicit KorolevKStringWordCountSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -12,7 +12,7 @@ class KotelnikovaANumSentInLineMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit KotelnikovaANumSentInLineMPI(const InType &in);
+  explicit KotelnikovaANumSentInLineMPI(InType in);
 
  private:
   bool ValidationImpl() override;
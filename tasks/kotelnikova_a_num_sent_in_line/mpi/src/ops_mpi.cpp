@@ -6,14 +6,15 @@
 #include <cctype>
 #include <cstddef>
 #include <string>
+#include <utility>
 
 #include "kotelnikova_a_num_sent_in_line/common/include/common.hpp"
 
 namespace kotelnikova_a_num_sent_in_line {
 
-KotelnikovaANumSentInLineMPI::KotelnikovaANumSentInLineMPI(const InType &in) {
+KotelnikovaANumSentInLineMPI::KotelnikovaANumSentInLineMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = static_cast<std::size_t>(0);
 }
 
@@ -10,7 +10,7 @@ class KotelnikovaANumSentInLineSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit KotelnikovaANumSentInLineSEQ(const InType &in);
+  explicit KotelnikovaANumSentInLineSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
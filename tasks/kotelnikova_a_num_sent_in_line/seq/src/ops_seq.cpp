@@ -3,14 +3,15 @@
 #include <cctype>
 #include <cstddef>
 #include <string>
+#include <utility>
 
 #include "kotelnikova_a_num_sent_in_line/common/include/common.hpp"
 
 namespace kotelnikova_a_num_sent_in_line {
 
-KotelnikovaANumSentInLineSEQ::KotelnikovaANumSentInLineSEQ(const InType &in) {
+KotelnikovaANumSentInLineSEQ::KotelnikovaANumSentInLineSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -10,7 +10,7 @@ class LazarevaAMaxValMatrixMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit LazarevaAMaxValMatrixMPI(const InType &in);
+  explicit LazarevaAMaxValMatrixMPI(InType in);
 
  private:
   int n_ = 0;
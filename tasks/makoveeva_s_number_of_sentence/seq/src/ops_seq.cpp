@@ -1,14 +1,15 @@
 #include "makoveeva_s_number_of_sentence/seq/include/ops_seq.hpp"
 
 #include <string>
+#include <utility>
 
 #include "makoveeva_s_number_of_sentence/common/include/common.hpp"
 
 namespace makoveeva_s_number_of_sentence {
 
-SentencesCounterSEQ::SentencesCounterSEQ(const InType &in) {
+SentencesCounterSEQ::SentencesCounterSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -12,7 +12,7 @@ class MarinLCntMismatChrtInTwoStrMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit MarinLCntMismatChrtInTwoStrMPI(const InType &in);
+  explicit MarinLCntMismatChrtInTwoStrMPI(InType in);
 
  private:
   bool ValidationImpl() override;
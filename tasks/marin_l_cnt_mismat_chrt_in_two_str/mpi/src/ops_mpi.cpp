@@ -12,9 +12,9 @@
 
 namespace marin_l_cnt_mismat_chrt_in_two_str {
 
-MarinLCntMismatChrtInTwoStrMPI::MarinLCntMismatChrtInTwoStrMPI(const InType &in) {
+MarinLCntMismatChrtInTwoStrMPI::MarinLCntMismatChrtInTwoStrMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -5,6 +5,7 @@
 
 #include "melnik_i_min_neigh_diff_vec/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/distribution.hpp"
 
 namespace melnik_i_min_neigh_diff_vec {
 
@@ -13,7 +14,7 @@ class MelnikIMinNeighDiffVecMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit MelnikIMinNeighDiffVecMPI(const InType &in);
+  explicit MelnikIMinNeighDiffVecMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -27,19 +28,12 @@ class MelnikIMinNeighDiffVecMPI : public BaseTask {
   };
 
   // Data distribute
-  void ScatterData(std::vector<int> &local_data, const std::vector<int> &counts, const std::vector<int> &displs,
-                   int rank);
+  void ScatterData(std::vector<int> &local_data, const ppc::util::BlockDistribution &dist, int rank);
 
   static void ComputeLocalMin(Result &local_res, const std::vector<int> &local_data, int local_size, int local_displ);
-  // Handle pairs crossing rank boundaries
-  static void HandleBoundaryDiffs(Result &local_res, int local_size, const std::vector<int> &local_data,
-                                  int local_displ, int rank, int comm_size);
-  // Non-blocking boundary exchange
-  static void PerformBoundaryCommunications(int left_boundary, int right_boundary, int &recv_from_left,
-                                            int &recv_from_right, int rank, int comm_size);
-  static void UpdateResultWithBoundaryDiffs(Result &local_res, int left_boundary, int right_boundary,
-                                            int recv_from_left, int recv_from_right, int local_displ, int local_size,
-                                            int rank, int comm_size);
+  // Pair crossing into the next block, its first element is the ghost behind local_data
+  static void UpdateResultWithBoundaryDiff(Result &local_res, const std::vector<int> &local_data, int local_size,
+                                           int local_displ);
   static void ReduceAndBroadcastResult(Result &global_res, const Result &local_res);
 };
 
@@ -2,19 +2,23 @@
 
 #include <mpi.h>
 
-#include <array>
+#include <cstddef>
 #include <cstdlib>
 #include <limits>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "melnik_i_min_neigh_diff_vec/common/include/common.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/halo.hpp"
 
 namespace melnik_i_min_neigh_diff_vec {
 
-MelnikIMinNeighDiffVecMPI::MelnikIMinNeighDiffVecMPI(const InType &in) {
+MelnikIMinNeighDiffVecMPI::MelnikIMinNeighDiffVecMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(-1, -1);
 }
 
@@ -35,11 +39,9 @@ bool MelnikIMinNeighDiffVecMPI::PreProcessingImpl() {
   return true;
 }
 
-void MelnikIMinNeighDiffVecMPI::ScatterData(std::vector<int> &local_data, const std::vector<int> &counts,
-                                            const std::vector<int> &displs, int rank) {
-  int *sendbuf = (rank == 0) ? this->GetInput().data() : nullptr;
-  MPI_Scatterv(sendbuf, counts.data(), displs.data(), MPI_INT, local_data.data(), static_cast<int>(local_data.size()),
-               MPI_INT, 0, MPI_COMM_WORLD);
+void MelnikIMinNeighDiffVecMPI::ScatterData(std::vector<int> &local_data, const ppc::util::BlockDistribution &dist,
+                                            int rank) {
+  ppc::util::Scatter(dist, this->GetInput(), std::span(local_data).first(dist.Count(rank)));
 }
 
 void MelnikIMinNeighDiffVecMPI::ComputeLocalMin(Result &local_res, const std::vector<int> &local_data, int local_size,
@@ -57,71 +59,13 @@ void MelnikIMinNeighDiffVecMPI::ComputeLocalMin(Result &local_res, const std::ve
   }
 }
 
-void MelnikIMinNeighDiffVecMPI::HandleBoundaryDiffs(Result &local_res, int local_size,
-                                                    const std::vector<int> &local_data, int local_displ, int rank,
-                                                    int comm_size) {
-  int left_boundary = (local_size > 0) ? local_data.front() : 0;
-  int right_boundary = (local_size > 0) ? local_data.back() : 0;
-  int recv_from_left = 0;
-  int recv_from_right = 0;
-
-  PerformBoundaryCommunications(left_boundary, right_boundary, recv_from_left, recv_from_right, rank, comm_size);
-
-  if (local_size > 0) {
-    UpdateResultWithBoundaryDiffs(local_res, left_boundary, right_boundary, recv_from_left, recv_from_right,
-                                  local_displ, local_size, rank, comm_size);
-  }
-}
-
-void MelnikIMinNeighDiffVecMPI::PerformBoundaryCommunications(int left_boundary, int right_boundary,
-                                                              int &recv_from_left, int &recv_from_right, int rank,
-                                                              int comm_size) {
-  // 4 operations maximum: send+recv from both neighbours
-  std::array<MPI_Request, 4> requests = {MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL};
-  int req_count = 0;
-
-  // left neighbour
-  if (rank > 0) {
-    MPI_Isend(&left_boundary, 1, MPI_INT, rank - 1, 0, MPI_COMM_WORLD, &requests.at(req_count));
-    ++req_count;
-    MPI_Irecv(&recv_from_left, 1, MPI_INT, rank - 1, 1, MPI_COMM_WORLD, &requests.at(req_count));
-    ++req_count;
-  }
-
-  // right neighbour
-  if (rank < comm_size - 1) {
-    MPI_Irecv(&recv_from_right, 1, MPI_INT, rank + 1, 0, MPI_COMM_WORLD, &requests.at(req_count));
-    ++req_count;
-    MPI_Isend(&right_boundary, 1, MPI_INT, rank + 1, 1, MPI_COMM_WORLD, &requests.at(req_count));
-    ++req_count;
-  }
-
-  if (req_count > 0) {
-    MPI_Waitall(req_count, requests.data(), MPI_STATUSES_IGNORE);
-  }
-}
-
-void MelnikIMinNeighDiffVecMPI::UpdateResultWithBoundaryDiffs(Result &local_res, int left_boundary, int right_boundary,
-                                                              int recv_from_left, int recv_from_right, int local_displ,
-                                                              int local_size, int rank, int comm_size) {
-  // left neighbour result vs left boundary
-  if (rank > 0) {
-    int boundary_delta = std::abs(left_boundary - recv_from_left);
-    int boundary_idx = local_displ - 1;
-    if (boundary_delta < local_res.delta || (boundary_delta == local_res.delta && boundary_idx < local_res.index)) {
-      local_res.delta = boundary_delta;
-      local_res.index = boundary_idx;
-    }
-  }
-
-  // right neighbour result vs right boundary
-  if (rank < comm_size - 1) {
-    int boundary_delta = std::abs(recv_from_right - right_boundary);
-    int boundary_idx = local_displ + local_size - 1;
-    if (boundary_delta < local_res.delta || (boundary_delta == local_res.delta && boundary_idx < local_res.index)) {
-      local_res.delta = boundary_delta;
-      local_res.index = boundary_idx;
-    }
+void MelnikIMinNeighDiffVecMPI::UpdateResultWithBoundaryDiff(Result &local_res, const std::vector<int> &local_data,
+                                                             int local_size, int local_displ) {
+  // The boundary pair has the largest index of the block, so it only wins with a strictly smaller delta
+  int boundary_delta = std::abs(local_data[local_size] - local_data[local_size - 1]);
+  if (boundary_delta < local_res.delta) {
+    local_res.delta = boundary_delta;
+    local_res.index = local_displ + local_size - 1;
   }
 }
 
@@ -142,36 +86,23 @@ bool MelnikIMinNeighDiffVecMPI::RunImpl() {
   }
   MPI_Bcast(&global_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-  // Distribution with remainder
-  std::vector<int> counts(comm_size);
-  std::vector<int> displs(comm_size);
-  if (rank == 0) {
-    int base = global_size / comm_size;
-    int rem = global_size % comm_size;
-    int offset = 0;
-    for (int i = 0; i < comm_size; i++) {
-      counts[i] = base + (i < rem ? 1 : 0);
-      displs[i] = offset;
-      offset += counts[i];
-    }
-  }
-
-  int local_size = 0;
-  MPI_Scatter(counts.data(), 1, MPI_INT, &local_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  std::vector<int> local_data(local_size);
-  ScatterData(local_data, counts, displs, rank);
+  const ppc::util::BlockDistribution dist(static_cast<std::size_t>(global_size), comm_size);
+  const int local_size = static_cast<int>(dist.Count(rank));
+  const int local_displ = static_cast<int>(dist.Offset(rank));
 
-  // Compute displacement
-  int local_displ = 0;
-  MPI_Scan(&local_size, &local_displ, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  local_displ -= local_size;
+  // Own elements followed by one ghost, the first element of the next block
+  std::vector<int> local_data(ppc::util::HaloExchange::PaddedSize(dist, rank, {.after = 1}));
+  ScatterData(local_data, dist, rank);
 
+  // Pairs inside the block are compared while the ghost is in flight
+  ppc::util::HaloExchange halo(dist, {.after = 1}, local_data);
+  halo.Start();
   Result local_res;
   ComputeLocalMin(local_res, local_data, local_size, local_displ);
+  halo.Finish();
 
-  if (comm_size > 1) {
-    HandleBoundaryDiffs(local_res, local_size, local_data, local_displ, rank, comm_size);
+  if (halo.HasNeighbour(ppc::util::HaloSide::kAfter)) {
+    UpdateResultWithBoundaryDiff(local_res, local_data, local_size, local_displ);
   }
 
   Result global_res;
@@ -10,7 +10,7 @@ class MorozovNSentenceCountMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit MorozovNSentenceCountMPI(const InType &in);
+  explicit MorozovNSentenceCountMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -5,14 +5,15 @@
 #include <cstddef>
 #include <iostream>
 #include <string>
+#include <utility>
 
 #include "morozov_n_sentence_count/common/include/common.hpp"
 
 namespace morozov_n_sentence_count {
 
-MorozovNSentenceCountMPI::MorozovNSentenceCountMPI(const InType &in) {
+MorozovNSentenceCountMPI::MorozovNSentenceCountMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
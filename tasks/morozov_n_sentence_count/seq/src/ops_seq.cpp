@@ -2,14 +2,15 @@
 
 #include <cstddef>
 #include <string>
+#include <utility>
 
 #include "morozov_n_sentence_count/common/include/common.hpp"
 
 namespace morozov_n_sentence_count {
 
-MorozovNSentenceCountSEQ::MorozovNSentenceCountSEQ(const InType &in) {
+MorozovNSentenceCountSEQ::MorozovNSentenceCountSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
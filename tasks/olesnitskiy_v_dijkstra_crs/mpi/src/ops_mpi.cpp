@@ -2,20 +2,21 @@
 
 #include <mpi.h>
 
-#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <queue>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
+#include "util/include/distribution.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
 
-OlesnitskiyVDijkstraCrsMPI::OlesnitskiyVDijkstraCrsMPI(const InType &in) {
+OlesnitskiyVDijkstraCrsMPI::OlesnitskiyVDijkstraCrsMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::vector<int>();
 }
 
@@ -51,19 +52,9 @@ bool OlesnitskiyVDijkstraCrsMPI::IsVertexLocal(int vertex, int start_idx, int en
   return vertex >= start_idx && vertex < end_idx;
 }
 
-int OlesnitskiyVDijkstraCrsMPI::FindOwner(int vertex, const std::vector<int> &displs, const std::vector<int> &counts,
-                                          int size) {
-  for (int j = 0; j < size; ++j) {
-    if (vertex >= displs[j] && vertex < (displs[j] + counts[j])) {
-      return j;
-    }
-  }
-  return 0;
-}
-
 void OlesnitskiyVDijkstraCrsMPI::ProcessLocalVertex(int vertex, int distance, const std::vector<int> &offsets,
                                                     const std::vector<int> &edges, const std::vector<int> &weights,
-                                                    DijkstraContext &ctx, int rank, int size) {
+                                                    DijkstraContext &ctx, int rank) {
   int start = offsets[vertex];
   int end = offsets[vertex + 1];
 
@@ -72,7 +63,7 @@ void OlesnitskiyVDijkstraCrsMPI::ProcessLocalVertex(int vertex, int distance, co
     int weight = weights[i];
     int new_dist = distance + weight;
 
-    int owner = FindOwner(neighbor, ctx.displs, ctx.counts, size);
+    int owner = ctx.blocks.Owner(static_cast<std::size_t>(neighbor));
 
     if (owner == rank) {
       int neighbor_local_idx = neighbor - ctx.start_idx;
@@ -182,17 +173,10 @@ void OlesnitskiyVDijkstraCrsMPI::ExchangeUpdates(DijkstraContext &ctx) {
 OlesnitskiyVDijkstraCrsMPI::DijkstraContext OlesnitskiyVDijkstraCrsMPI::InitializeLocalData(int vertices, int size,
                                                                                             int rank, int source) {
   DijkstraContext ctx;
-  ctx.counts.resize(size);
-  ctx.displs.resize(size);
-
-  for (int idx = 0; idx < size; ++idx) {
-    ctx.counts[idx] = (vertices / size) + (idx < (vertices % size) ? 1 : 0);
-    ctx.displs[idx] = (idx == 0) ? 0 : ctx.displs[idx - 1] + ctx.counts[idx - 1];
-  }
-
-  ctx.start_idx = ctx.displs[rank];
-  ctx.end_idx = ctx.start_idx + ctx.counts[rank];
-  ctx.local_vertices = ctx.counts[rank];
+  ctx.blocks = ppc::util::BlockDistribution(static_cast<std::size_t>(vertices), size);
+  ctx.start_idx = static_cast<int>(ctx.blocks.Offset(rank));
+  ctx.local_vertices = static_cast<int>(ctx.blocks.Count(rank));
+  ctx.end_idx = ctx.start_idx + ctx.local_vertices;
 
   ctx.local_distances.resize(ctx.local_vertices, std::numeric_limits<int>::max());
   ctx.local_visited.resize(ctx.local_vertices, false);
@@ -206,8 +190,7 @@ OlesnitskiyVDijkstraCrsMPI::DijkstraContext OlesnitskiyVDijkstraCrsMPI::Initiali
   return ctx;
 }
 
-OlesnitskiyVDijkstraCrsMPI::GraphData OlesnitskiyVDijkstraCrsMPI::BroadcastGraphData(int rank, int /*size*/,
-                                                                                     const InType &input) {
+OlesnitskiyVDijkstraCrsMPI::GraphData OlesnitskiyVDijkstraCrsMPI::BroadcastGraphData(int rank, const InType &input) {
   GraphData graph;
 
   if (rank == 0) {
@@ -273,7 +256,7 @@ bool OlesnitskiyVDijkstraCrsMPI::ShouldStopAlgorithm(const DistVertexPair &globa
 }
 
 void OlesnitskiyVDijkstraCrsMPI::ProcessGlobalVertex(const DistVertexPair &global_best, const GraphData &graph,
-                                                     DijkstraContext &ctx, int rank, int size) {
+                                                     DijkstraContext &ctx, int rank) {
   if (!IsVertexLocal(global_best.vertex, ctx.start_idx, ctx.end_idx)) {
     return;
   }
@@ -288,11 +271,10 @@ void OlesnitskiyVDijkstraCrsMPI::ProcessGlobalVertex(const DistVertexPair &globa
     ctx.pq.pop();
   }
 
-  ProcessLocalVertex(global_best.vertex, global_best.dist, graph.offsets, graph.edges, graph.weights, ctx, rank, size);
+  ProcessLocalVertex(global_best.vertex, global_best.dist, graph.offsets, graph.edges, graph.weights, ctx, rank);
 }
 
-bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph, DijkstraContext &ctx, int rank,
-                                                          int size) {
+bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph, DijkstraContext &ctx, int rank) {
   DistVertexPair local_best;
   if (!FindLocalBestVertex(ctx, local_best)) {
     return true;
@@ -304,7 +286,7 @@ bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph
     return false;
   }
 
-  ProcessGlobalVertex(global_best, graph, ctx, rank, size);
+  ProcessGlobalVertex(global_best, graph, ctx, rank);
   ExchangeUpdates(ctx);
 
   int local_active = !ctx.pq.empty() ? 1 : 0;
@@ -313,32 +295,19 @@ bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph
   return true;
 }
 
-void OlesnitskiyVDijkstraCrsMPI::RunDijkstraAlgorithm(const GraphData &graph, DijkstraContext &ctx, int rank,
-                                                      int size) {
+void OlesnitskiyVDijkstraCrsMPI::RunDijkstraAlgorithm(const GraphData &graph, DijkstraContext &ctx, int rank) {
   ctx.active = 1;
   while (ctx.active > 0) {
-    if (!PerformDijkstraIteration(graph, ctx, rank, size)) {
+    if (!PerformDijkstraIteration(graph, ctx, rank)) {
       break;
     }
   }
 }
 
-void OlesnitskiyVDijkstraCrsMPI::CollectResults(const GraphData &graph, const DijkstraContext &ctx, int rank,
-                                                int size) {
-  if (rank == 0) {
-    std::vector<int> global_distances(graph.vertices, std::numeric_limits<int>::max());
-    std::ranges::copy(ctx.local_distances, global_distances.begin() + ctx.start_idx);
-
-    for (int src = 1; src < size; ++src) {
-      MPI_Recv(global_distances.data() + ctx.displs[src], ctx.counts[src], MPI_INT, src, 0, MPI_COMM_WORLD,
-               MPI_STATUS_IGNORE);
-    }
-
-    GetOutput() = global_distances;
-  } else {
-    MPI_Send(ctx.local_distances.data(), ctx.local_vertices, MPI_INT, 0, 0, MPI_COMM_WORLD);
-    GetOutput() = std::vector<int>();
-  }
+void OlesnitskiyVDijkstraCrsMPI::CollectResults(const GraphData &graph, const DijkstraContext &ctx, int rank) {
+  std::vector<int> global_distances(rank == 0 ? graph.vertices : 0);
+  ppc::util::Gather(ctx.blocks, ctx.local_distances, global_distances);
+  GetOutput() = std::move(global_distances);
 }
 
 bool OlesnitskiyVDijkstraCrsMPI::RunImpl() {
@@ -347,13 +316,13 @@ bool OlesnitskiyVDijkstraCrsMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  GraphData graph = BroadcastGraphData(rank, size, GetInput());
+  GraphData graph = BroadcastGraphData(rank, GetInput());
 
   DijkstraContext ctx = InitializeLocalData(graph.vertices, size, rank, graph.source);
 
-  RunDijkstraAlgorithm(graph, ctx, rank, size);
+  RunDijkstraAlgorithm(graph, ctx, rank);
 
-  CollectResults(graph, ctx, rank, size);
+  CollectResults(graph, ctx, rank);
 
   return true;
 }
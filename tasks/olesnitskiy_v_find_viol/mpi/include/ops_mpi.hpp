@@ -10,7 +10,7 @@ class OlesnitskiyVFindViolMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit OlesnitskiyVFindViolMPI(const InType &in);
+  explicit OlesnitskiyVFindViolMPI(InType in);
   bool RunSequentialCase();
 
  private:
@@ -10,7 +10,7 @@ class OlesnitskiyVFindViolSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit OlesnitskiyVFindViolSEQ(const InType &in);
+  explicit OlesnitskiyVFindViolSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
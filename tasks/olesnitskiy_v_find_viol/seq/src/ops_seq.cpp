@@ -1,14 +1,15 @@
 #include "olesnitskiy_v_find_viol/seq/include/ops_seq.hpp"
 
+#include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_find_viol/common/include/common.hpp"
 
 namespace olesnitskiy_v_find_viol {
 
-OlesnitskiyVFindViolSEQ::OlesnitskiyVFindViolSEQ(const InType &in) {
+OlesnitskiyVFindViolSEQ::OlesnitskiyVFindViolSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
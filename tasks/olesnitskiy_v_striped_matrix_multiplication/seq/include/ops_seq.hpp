@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstddef>
-#include <vector>
 
 #include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
 #include "task/include/task.hpp"
@@ -13,7 +12,7 @@ class OlesnitskiyVStripedMatrixMultiplicationSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit OlesnitskiyVStripedMatrixMultiplicationSEQ(const InType &in);
+  explicit OlesnitskiyVStripedMatrixMultiplicationSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -26,13 +25,10 @@ class OlesnitskiyVStripedMatrixMultiplicationSEQ : public BaseTask {
 
   size_t rows_a_{0};
   size_t cols_a_{0};
-  std::vector<double> data_a_;
   size_t rows_b_{0};
   size_t cols_b_{0};
-  std::vector<double> data_b_;
   size_t rows_c_{0};
   size_t cols_c_{0};
-  std::vector<double> result_c_;
   int num_stripes_{1};
 };
 }  // namespace olesnitskiy_v_striped_matrix_multiplication
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
@@ -25,9 +26,9 @@ int FindCommonDivisor(int a, int b, int max_divisor) {
 }
 }  // namespace
 
-OlesnitskiyVStripedMatrixMultiplicationSEQ::OlesnitskiyVStripedMatrixMultiplicationSEQ(const InType &in) {
+OlesnitskiyVStripedMatrixMultiplicationSEQ::OlesnitskiyVStripedMatrixMultiplicationSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(0, 0, std::vector<double>());
 }
 
@@ -36,10 +37,8 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::ValidationImpl() {
   const auto &[out_rows, out_cols, out_data] = GetOutput();
   rows_a_ = rows_a;
   cols_a_ = cols_a;
-  data_a_ = data_a;
   rows_b_ = rows_b;
   cols_b_ = cols_b;
-  data_b_ = data_b;
   if (rows_a == 0 || cols_a == 0 || rows_b == 0 || cols_b == 0) {
     return false;
   }
@@ -64,7 +63,6 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::PreProcessingImpl() {
   if (num_stripes_ < 2) {
     num_stripes_ = 1;
   }
-  result_c_.resize(rows_c_ * cols_c_, 0.0);
   GetOutput() = std::make_tuple(0, 0, std::vector<double>());
   return true;
 }
@@ -75,7 +73,8 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::RunImpl() {
     return true;
   }
 
-  result_c_.resize(rows_c_ * cols_c_, 0.0);
+  // The product is written straight into the output and the factors are read from the input, without copies
+  std::get<2>(GetOutput()).assign(rows_c_ * cols_c_, 0.0);
 
   bool success = false;
   if (num_stripes_ == 1) {
@@ -85,20 +84,24 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::RunImpl() {
   }
 
   if (success) {
-    GetOutput() = std::make_tuple(rows_c_, cols_c_, result_c_);
+    std::get<0>(GetOutput()) = rows_c_;
+    std::get<1>(GetOutput()) = cols_c_;
   }
 
   return success;
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationSEQ::MultiplySimple() {
+  const auto &data_a = std::get<2>(GetInput());
+  const auto &data_b = std::get<5>(GetInput());
+  auto &result_c = std::get<2>(GetOutput());
   for (size_t i = 0; i < rows_a_; ++i) {
     for (size_t j = 0; j < cols_b_; ++j) {
       double sum = 0.0;
       for (size_t k = 0; k < cols_a_; ++k) {
-        sum += data_a_[(i * cols_a_) + k] * data_b_[(k * cols_b_) + j];
+        sum += data_a[(i * cols_a_) + k] * data_b[(k * cols_b_) + j];
       }
-      result_c_[(i * cols_b_) + j] = sum;
+      result_c[(i * cols_b_) + j] = sum;
     }
   }
   return true;
@@ -106,6 +109,9 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::MultiplySimple() {
 
 bool OlesnitskiyVStripedMatrixMultiplicationSEQ::ProcessStripePair(int stripe_a, int stripe_b, size_t rows_per_stripe,
                                                                    size_t cols_per_stripe) {
+  const auto &data_a = std::get<2>(GetInput());
+  const auto &data_b = std::get<5>(GetInput());
+  auto &result_c = std::get<2>(GetOutput());
   const size_t start_row_a = static_cast<size_t>(stripe_a) * rows_per_stripe;
   const size_t start_col_b = static_cast<size_t>(stripe_b) * cols_per_stripe;
 
@@ -116,9 +122,9 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::ProcessStripePair(int stripe_a,
       double sum = 0.0;
 
       for (size_t k = 0; k < cols_a_; ++k) {
-        sum += data_a_[(row_idx * cols_a_) + k] * data_b_[(k * cols_b_) + col_idx];
+        sum += data_a[(row_idx * cols_a_) + k] * data_b[(k * cols_b_) + col_idx];
       }
-      result_c_[(row_idx * cols_b_) + col_idx] = sum;
+      result_c[(row_idx * cols_b_) + col_idx] = sum;
     }
   }
   return true;
@@ -9,7 +9,7 @@ class OtcheskovSElemVecAvgMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit OtcheskovSElemVecAvgMPI(const InType &in);
+  explicit OtcheskovSElemVecAvgMPI(InType in);
 
  private:
   bool ValidationImpl() override;
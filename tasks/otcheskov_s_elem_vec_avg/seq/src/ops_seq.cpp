@@ -3,14 +3,15 @@
 #include <cmath>
 #include <cstdint>
 #include <numeric>
+#include <utility>
 
 #include "otcheskov_s_elem_vec_avg/common/include/common.hpp"
 
 namespace otcheskov_s_elem_vec_avg {
 
-OtcheskovSElemVecAvgSEQ::OtcheskovSElemVecAvgSEQ(const InType &in) {
+OtcheskovSElemVecAvgSEQ::OtcheskovSElemVecAvgSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = NAN;
 }
 
@@ -10,7 +10,7 @@ class OvchinnikovMBubbleSortMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit OvchinnikovMBubbleSortMPI(const InType &in);
+  explicit OvchinnikovMBubbleSortMPI(InType in);
 
  private:
   bool ValidationImpl() override;
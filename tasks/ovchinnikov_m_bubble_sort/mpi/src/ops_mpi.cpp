@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "ovchinnikov_m_bubble_sort/common/include/common.hpp"
@@ -119,9 +120,9 @@ void ManageOddEven(int rank, int proc_count, std::vector<int> &local_data) {
 
 }  // namespace
 
-OvchinnikovMBubbleSortMPI::OvchinnikovMBubbleSortMPI(const InType &in) {
+OvchinnikovMBubbleSortMPI::OvchinnikovMBubbleSortMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   static_cast<void>(GetOutput());
 }
 
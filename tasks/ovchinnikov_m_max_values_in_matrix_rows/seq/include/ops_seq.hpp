@@ -10,7 +10,7 @@ class OvchinnikovMMaxValuesInMatrixRowsSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit OvchinnikovMMaxValuesInMatrixRowsSEQ(const InType &in);
+  explicit OvchinnikovMMaxValuesInMatrixRowsSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -12,9 +12,9 @@
 
 namespace pankov_a_string_word_count {
 
-PankovAStringWordCountMPI::PankovAStringWordCountMPI(const InType &in) {
+PankovAStringWordCountMPI::PankovAStringWordCountMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -2,14 +2,15 @@
 
 #include <cctype>
 #include <string>
+#include <utility>
 
 #include "pankov_a_string_word_count/common/include/common.hpp"
 
 namespace pankov_a_string_word_count {
 
-PankovAStringWordCountSEQ::PankovAStringWordCountSEQ(const InType &in) {
+PankovAStringWordCountSEQ::PankovAStringWordCountSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
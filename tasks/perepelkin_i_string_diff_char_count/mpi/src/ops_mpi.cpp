@@ -6,19 +6,20 @@
 #include <cstddef>
 #include <functional>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "perepelkin_i_string_diff_char_count/common/include/common.hpp"
 
 namespace perepelkin_i_string_diff_char_count {
 
-PerepelkinIStringDiffCharCountMPI::PerepelkinIStringDiffCharCountMPI(const InType &in) {
+PerepelkinIStringDiffCharCountMPI::PerepelkinIStringDiffCharCountMPI(InType in) {
   MPI_Comm_rank(MPI_COMM_WORLD, &proc_rank_);
   MPI_Comm_size(MPI_COMM_WORLD, &proc_num_);
 
   SetTypeOfTask(GetStaticTypeOfTask());
   if (proc_rank_ == 0) {
-    GetInput() = in;
+    GetInput() = std::move(in);
   }
   GetOutput() = 0;
 }
@@ -10,7 +10,7 @@ class PerepelkinIStringDiffCharCountSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit PerepelkinIStringDiffCharCountSEQ(const InType &in);
+  explicit PerepelkinIStringDiffCharCountSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -4,14 +4,15 @@
 #include <cstddef>
 #include <functional>
 #include <numeric>
+#include <utility>
 
 #include "perepelkin_i_string_diff_char_count/common/include/common.hpp"
 
 namespace perepelkin_i_string_diff_char_count {
 
-PerepelkinIStringDiffCharCountSEQ::PerepelkinIStringDiffCharCountSEQ(const InType &in) {
+PerepelkinIStringDiffCharCountSEQ::PerepelkinIStringDiffCharCountSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
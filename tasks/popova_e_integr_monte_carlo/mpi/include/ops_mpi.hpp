@@ -10,7 +10,7 @@ class PopovaEIntegrMonteCarloMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit PopovaEIntegrMonteCarloMPI(const InType &in);
+  explicit PopovaEIntegrMonteCarloMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -3,15 +3,18 @@
 #include <mpi.h>
 
 #include <cmath>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "popova_e_integr_monte_carlo/common/include/common.hpp"
+#include "util/include/distribution.hpp"
 
 namespace popova_e_integr_monte_carlo {
 
-PopovaEIntegrMonteCarloMPI::PopovaEIntegrMonteCarloMPI(const InType &in) {
+PopovaEIntegrMonteCarloMPI::PopovaEIntegrMonteCarloMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -36,25 +39,8 @@ bool PopovaEIntegrMonteCarloMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  std::vector<int> points_per_process(size);
-  std::vector<int> displacements(size);
-
-  int base_point_count = point_count_ / size;
-  int extra_points = point_count_ % size;
-
-  int curr_start_index = 0;
-  for (int i = 0; i < size; ++i) {
-    if (i < extra_points) {
-      points_per_process[i] = base_point_count + 1;
-    } else {
-      points_per_process[i] = base_point_count;
-    }
-
-    displacements[i] = curr_start_index;
-    curr_start_index += points_per_process[i];
-  }
-
-  int local_points_to_process = points_per_process[rank];
+  const ppc::util::BlockDistribution points(static_cast<std::size_t>(point_count_), size);
+  const auto local_points_to_process = static_cast<int>(points.Count(rank));
 
   std::vector<double> all_seeds;
   if (rank == 0) {
@@ -65,8 +51,7 @@ bool PopovaEIntegrMonteCarloMPI::RunImpl() {
   }
 
   std::vector<double> local_seeds(local_points_to_process);
-  MPI_Scatterv(all_seeds.data(), points_per_process.data(), displacements.data(), MPI_DOUBLE, local_seeds.data(),
-               local_points_to_process, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  ppc::util::Scatter(points, all_seeds, local_seeds);
 
   double local_sum = 0.0;
   const double magic_constant = 0.75487766624669276;
@@ -10,7 +10,7 @@ class PopovaEIntegrMonteCarloSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit PopovaEIntegrMonteCarloSEQ(const InType &in);
+  explicit PopovaEIntegrMonteCarloSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
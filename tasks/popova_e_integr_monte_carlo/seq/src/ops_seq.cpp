@@ -1,14 +1,15 @@
 #include "popova_e_integr_monte_carlo/seq/include/ops_seq.hpp"
 
 #include <cmath>
+#include <utility>
 
 #include "popova_e_integr_monte_carlo/common/include/common.hpp"
 
 namespace popova_e_integr_monte_carlo {
 
-PopovaEIntegrMonteCarloSEQ::PopovaEIntegrMonteCarloSEQ(const InType &in) {
+PopovaEIntegrMonteCarloSEQ::PopovaEIntegrMonteCarloSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
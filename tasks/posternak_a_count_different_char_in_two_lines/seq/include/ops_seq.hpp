@@ -10,7 +10,7 @@ class PosternakACountDifferentCharInTwoLinesSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit PosternakACountDifferentCharInTwoLinesSEQ(const InType &in);
+  explicit PosternakACountDifferentCharInTwoLinesSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -30,7 +30,7 @@ class RomanovMClosestElemVecMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit RomanovMClosestElemVecMPI(const InType &in);
+  explicit RomanovMClosestElemVecMPI(InType in);
 
  private:
   bool ValidationImpl() override;
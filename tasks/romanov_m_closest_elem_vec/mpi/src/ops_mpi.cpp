@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <limits>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "romanov_m_closest_elem_vec/common/include/common.hpp"
@@ -72,9 +73,9 @@ void LocalFindMinDiff(const std::vector<int> &local_data, int local_sz, int glob
   }
 }
 
-RomanovMClosestElemVecMPI::RomanovMClosestElemVecMPI(const InType &in) {
+RomanovMClosestElemVecMPI::RomanovMClosestElemVecMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(-1, -1);
 }
 
@@ -10,7 +10,7 @@ class RomanovMClosestElemVecSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit RomanovMClosestElemVecSEQ(const InType &in);
+  explicit RomanovMClosestElemVecSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -16,7 +16,7 @@ class SabirovSHypercubeMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit SabirovSHypercubeMPI(const InType &in);
+  explicit SabirovSHypercubeMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -4,15 +4,16 @@
 
 #include <cmath>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "sabirov_s_hypercube/common/include/common.hpp"
 
 namespace sabirov_s_hypercube {
 
-SabirovSHypercubeMPI::SabirovSHypercubeMPI(const InType &in) {
+SabirovSHypercubeMPI::SabirovSHypercubeMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = HypercubeOutput{.received_data = {}, .route = {}, .success = false};
 }
 
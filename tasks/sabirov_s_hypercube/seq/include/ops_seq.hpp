@@ -15,7 +15,7 @@ class SabirovSHypercubeSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit SabirovSHypercubeSEQ(const InType &in);
+  explicit SabirovSHypercubeSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
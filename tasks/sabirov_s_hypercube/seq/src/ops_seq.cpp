@@ -2,15 +2,16 @@
 
 #include <cmath>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "sabirov_s_hypercube/common/include/common.hpp"
 
 namespace sabirov_s_hypercube {
 
-SabirovSHypercubeSEQ::SabirovSHypercubeSEQ(const InType &in) {
+SabirovSHypercubeSEQ::SabirovSHypercubeSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = HypercubeOutput{.received_data = {}, .route = {}, .success = false};
 }
 
@@ -6,15 +6,15 @@
 #include <cstdint>
 #include <string>
 #include <tuple>
-#include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/aligned_allocator.hpp"
 
 namespace sabirov_s_linear_filtering_block_partitioning {
 
 // Структура для хранения данных изображения
 struct ImageData {
-  std::vector<uint8_t> pixels;  // Пиксели в формате RGB
+  ppc::util::AlignedVector<uint8_t> pixels;  // Пиксели в формате RGB, выровнены по кэш-линии
   int width{0};
   int height{0};
   int channels{3};  // RGB = 3 канала
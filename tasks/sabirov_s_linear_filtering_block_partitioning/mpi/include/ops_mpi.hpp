@@ -10,7 +10,7 @@ class SabirovSLinearFilteringBlockPartitioningMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit SabirovSLinearFilteringBlockPartitioningMPI(const InType &in);
+  explicit SabirovSLinearFilteringBlockPartitioningMPI(InType in);
 
  private:
   bool ValidationImpl() override;
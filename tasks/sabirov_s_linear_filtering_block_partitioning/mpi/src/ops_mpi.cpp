@@ -6,14 +6,20 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include <utility>
 
 #include "sabirov_s_linear_filtering_block_partitioning/common/include/common.hpp"
+#include "util/include/aligned_allocator.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/halo.hpp"
+#include "util/include/util.hpp"
 
 namespace sabirov_s_linear_filtering_block_partitioning {
 
-SabirovSLinearFilteringBlockPartitioningMPI::SabirovSLinearFilteringBlockPartitioningMPI(const InType &in) {
+SabirovSLinearFilteringBlockPartitioningMPI::SabirovSLinearFilteringBlockPartitioningMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool SabirovSLinearFilteringBlockPartitioningMPI::ValidationImpl() {
@@ -49,7 +55,11 @@ bool SabirovSLinearFilteringBlockPartitioningMPI::PreProcessingImpl() {
   } else {
     std::array<int, 3> dims = {0, 0, 0};
     MPI_Bcast(dims.data(), 3, MPI_INT, 0, MPI_COMM_WORLD);
-    GetInput() = ImageData(dims[0], dims[1], dims[2]);
+    // Только размеры: пиксели получает лишь процесс 0, остальные принимают свою полосу строк в RunImpl
+    auto &input = GetInput();
+    input.width = dims[0];
+    input.height = dims[1];
+    input.channels = dims[2];
     GetOutput() = ImageData(dims[0], dims[1], dims[2]);
   }
 
@@ -57,62 +67,32 @@ bool SabirovSLinearFilteringBlockPartitioningMPI::PreProcessingImpl() {
 }
 
 namespace {
-// Вспомогательная функция для фильтрации блока строк
-void FilterRows(const ImageData &input, ImageData &output, int start_row, int end_row) {
-  const int width = input.width;
-  const int channels = input.channels;
-
-  for (int row = start_row; row < end_row; row++) {
+// Фильтрует строки [first_row, last_row) полосы; строка row полосы попадает в строку row - 1 результата,
+// так как строка 0 полосы - теневая
+void FilterRows(const ImageData &stripe, ppc::util::AlignedVector<uint8_t> &output, int first_row, int last_row) {
+  const int width = stripe.width;
+  const int channels = stripe.channels;
+
+#pragma omp parallel for default(none) shared(stripe, output, width, channels, first_row, last_row) \
+    num_threads(ppc::util::GetNumThreads())
+  for (int row = first_row; row < last_row; row++) {
     for (int col = 0; col < width; col++) {
       for (int ch = 0; ch < channels; ch++) {
-        float sum = ApplyGaussianKernel(input, row, col, ch);
+        float sum = ApplyGaussianKernel(stripe, row, col, ch);
         auto output_idx =
-            ((static_cast<std::size_t>(row) * static_cast<std::size_t>(width) + static_cast<std::size_t>(col)) *
+            ((static_cast<std::size_t>(row - 1) * static_cast<std::size_t>(width) + static_cast<std::size_t>(col)) *
              static_cast<std::size_t>(channels)) +
             static_cast<std::size_t>(ch);
-        output.pixels[output_idx] = static_cast<uint8_t>(std::clamp(sum, 0.0F, 255.0F));
+        output[output_idx] = static_cast<uint8_t>(std::clamp(sum, 0.0F, 255.0F));
       }
     }
   }
 }
 
-// Вспомогательная функция для рассылки изображения
-void BroadcastImage(ImageData &input, int rank, int size) {
-  if (rank == 0) {
-    for (int dest = 1; dest < size; dest++) {
-      MPI_Send(input.pixels.data(), static_cast<int>(input.pixels.size()), MPI_UNSIGNED_CHAR, dest, 0, MPI_COMM_WORLD);
-    }
-  } else {
-    MPI_Recv(input.pixels.data(), static_cast<int>(input.pixels.size()), MPI_UNSIGNED_CHAR, 0, 0, MPI_COMM_WORLD,
-             MPI_STATUS_IGNORE);
-  }
-}
-
-// Вспомогательная функция для сбора результатов
-void GatherResults(ImageData &output, int rank, int size, int rows_per_proc, int remainder, int width, int channels) {
-  if (rank == 0) {
-    for (int src = 1; src < size; src++) {
-      int src_start = (src * rows_per_proc) + std::min(src, remainder);
-      int src_end = src_start + rows_per_proc + (src < remainder ? 1 : 0);
-      int src_size = (src_end - src_start) * width * channels;
-
-      if (src_size > 0) {
-        auto offset =
-            static_cast<std::size_t>(src_start) * static_cast<std::size_t>(width) * static_cast<std::size_t>(channels);
-        MPI_Recv(output.pixels.data() + offset, src_size, MPI_UNSIGNED_CHAR, src, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-      }
-    }
-  } else {
-    int start_row = (rank * rows_per_proc) + std::min(rank, remainder);
-    int end_row = start_row + rows_per_proc + (rank < remainder ? 1 : 0);
-    int local_size = (end_row - start_row) * width * channels;
-
-    if (local_size > 0) {
-      auto offset =
-          static_cast<std::size_t>(start_row) * static_cast<std::size_t>(width) * static_cast<std::size_t>(channels);
-      MPI_Send(output.pixels.data() + offset, local_size, MPI_UNSIGNED_CHAR, 0, 1, MPI_COMM_WORLD);
-    }
-  }
+// Повторяет крайнюю строку изображения в теневой строке, как ограничение координат в ApplyGaussianKernel
+void CopyRow(ImageData &stripe, int from, int to) {
+  const auto row_size = static_cast<std::ptrdiff_t>(stripe.width) * stripe.channels;
+  std::copy_n(stripe.pixels.begin() + (from * row_size), row_size, stripe.pixels.begin() + (to * row_size));
 }
 }  // namespace
 
@@ -129,28 +109,43 @@ bool SabirovSLinearFilteringBlockPartitioningMPI::RunImpl() {
     return false;
   }
 
-  const int width = input.width;
-  const int height = input.height;
-  const int channels = input.channels;
+  const auto height = static_cast<std::size_t>(input.height);
+  const auto row_size = static_cast<std::size_t>(input.width) * static_cast<std::size_t>(input.channels);
 
-  // Рассылаем входное изображение от процесса 0 всем процессам
-  BroadcastImage(input, rank, size);
+  // Блочное разбиение по строкам: каждый процесс получает только свою полосу, а не всё изображение
+  const ppc::util::BlockDistribution rows(height, size);
+  const ppc::util::MatrixDistribution stripes(height, row_size, size, ppc::util::MatrixLayout::kRows);
+  const int local_rows = static_cast<int>(rows.Count(rank));
 
-  // Вычисляем блочное разбиение (распределяем строки между процессами)
-  int rows_per_proc = height / size;
-  int remainder = height % size;
+  // Своя полоса с одной теневой строкой сверху и снизу - всё, что ядру 3x3 нужно от соседей
+  ImageData stripe(input.width, local_rows + 2, input.channels);
+  const std::span<uint8_t> own_rows = std::span(stripe.pixels).subspan(row_size, rows.Count(rank) * row_size);
+  ppc::util::Scatter(stripes, input.pixels, own_rows);
 
-  int start_row = (rank * rows_per_proc) + std::min(rank, remainder);
-  int end_row = start_row + rows_per_proc + (rank < remainder ? 1 : 0);
-
-  // Каждый процесс фильтрует свои назначенные строки
-  FilterRows(input, output, start_row, end_row);
+  ppc::util::HaloExchange halo(rows, {.before = 1, .after = 1}, stripe.pixels, MPI_COMM_WORLD, row_size);
+  if (local_rows > 0) {
+    if (!halo.HasNeighbour(ppc::util::HaloSide::kBefore)) {
+      CopyRow(stripe, 1, 0);
+    }
+    if (!halo.HasNeighbour(ppc::util::HaloSide::kAfter)) {
+      CopyRow(stripe, local_rows, local_rows + 1);
+    }
+  }
 
-  // Собираем результаты на процессе 0
-  GatherResults(output, rank, size, rows_per_proc, remainder, width, channels);
+  // Внутренние строки не зависят от соседей и фильтруются, пока теневые строки в пути
+  ppc::util::AlignedVector<uint8_t> local_output(own_rows.size());
+  halo.Start();
+  FilterRows(stripe, local_output, 2, local_rows);
+  halo.Finish();
+  if (local_rows > 0) {
+    FilterRows(stripe, local_output, 1, 2);
+  }
+  if (local_rows > 1) {
+    FilterRows(stripe, local_output, local_rows, local_rows + 1);
+  }
 
-  // Рассылаем полный результат от процесса 0 всем процессам
-  MPI_Bcast(output.pixels.data(), static_cast<int>(output.pixels.size()), MPI_UNSIGNED_CHAR, 0, MPI_COMM_WORLD);
+  // Полный результат нужен всем процессам
+  ppc::util::Allgather(stripes, local_output, output.pixels);
 
   return true;
 }
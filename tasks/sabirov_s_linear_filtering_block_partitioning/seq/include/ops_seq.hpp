@@ -10,7 +10,7 @@ class SabirovSLinearFilteringBlockPartitioningSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit SabirovSLinearFilteringBlockPartitioningSEQ(const InType &in);
+  explicit SabirovSLinearFilteringBlockPartitioningSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -3,14 +3,15 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #include "sabirov_s_linear_filtering_block_partitioning/common/include/common.hpp"
 
 namespace sabirov_s_linear_filtering_block_partitioning {
 
-SabirovSLinearFilteringBlockPartitioningSEQ::SabirovSLinearFilteringBlockPartitioningSEQ(const InType &in) {
+SabirovSLinearFilteringBlockPartitioningSEQ::SabirovSLinearFilteringBlockPartitioningSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool SabirovSLinearFilteringBlockPartitioningSEQ::ValidationImpl() {
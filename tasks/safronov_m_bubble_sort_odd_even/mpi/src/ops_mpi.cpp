@@ -3,15 +3,18 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "safronov_m_bubble_sort_odd_even/common/include/common.hpp"
+#include "util/include/distribution.hpp"
 
 namespace safronov_m_bubble_sort_odd_even {
 
-SafronovMBubbleSortOddEvenMPI::SafronovMBubbleSortOddEvenMPI(const InType &in) {
+SafronovMBubbleSortOddEvenMPI::SafronovMBubbleSortOddEvenMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool SafronovMBubbleSortOddEvenMPI::ValidationImpl() {
@@ -35,25 +38,6 @@ void SafronovMBubbleSortOddEvenMPI::SendingVector(int rank) {
   MPI_Bcast(GetInput().data(), size_vec, MPI_INT, 0, MPI_COMM_WORLD);
 }
 
-std::vector<int> SafronovMBubbleSortOddEvenMPI::CalculatingInterval(int size_prcs, int rank, int size_arr) {
-  std::vector<int> vec(2);
-  int whole_part = size_arr / size_prcs;
-  int real_part = size_arr % size_prcs;
-  int start = rank * whole_part;
-  if ((rank - 1 < real_part) && (rank - 1 != -1)) {
-    start += rank;
-  } else if (rank != 0) {
-    start += real_part;
-  }
-  int end = start + whole_part - 1;
-  if (rank < real_part) {
-    end += 1;
-  }
-  vec[0] = start;
-  vec[1] = end;
-  return vec;
-}
-
 void SafronovMBubbleSortOddEvenMPI::OddEvenBubble(std::vector<int> &own_data, int own_size, int begin, int phase) {
   if (own_size == 0) {
     return;
@@ -116,21 +100,6 @@ void SafronovMBubbleSortOddEvenMPI::BasisSortingLocalArrays(std::vector<int> &ow
   }
 }
 
-void SafronovMBubbleSortOddEvenMPI::SendingResult(int rank) {
-  int total_size = 0;
-  if (rank == 0) {
-    total_size = static_cast<int>(GetOutput().size());
-  }
-
-  MPI_Bcast(&total_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  if (rank != 0) {
-    GetOutput().resize(total_size);
-  }
-
-  MPI_Bcast(GetOutput().data(), total_size, MPI_INT, 0, MPI_COMM_WORLD);
-}
-
 bool SafronovMBubbleSortOddEvenMPI::RunImpl() {
   int size = 0;
   int rank = 0;
@@ -139,40 +108,17 @@ bool SafronovMBubbleSortOddEvenMPI::RunImpl() {
 
   SendingVector(rank);
 
-  if (rank == 0) {
-    int size_arr = static_cast<int>(GetInput().size());
-    std::vector<int> sizes_local_arrays(size);
-    for (int i = 1; i < size; i++) {
-      std::vector<int> interval = CalculatingInterval(size, i, size_arr);
-      sizes_local_arrays[i] = (interval[1] + 1) - interval[0];
-      MPI_Send(interval.data(), 2, MPI_INT, i, 0, MPI_COMM_WORLD);
-    }
-    std::vector<int> interval = CalculatingInterval(size, 0, size_arr);
-    std::vector<int> own_data = {};
-    if (interval[0] <= interval[1]) {
-      own_data = std::vector<int>(GetInput().begin() + interval[0], GetInput().begin() + interval[1] + 1);
-    }
-    BasisSortingLocalArrays(own_data, interval, size_arr, rank, size);
-    GetOutput().insert(GetOutput().end(), own_data.begin(), own_data.end());
-    MPI_Status status;
-    for (int i = 1; i < size; i++) {
-      std::vector<int> buf(sizes_local_arrays[i]);
-      MPI_Recv(buf.data(), sizes_local_arrays[i], MPI_INT, i, 2, MPI_COMM_WORLD, &status);
-      GetOutput().insert(GetOutput().end(), buf.begin(), buf.end());
-    }
-  } else {
-    MPI_Status status;
-    std::vector<int> buf(2);
-    MPI_Recv(buf.data(), 2, MPI_INT, 0, 0, MPI_COMM_WORLD, &status);
-    std::vector<int> own_data = {};
-    if (buf[0] <= buf[1]) {
-      own_data = std::vector<int>(GetInput().begin() + buf[0], GetInput().begin() + buf[1] + 1);
-    }
-    int size_arr = static_cast<int>(GetInput().size());
-    BasisSortingLocalArrays(own_data, buf, size_arr, rank, size);
-    MPI_Send(own_data.data(), static_cast<int>(own_data.size()), MPI_INT, 0, 2, MPI_COMM_WORLD);
-  }
-  SendingResult(rank);
+  // Every process holds the whole vector after the broadcast and takes its block from it
+  const int size_arr = static_cast<int>(GetInput().size());
+  const ppc::util::BlockDistribution blocks(GetInput().size(), size);
+  const auto range = blocks.Range(rank);
+  std::vector<int> interval = {static_cast<int>(range.begin), static_cast<int>(range.end) - 1};
+  std::vector<int> own_data(GetInput().begin() + static_cast<std::ptrdiff_t>(range.begin),
+                            GetInput().begin() + static_cast<std::ptrdiff_t>(range.end));
+  BasisSortingLocalArrays(own_data, interval, size_arr, rank, size);
+
+  GetOutput().resize(blocks.Total());
+  ppc::util::Allgather(blocks, own_data, GetOutput());
   return true;
 }
 
@@ -10,7 +10,7 @@ class SafronovMBubbleSortOddEvenSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit SafronovMBubbleSortOddEvenSEQ(const InType &in);
+  explicit SafronovMBubbleSortOddEvenSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
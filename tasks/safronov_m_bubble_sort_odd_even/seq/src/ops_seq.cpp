@@ -1,14 +1,15 @@
 #include "safronov_m_bubble_sort_odd_even/seq/include/ops_seq.hpp"
 
+#include <utility>
 #include <vector>
 
 #include "safronov_m_bubble_sort_odd_even/common/include/common.hpp"
 
 namespace safronov_m_bubble_sort_odd_even {
 
-SafronovMBubbleSortOddEvenSEQ::SafronovMBubbleSortOddEvenSEQ(const InType &in) {
+SafronovMBubbleSortOddEvenSEQ::SafronovMBubbleSortOddEvenSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool SafronovMBubbleSortOddEvenSEQ::ValidationImpl() {
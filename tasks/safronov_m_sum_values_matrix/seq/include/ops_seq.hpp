@@ -10,7 +10,7 @@ class SafronovMSumValuesMatrixSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit SafronovMSumValuesMatrixSEQ(const InType &in);
+  explicit SafronovMSumValuesMatrixSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
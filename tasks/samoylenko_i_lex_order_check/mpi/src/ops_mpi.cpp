@@ -61,9 +61,9 @@ unsigned int FindLocalDifference(const std::string &s1, const std::string &s2, s
 
 }  // namespace
 
-SamoylenkoILexOrderCheckMPI::SamoylenkoILexOrderCheckMPI(const InType &in) {
+SamoylenkoILexOrderCheckMPI::SamoylenkoILexOrderCheckMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = false;
 }
 
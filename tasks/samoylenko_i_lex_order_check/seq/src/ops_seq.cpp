@@ -26,9 +26,9 @@ bool SamoylenkoILexOrderCheckSEQ::SamoylenkoILexOrderCompare(const std::string &
   return ((first1 == last1) && (first2 == last2)) || ((first1 == last1) && (first2 != last2));
 }
 
-SamoylenkoILexOrderCheckSEQ::SamoylenkoILexOrderCheckSEQ(const InType &in) {
+SamoylenkoILexOrderCheckSEQ::SamoylenkoILexOrderCheckSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = false;
 }
 
@@ -1,15 +1,16 @@
 #include "shakirova_e_elem_matrix_sum/seq/include/ops_seq.hpp"
 
 #include <cstddef>
+#include <utility>
 
 #include "shakirova_e_elem_matrix_sum/common/include/common.hpp"
 #include "shakirova_e_elem_matrix_sum/common/include/matrix.hpp"
 
 namespace shakirova_e_elem_matrix_sum {
 
-ShakirovaEElemMatrixSumSEQ::ShakirovaEElemMatrixSumSEQ(const InType &in) {
+ShakirovaEElemMatrixSumSEQ::ShakirovaEElemMatrixSumSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
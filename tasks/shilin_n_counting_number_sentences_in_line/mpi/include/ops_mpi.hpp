@@ -12,7 +12,7 @@ class ShilinNCountingNumberSentencesInLineMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ShilinNCountingNumberSentencesInLineMPI(const InType &in);
+  explicit ShilinNCountingNumberSentencesInLineMPI(InType in);
 
  private:
   bool ValidationImpl() override;
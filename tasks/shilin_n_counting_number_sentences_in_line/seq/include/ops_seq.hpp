@@ -10,7 +10,7 @@ class ShilinNCountingNumberSentencesInLineSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ShilinNCountingNumberSentencesInLineSEQ(const InType &in);
+  explicit ShilinNCountingNumberSentencesInLineSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -2,14 +2,15 @@
 
 #include <cstddef>
 #include <string>
+#include <utility>
 
 #include "shilin_n_counting_number_sentences_in_line/common/include/common.hpp"
 
 namespace shilin_n_counting_number_sentences_in_line {
 
-ShilinNCountingNumberSentencesInLineSEQ::ShilinNCountingNumberSentencesInLineSEQ(const InType &in) {
+ShilinNCountingNumberSentencesInLineSEQ::ShilinNCountingNumberSentencesInLineSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -5,9 +5,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include "shkenev_i_diff_betw_neighb_elem_vec/common/include/common.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/halo.hpp"
 
 namespace shkenev_i_diff_betw_neighb_elem_vec {
 
@@ -22,42 +26,7 @@ int HandleSmallVector(const std::vector<int> &vec, int n) {
   return result;
 }
 
-void ComputeCountsAndDispls(int n, int world_size, std::vector<int> &cnt, std::vector<int> &disp) {
-  int base_size = n / world_size;
-  int rem = n % world_size;
-
-  int shift = 0;
-  for (int i = 0; i < world_size; ++i) {
-    cnt[i] = base_size + (i < rem ? 1 : 0);
-    disp[i] = shift;
-    shift += cnt[i];
-  }
-}
-
-void ScatterData(const std::vector<int> &vec, const std::vector<int> &cnt, const std::vector<int> &disp,
-                 std::vector<int> &l_vec, int world_rank) {
-  size_t l_n = cnt[world_rank];
-
-  if (world_rank == 0) {
-    if (l_n > 0) {
-      for (size_t i = 0; i < l_n; ++i) {
-        l_vec[i] = vec[i];
-      }
-    }
-
-    for (size_t proc = 1; proc < cnt.size(); ++proc) {
-      if (cnt[proc] > 0) {
-        MPI_Send(vec.data() + disp[proc], cnt[proc], MPI_INT, static_cast<int>(proc), 0, MPI_COMM_WORLD);
-      }
-    }
-  } else {
-    if (l_n > 0) {
-      MPI_Recv(l_vec.data(), static_cast<int>(l_n), MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    }
-  }
-}
-
-int LocalCompute(const std::vector<int> &l_vec) {
+int LocalCompute(std::span<const int> l_vec) {
   int l_max = 0;
   int l_n = static_cast<int>(l_vec.size());
 
@@ -69,28 +38,11 @@ int LocalCompute(const std::vector<int> &l_vec) {
   return l_max;
 }
 
-int BoundaryExchange(const std::vector<int> &l_vec, int world_rank, int world_size) {
-  int l_n = static_cast<int>(l_vec.size());
-  int boundary = 0;
-
-  if (world_rank > 0 && l_n > 0) {
-    int prev_last = 0;
-    MPI_Recv(&prev_last, 1, MPI_INT, world_rank - 1, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    boundary = std::abs(l_vec[0] - prev_last);
-  }
-
-  if (world_rank < world_size - 1 && l_n > 0) {
-    int my_last = l_vec[l_n - 1];
-    MPI_Send(&my_last, 1, MPI_INT, world_rank + 1, 1, MPI_COMM_WORLD);
-  }
-
-  return boundary;
-}
 }  // namespace
 
-ShkenevIDiffBetwNeighbElemVecMPI::ShkenevIDiffBetwNeighbElemVecMPI(const InType &in) {
+ShkenevIDiffBetwNeighbElemVecMPI::ShkenevIDiffBetwNeighbElemVecMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -124,16 +76,20 @@ bool ShkenevIDiffBetwNeighbElemVecMPI::RunImpl() {
     return true;
   }
 
-  std::vector<int> cnt(world_size);
-  std::vector<int> disp(world_size);
-  ComputeCountsAndDispls(n, world_size, cnt, disp);
+  const ppc::util::BlockDistribution dist(vec.size(), world_size);
+  const std::size_t l_n = dist.Count(world_rank);
 
-  std::vector<int> l_vec(cnt[world_rank]);
-  ScatterData(vec, cnt, disp, l_vec, world_rank);
+  // Own elements followed by one ghost, the first element of the next block
+  std::vector<int> l_vec(ppc::util::HaloExchange::PaddedSize(dist, world_rank, {.after = 1}));
+  ppc::util::Scatter(dist, vec, std::span(l_vec).first(l_n));
 
-  int local_max = LocalCompute(l_vec);
-  int boundary = BoundaryExchange(l_vec, world_rank, world_size);
-  local_max = std::max(local_max, boundary);
+  ppc::util::HaloExchange halo(dist, {.after = 1}, l_vec);
+  halo.Start();
+  int local_max = LocalCompute(std::span(l_vec).first(l_n));
+  halo.Finish();
+  if (halo.HasNeighbour(ppc::util::HaloSide::kAfter)) {
+    local_max = std::max(local_max, std::abs(l_vec[l_n] - l_vec[l_n - 1]));
+  }
 
   int global_max = 0;
   MPI_Reduce(&local_max, &global_max, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
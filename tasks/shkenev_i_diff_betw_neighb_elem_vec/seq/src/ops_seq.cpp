@@ -3,15 +3,16 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <utility>
 #include <vector>
 
 #include "shkenev_i_diff_betw_neighb_elem_vec/common/include/common.hpp"
 
 namespace shkenev_i_diff_betw_neighb_elem_vec {
 
-ShkenevIDiffBetwNeighbElemVecSEQ::ShkenevIDiffBetwNeighbElemVecSEQ(const InType &in) {
+ShkenevIDiffBetwNeighbElemVecSEQ::ShkenevIDiffBetwNeighbElemVecSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -4,15 +4,16 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "sinev_a_min_in_vector/common/include/common.hpp"
 
 namespace sinev_a_min_in_vector {
 
-SinevAMinInVectorMPI::SinevAMinInVectorMPI(const InType &in) {
+SinevAMinInVectorMPI::SinevAMinInVectorMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::numeric_limits<int>::max();
 }
 
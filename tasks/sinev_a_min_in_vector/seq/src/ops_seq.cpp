@@ -3,15 +3,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "sinev_a_min_in_vector/common/include/common.hpp"
 
 namespace sinev_a_min_in_vector {
 
-SinevAMinInVectorSEQ::SinevAMinInVectorSEQ(const InType &in) {
+SinevAMinInVectorSEQ::SinevAMinInVectorSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::numeric_limits<int>::max();
 }
 
@@ -13,7 +13,7 @@ class SosninaAMatrixMultHorizontalMPI : public BaseTask {
     return ppc::task::TypeOfTask::kMPI;
   }
 
-  explicit SosninaAMatrixMultHorizontalMPI(const InType &in);
+  explicit SosninaAMatrixMultHorizontalMPI(InType in);
 
  private:
   bool ValidationImpl() override;
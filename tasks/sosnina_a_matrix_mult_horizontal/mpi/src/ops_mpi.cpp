@@ -5,13 +5,15 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
+#include "util/include/util.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
-SosninaAMatrixMultHorizontalMPI::SosninaAMatrixMultHorizontalMPI(const InType &in) {
+SosninaAMatrixMultHorizontalMPI::SosninaAMatrixMultHorizontalMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetOutput() = std::vector<std::vector<double>>();
 
@@ -19,8 +21,8 @@ SosninaAMatrixMultHorizontalMPI::SosninaAMatrixMultHorizontalMPI(const InType &i
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   if (rank == 0) {
-    matrix_A_ = in.first;
-    matrix_B_ = in.second;
+    matrix_A_ = std::move(in.first);
+    matrix_B_ = std::move(in.second);
   }
 }
 
@@ -296,6 +298,8 @@ void SosninaAMatrixMultHorizontalMPI::ComputeLocalMultiplication(const std::vect
                                                                  const std::vector<double> &b_flat,
                                                                  std::vector<double> &local_result_flat, int local_rows,
                                                                  int cols_a, int cols_b) {
+#pragma omp parallel for default(none) shared(local_a_flat, b_flat, local_result_flat, local_rows, cols_a, cols_b) \
+    num_threads(ppc::util::GetNumThreads())
   for (int i = 0; i < local_rows; ++i) {
     const double *a_row = &local_a_flat[static_cast<size_t>(i) * static_cast<size_t>(cols_a)];
     double *result_row = &local_result_flat[static_cast<size_t>(i) * static_cast<size_t>(cols_b)];
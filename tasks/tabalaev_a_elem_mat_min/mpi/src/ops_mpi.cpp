@@ -12,9 +12,9 @@
 
 namespace tabalaev_a_elem_mat_min {
 
-TabalaevAElemMatMinMPI::TabalaevAElemMatMinMPI(const InType &in) {
+TabalaevAElemMatMinMPI::TabalaevAElemMatMinMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -10,7 +10,7 @@ class TabalaevAElemMatMinSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit TabalaevAElemMatMinSEQ(const InType &in);
+  explicit TabalaevAElemMatMinSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -10,7 +10,7 @@ class TimofeevNLexicographicOrderingMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit TimofeevNLexicographicOrderingMPI(const InType &in);
+  explicit TimofeevNLexicographicOrderingMPI(InType in);
 
  private:
   bool ValidationImpl() override;
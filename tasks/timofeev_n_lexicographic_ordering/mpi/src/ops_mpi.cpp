@@ -9,9 +9,9 @@
 
 namespace timofeev_n_lexicographic_ordering {
 
-TimofeevNLexicographicOrderingMPI::TimofeevNLexicographicOrderingMPI(const InType &in) {
+TimofeevNLexicographicOrderingMPI::TimofeevNLexicographicOrderingMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::pair<int, int>(1, 1);
 }
 
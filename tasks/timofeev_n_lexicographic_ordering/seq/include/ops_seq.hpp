@@ -10,7 +10,7 @@ class TimofeevNLexicographicOrderingSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit TimofeevNLexicographicOrderingSEQ(const InType &in);
+  explicit TimofeevNLexicographicOrderingSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -7,9 +7,9 @@
 
 namespace timofeev_n_lexicographic_ordering {
 
-TimofeevNLexicographicOrderingSEQ::TimofeevNLexicographicOrderingSEQ(const InType &in) {
+TimofeevNLexicographicOrderingSEQ::TimofeevNLexicographicOrderingSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::pair<int, int>(1, 1);
 }
 
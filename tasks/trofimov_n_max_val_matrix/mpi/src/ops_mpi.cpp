@@ -17,9 +17,9 @@ namespace {
 constexpr int kRootRank = 0;
 }  // namespace
 
-TrofimovNMaxValMatrixMPI::TrofimovNMaxValMatrixMPI(const InType &in) {
+TrofimovNMaxValMatrixMPI::TrofimovNMaxValMatrixMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in.begin(), in.end());
+  GetInput() = std::move(in);
   GetOutput() = OutType();
 }
 
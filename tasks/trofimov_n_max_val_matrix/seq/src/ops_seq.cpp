@@ -2,15 +2,16 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "trofimov_n_max_val_matrix/common/include/common.hpp"
 
 namespace trofimov_n_max_val_matrix {
 
-TrofimovNMaxValMatrixSEQ::TrofimovNMaxValMatrixSEQ(const InType &in) {
+TrofimovNMaxValMatrixSEQ::TrofimovNMaxValMatrixSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in.begin(), in.end());
+  GetInput() = std::move(in);
   GetOutput() = OutType();
 }
 
@@ -4,16 +4,20 @@
 
 #include <cstdlib>
 #include <limits>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "tsyplakov_k_vec_neighbours/common/include/common.hpp"
+#include "util/include/distribution.hpp"
+#include "util/include/halo.hpp"
 
 namespace tsyplakov_k_vec_neighbours {
 
-TsyplakovKVecNeighboursMPI::TsyplakovKVecNeighboursMPI(const InType &in) {
+TsyplakovKVecNeighboursMPI::TsyplakovKVecNeighboursMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(-1, -1);
 }
 
@@ -39,35 +43,21 @@ bool TsyplakovKVecNeighboursMPI::RunImpl() {
     return true;
   }
 
-  std::vector<int> sendcounts(size);
-  std::vector<int> displs(size);
+  const ppc::util::BlockDistribution dist(full_arr.size(), size);
+  const int local_count = static_cast<int>(dist.Count(rank));
+  const int global_offset = static_cast<int>(dist.Offset(rank));
 
-  int base = n / size;
-  int extra = n % size;
+  // Own elements followed by one ghost, the first element of the next block
+  std::vector<int> local_arr(ppc::util::HaloExchange::PaddedSize(dist, rank, {.after = 1}));
+  ppc::util::Scatter(dist, full_arr, std::span(local_arr).first(dist.Count(rank)));
 
-  int offset = 0;
-  for (int i = 0; i < size; i++) {
-    sendcounts[i] = base + (i < extra ? 1 : 0);
-    displs[i] = offset;
-    offset += sendcounts[i];
-  }
-
-  for (int i = 0; i < size - 1; i++) {
-    sendcounts[i]++;
-  }
-
-  int recv_count = sendcounts[rank];
-  std::vector<int> local_arr(recv_count);
-
-  MPI_Scatterv(full_arr.data(), sendcounts.data(), displs.data(), MPI_INT, local_arr.data(), recv_count, MPI_INT, 0,
-               MPI_COMM_WORLD);
+  ppc::util::HaloExchange halo(dist, {.after = 1}, local_arr);
+  halo.Start();
 
   int best_local_gap = std::numeric_limits<int>::max();
   int best_local_pos = -1;
 
-  int global_offset = displs[rank];
-
-  for (int i = 0; i < recv_count - 1; i++) {
+  for (int i = 0; i < local_count - 1; i++) {
     int diff = std::abs(local_arr[i] - local_arr[i + 1]);
     if (diff < best_local_gap) {
       best_local_gap = diff;
@@ -75,6 +65,15 @@ bool TsyplakovKVecNeighboursMPI::RunImpl() {
     }
   }
 
+  halo.Finish();
+  if (halo.HasNeighbour(ppc::util::HaloSide::kAfter)) {
+    int diff = std::abs(local_arr[local_count - 1] - local_arr[local_count]);
+    if (diff < best_local_gap) {
+      best_local_gap = diff;
+      best_local_pos = global_offset + local_count - 1;
+    }
+  }
+
   int best_global_gap = 0;
   MPI_Allreduce(&best_local_gap, &best_global_gap, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
 
@@ -12,7 +12,7 @@ class VasilievMVecSignsMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit VasilievMVecSignsMPI(const InType &in);
+  explicit VasilievMVecSignsMPI(InType in);
   static bool SignChangeCheck(int a, int b);
   static void CalcCountsAndDispls(int n, int size, std::vector<int> &counts, std::vector<int> &displs);
 
@@ -3,15 +3,16 @@
 #include <mpi.h>
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "vasiliev_m_vec_signs/common/include/common.hpp"
 
 namespace vasiliev_m_vec_signs {
 
-VasilievMVecSignsMPI::VasilievMVecSignsMPI(const InType &in) {
+VasilievMVecSignsMPI::VasilievMVecSignsMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = OutType{};
 }
 
@@ -10,7 +10,7 @@ class VasilievMVecSignsSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit VasilievMVecSignsSEQ(const InType &in);
+  explicit VasilievMVecSignsSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -1,15 +1,16 @@
 #include "vasiliev_m_vec_signs/seq/include/ops_seq.hpp"
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "vasiliev_m_vec_signs/common/include/common.hpp"
 
 namespace vasiliev_m_vec_signs {
 
-VasilievMVecSignsSEQ::VasilievMVecSignsSEQ(const InType &in) {
+VasilievMVecSignsSEQ::VasilievMVecSignsSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = OutType{};
 }
 
@@ -10,7 +10,7 @@ class VidermanAElemVecSumMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit VidermanAElemVecSumMPI(const InType &in);
+  explicit VidermanAElemVecSumMPI(InType in);
 
  private:
   bool ValidationImpl() override;
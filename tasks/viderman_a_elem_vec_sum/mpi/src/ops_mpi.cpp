@@ -3,15 +3,16 @@
 #include <mpi.h>
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "viderman_a_elem_vec_sum/common/include/common.hpp"
 
 namespace viderman_a_elem_vec_sum {
 
-VidermanAElemVecSumMPI::VidermanAElemVecSumMPI(const InType &in) {
+VidermanAElemVecSumMPI::VidermanAElemVecSumMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0.0;
 }
 
@@ -10,7 +10,7 @@ class VidermanAElemVecSumSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit VidermanAElemVecSumSEQ(const InType &in);
+  explicit VidermanAElemVecSumSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
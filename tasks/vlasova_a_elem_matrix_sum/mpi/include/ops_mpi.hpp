@@ -10,7 +10,7 @@ class VlasovaAElemMatrixSumMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit VlasovaAElemMatrixSumMPI(const InType &in);
+  explicit VlasovaAElemMatrixSumMPI(InType in);
 
  private:
   bool ValidationImpl() override;
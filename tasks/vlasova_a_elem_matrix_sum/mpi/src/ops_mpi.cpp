@@ -5,13 +5,14 @@
 #include <algorithm>
 #include <cstddef>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "vlasova_a_elem_matrix_sum/common/include/common.hpp"
 
 namespace vlasova_a_elem_matrix_sum {
 
-VlasovaAElemMatrixSumMPI::VlasovaAElemMatrixSumMPI(const InType &in) {
+VlasovaAElemMatrixSumMPI::VlasovaAElemMatrixSumMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetOutput() = {};
 
@@ -22,7 +23,7 @@ VlasovaAElemMatrixSumMPI::VlasovaAElemMatrixSumMPI(const InType &in) {
   InType processed_input = std::make_tuple(empty_data, std::get<1>(in), std::get<2>(in));
 
   if (rank == 0) {
-    GetInput() = in;
+    GetInput() = std::move(in);
   } else {
     GetInput() = processed_input;
   }
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <vector>
-
 #include "task/include/task.hpp"
 #include "zaharov_g_matrix_col_sum/common/include/common.hpp"
 
@@ -12,7 +10,7 @@ class ZaharovGMatrixColSumMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ZaharovGMatrixColSumMPI(const InType &in);
+  explicit ZaharovGMatrixColSumMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -20,7 +18,6 @@ class ZaharovGMatrixColSumMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
   OutType SumColValues(int start, int end);
-  static std::vector<int> CalcInterval(int thread_amount, int rank, int column_amount);
 };
 
 }  // namespace zaharov_g_matrix_col_sum
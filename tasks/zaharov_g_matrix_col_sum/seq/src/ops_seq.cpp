@@ -2,16 +2,16 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "zaharov_g_matrix_col_sum/common/include/common.hpp"
 
 namespace zaharov_g_matrix_col_sum {
 
-ZaharovGMatrixColSumSEQ::ZaharovGMatrixColSumSEQ(const InType &in) {
+ZaharovGMatrixColSumSEQ::ZaharovGMatrixColSumSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType tmp(in);
-  GetInput().swap(tmp);
+  GetInput() = std::move(in);
 }
 
 bool ZaharovGMatrixColSumSEQ::ValidationImpl() {
@@ -10,7 +10,7 @@ class ZhurinIMatrixSumsMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ZhurinIMatrixSumsMPI(const InType &in);
+  explicit ZhurinIMatrixSumsMPI(InType in);
 
  private:
   bool ValidationImpl() override;
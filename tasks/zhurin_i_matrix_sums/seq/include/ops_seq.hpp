@@ -10,7 +10,7 @@ class ZhurinIMatrixSumsSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ZhurinIMatrixSumsSEQ(const InType &in);
+  explicit ZhurinIMatrixSumsSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -10,7 +10,7 @@ class ZorinDAvgVecMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ZorinDAvgVecMPI(const InType &in);
+  explicit ZorinDAvgVecMPI(InType in);
 
  private:
   bool ValidationImpl() override;
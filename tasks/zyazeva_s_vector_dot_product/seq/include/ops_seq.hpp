@@ -13,7 +13,7 @@ class ZyazevaSVecDotProductSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ZyazevaSVecDotProductSEQ(const InType &in);
+  explicit ZyazevaSVecDotProductSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -29,10 +29,9 @@ bool CheckInputValid(const std::vector<std::vector<int32_t>> &input) {
 }
 }  // namespace
 
-ZyazevaSVecDotProductSEQ::ZyazevaSVecDotProductSEQ(const InType &in) {
+ZyazevaSVecDotProductSEQ::ZyazevaSVecDotProductSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType temp = in;
-  GetInput() = std::move(temp);
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 